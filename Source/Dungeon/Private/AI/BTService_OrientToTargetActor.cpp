@@ -4,7 +4,12 @@
 #include "AI/BTService_OrientToTargetActor.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "AIController.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorAISignificanceSubsystem.h"
+#include "Subsystems/WarriorFacingSubsystem.h"
+#include "Subsystems/WarriorBTProfilerSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("BT Orient To Target Actor"), STAT_WarriorBTOrientToTargetActor, STATGROUP_Warrior);
 
 UBTService_OrientToTargetActor::UBTService_OrientToTargetActor()
 {
@@ -38,18 +43,57 @@ FString UBTService_OrientToTargetActor::GetStaticDescription() const
 
 void UBTService_OrientToTargetActor::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTOrientToTargetActor);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Tick);
+
 	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
 
 	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetActorKey.SelectedKeyName);
 	AActor* TargetActor = Cast<AActor>(ActorObject);
 
 	APawn* OwningPawn = OwnerComp.GetAIOwner()->GetPawn();
+	UWarriorFacingSubsystem* FacingSubsystem = UWarriorFacingSubsystem::Get(&OwnerComp);
+
+	if (!OwningPawn || !FacingSubsystem)
+	{
+		return;
+	}
 
-	if (OwningPawn && TargetActor)
+	// The turn itself happens in the facing subsystem's batched pass, every frame, whatever this service's interval
+	if (TargetActor)
 	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(OwningPawn->GetActorLocation(), TargetActor->GetActorLocation());
-		const FRotator TargetRot = FMath::RInterpTo(OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationInterpSpeed);
+		FacingSubsystem->SetFacingTarget(OwningPawn, TargetActor, RotationInterpSpeed, 0.f, this);
+	}
+	else
+	{
+		FacingSubsystem->ClearFacingTarget(OwningPawn, this);
+	}
+}
+
+void UBTService_OrientToTargetActor::OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTOrientToTargetActor);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Other);
 
-		OwningPawn->SetActorRotation(TargetRot);
+	Super::OnCeaseRelevant(OwnerComp, NodeMemory);
+
+	APawn* OwningPawn = OwnerComp.GetAIOwner() ? OwnerComp.GetAIOwner()->GetPawn() : nullptr;
+
+	if (UWarriorFacingSubsystem* FacingSubsystem = OwningPawn ? UWarriorFacingSubsystem::Get(OwningPawn) : nullptr)
+	{
+		FacingSubsystem->ClearFacingTarget(OwningPawn, this);
+	}
+}
+
+void UBTService_OrientToTargetActor::ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	Super::ScheduleNextTick(OwnerComp, NodeMemory);
+
+	// Distant enemies refresh their facing target less often. The turn itself still runs every frame.
+	const float SignificanceInterval = UWarriorAISignificanceSubsystem::GetBTServiceIntervalForPawn(OwnerComp.GetAIOwner()->GetPawn());
+
+	if (SignificanceInterval > Interval)
+	{
+		SetNextTickTime(NodeMemory, SignificanceInterval);
 	}
 }
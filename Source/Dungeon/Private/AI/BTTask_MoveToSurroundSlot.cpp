@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/BTTask_MoveToSurroundSlot.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "Subsystems/WarriorBTProfilerSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("BT Move To Surround Slot"), STAT_WarriorBTMoveToSurroundSlot, STATGROUP_Warrior);
+
+UBTTask_MoveToSurroundSlot::UBTTask_MoveToSurroundSlot(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeName = TEXT("Native Move to Surround Slot");
+
+	BlackboardKey.SelectedKeyName = FName("SurroundSlotLocation");
+	BlackboardKey.AllowedTypes.Reset();
+	BlackboardKey.AddVectorFilter(this, GET_MEMBER_NAME_CHECKED(ThisClass, BlackboardKey));
+
+	// Slots are spaced around the target, a wide radius would let neighbours stop in each other's slot
+	AcceptableRadius = 30.f;
+
+	bObserveBlackboardValue = true;
+	ObservedBlackboardValueTolerance = 50.f;
+}
+
+FString UBTTask_MoveToSurroundSlot::GetStaticDescription() const
+{
+	return FString::Printf(TEXT("Moves to the surround slot in %s Key, fails without a slot"), *BlackboardKey.SelectedKeyName.ToString());
+}
+
+EBTNodeResult::Type UBTTask_MoveToSurroundSlot::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTMoveToSurroundSlot);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Activation);
+
+	const UBlackboardComponent* BlackboardComponent = OwnerComp.GetBlackboardComponent();
+
+	// AWarriorAIController clears the key when the enemy leaves the ring
+	if (!BlackboardComponent || !BlackboardComponent->IsVectorValueSet(BlackboardKey.GetSelectedKeyID()))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	return Super::ExecuteTask(OwnerComp, NodeMemory);
+}
@@ -4,7 +4,11 @@
 #include "AI/BTTask_RotateToFaceTarget.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "AIController.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Subsystems/WarriorFacingSubsystem.h"
+#include "Subsystems/WarriorBTProfilerSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("BT Rotate To Face Target"), STAT_WarriorBTRotateToFaceTarget, STATGROUP_Warrior);
 
 UBTTask_RotateToFaceTarget::UBTTask_RotateToFaceTarget()
 {
@@ -45,6 +49,9 @@ FString UBTTask_RotateToFaceTarget::GetStaticDescription() const
 
 EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTRotateToFaceTarget);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Activation);
+
 	UObject* ActorObject = OwnerComp.GetBlackboardComponent()->GetValueAsObject(InTargetToFaceKey.SelectedKeyName);
 	AActor* TargetActor = Cast<AActor>(ActorObject);
 
@@ -67,40 +74,71 @@ EBTNodeResult::Type UBTTask_RotateToFaceTarget::ExecuteTask(UBehaviorTreeCompone
 		return EBTNodeResult::Succeeded;
 	}
 
+	UWarriorFacingSubsystem* FacingSubsystem = UWarriorFacingSubsystem::Get(OwningPawn);
+	if (!FacingSubsystem)
+	{
+		Memory->Reset();
+		return EBTNodeResult::Failed;
+	}
+
+	// Takes precedence over orient services, which write the same slot with the default priority
+	FacingSubsystem->SetFacingTarget(OwningPawn, TargetActor, RotationiInterpSpeed, AnglePrecision, this, 1);
+
 	return EBTNodeResult::InProgress;
 }
 
 void UBTTask_RotateToFaceTarget::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTRotateToFaceTarget);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Tick);
+
 	FRotateToFaceTargetTaskMemory* Memory = CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory);
 
 	if (!Memory->IsValid())
 	{
 		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
 	}
 
+	// The facing subsystem turns the pawn after the AI has ticked, this only waits for it to get there
 	if (HasReachedAnglePercision(Memory->OwningPawn.Get(), Memory->TargetActor.Get()))
 	{
-		Memory->Reset();
 		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
 	}
-	else
-	{
-		const FRotator LookAtRot = UKismetMathLibrary::FindLookAtRotation(Memory->OwningPawn->GetActorLocation(), Memory->TargetActor->GetActorLocation());
-		const FRotator TargetRot = FMath::RInterpTo(Memory->OwningPawn->GetActorRotation(), LookAtRot, DeltaSeconds, RotationiInterpSpeed);
+}
+
+void UBTTask_RotateToFaceTarget::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBTRotateToFaceTarget);
+	const FWarriorBTProfileScope ProfileScope(this, OwnerComp, EWarriorBTProfileEvent::Other);
 
-		Memory->OwningPawn->SetActorRotation(TargetRot);
+	FRotateToFaceTargetTaskMemory* Memory = CastInstanceNodeMemory<FRotateToFaceTargetTaskMemory>(NodeMemory);
+
+	if (APawn* OwningPawn = Memory->OwningPawn.Get())
+	{
+		if (UWarriorFacingSubsystem* FacingSubsystem = UWarriorFacingSubsystem::Get(OwningPawn))
+		{
+			FacingSubsystem->ClearFacingTarget(OwningPawn, this);
+		}
 	}
+
+	Memory->Reset();
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
 }
 
 bool UBTTask_RotateToFaceTarget::HasReachedAnglePercision(APawn* QueryPawn, AActor* TargetActor) const
 {
-	const FVector OwnerForward = QueryPawn->GetActorForwardVector();
-	const FVector OwnerToTargetNormalized = (TargetActor->GetActorLocation() - QueryPawn->GetActorLocation()).GetSafeNormal();
-
-	const float DotResult = FVector::DotProduct(OwnerForward, OwnerToTargetNormalized);
-	const float AngleDiff = UKismetMathLibrary::DegAcos(DotResult);
+	// Reuse the result of the facing subsystem's last pass while this pawn has an intent there
+	if (const UWarriorFacingSubsystem* FacingSubsystem = UWarriorFacingSubsystem::Get(QueryPawn))
+	{
+		bool bHasReached = false;
 
-	return AngleDiff <= AnglePrecision;
+		if (FacingSubsystem->GetHasReachedAnglePrecision(QueryPawn, this, bHasReached))
+		{
+			return bHasReached;
+		}
+	}
 
+	return UWarriorFacingSubsystem::GetYawDeltaToTarget(QueryPawn, TargetActor) <= AnglePrecision;
 }
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/WarriorBehaviorTreeComponent.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BTNode.h"
+#include "Subsystems/WarriorBTProfilerSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Behavior Tree Tick"), STAT_WarriorBehaviorTreeTick, STATGROUP_Warrior);
+
+void UWarriorBehaviorTreeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorBehaviorTreeTick);
+
+	const UBTNode* ActiveNode = UWarriorBTProfilerSubsystem::IsEnabled() ? GetActiveNode() : nullptr;
+	UWarriorBTProfilerSubsystem* Profiler = ActiveNode ? GetWorld()->GetSubsystem<UWarriorBTProfilerSubsystem>() : nullptr;
+
+	if (!Profiler)
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		return;
+	}
+
+	const bool bActivated = LastProfiledNode.Get() != ActiveNode;
+
+	if (bActivated)
+	{
+		const UBehaviorTree* Tree = GetCurrentTree();
+
+		LastProfiledNode = ActiveNode;
+		LastProfiledBranchName = FName(FString::Printf(TEXT("%s / %s"), Tree ? *Tree->GetName() : TEXT("None"), *ActiveNode->GetNodeName()));
+	}
+
+	const FWarriorBTProfileKey Key = UWarriorBTProfilerSubsystem::MakeKey(*this, LastProfiledBranchName, EWarriorBTProfileEntryType::Branch);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	Profiler->Record(Key, bActivated ? EWarriorBTProfileEvent::Activation : EWarriorBTProfileEvent::Tick, FPlatformTime::Cycles64() - StartCycles);
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AI/WarriorCrowdManager.h"
+#include "Engine/World.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Simulation"), STAT_WarriorCrowdSimulation, STATGROUP_Warrior);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Crowd Simulation Avg Ms"), STAT_WarriorCrowdSimulationAvgMs, STATGROUP_Warrior);
+
+namespace WarriorCrowdManager
+{
+	// Weight of the newest sample in the moving average, roughly a one second window at 60 fps
+	static constexpr float AverageWeight = 1.f / 60.f;
+}
+
+void UWarriorCrowdManager::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorCrowdSimulation);
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Super::Tick(DeltaTime);
+
+	LastSimulationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	AverageSimulationMs = FMath::Lerp(AverageSimulationMs, LastSimulationMs, WarriorCrowdManager::AverageWeight);
+
+	SET_FLOAT_STAT(STAT_WarriorCrowdSimulationAvgMs, AverageSimulationMs);
+}
+
+float UWarriorCrowdManager::GetAverageSimulationMs(UWorld* InWorld)
+{
+	const UWarriorCrowdManager* CrowdManager = Cast<UWarriorCrowdManager>(UCrowdManager::GetCurrent(InWorld));
+
+	return CrowdManager ? CrowdManager->GetAverageSimulationMs() : 0.f;
+}
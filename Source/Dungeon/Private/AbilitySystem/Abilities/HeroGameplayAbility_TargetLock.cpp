@@ -2,14 +2,10 @@
 
 
 #include "AbilitySystem/Abilities/HeroGameplayAbility_TargetLock.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Characters/WarriorHeroCharacter.h"
-#include "Kismet/GameplayStatics.h"
 #include "Widgets/WarriorWidgetBase.h"
 #include "Controllers/WarriorHeroController.h"
-#include "Blueprint/WidgetLayoutLibrary.h"
-#include "Blueprint/WidgetTree.h"
-#include "Components/SizeBox.h"
+#include "Subsystems/WarriorWorldMarkerSubsystem.h"
 #include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -39,20 +35,16 @@ void UHeroGameplayAbility_TargetLock::EndAbility(const FGameplayAbilitySpecHandl
 void UHeroGameplayAbility_TargetLock::OnTargetLockTick(float DeltaTime)
 {
 	if (!CurrentLockedActor ||
-		UWarriorFunctionLibrary::NativeDoesActorHaveTag(CurrentLockedActor, WarriorGameplayTags::Shared_Status_Dead) ||
-		UWarriorFunctionLibrary::NativeDoesActorHaveTag(GetHeroCharacterFromActorInfo(), WarriorGameplayTags::Shared_Status_Dead)
+		UWarriorFunctionLibrary::NativeDoesActorHaveStatus(CurrentLockedActor, EWarriorStatusFlags::Dead) ||
+		UWarriorFunctionLibrary::NativeDoesActorHaveStatus(GetHeroCharacterFromActorInfo(), EWarriorStatusFlags::Dead)
 		)
 	{
 		CancelTargetLockAbility();
 		return;
 	}
 
-	SetTargetLockWidgetPosition();
-
 	const bool bShouldOverrideRotation =
-	!UWarriorFunctionLibrary::NativeDoesActorHaveTag(GetHeroCharacterFromActorInfo(), WarriorGameplayTags::Player_Status_Rolling)
-	&&
-	!UWarriorFunctionLibrary::NativeDoesActorHaveTag(GetHeroCharacterFromActorInfo(), WarriorGameplayTags::Player_Status_Blocking);
+	!UWarriorFunctionLibrary::NativeDoesActorHaveStatus(GetHeroCharacterFromActorInfo(), EWarriorStatusFlags::Rolling | EWarriorStatusFlags::Blocking);
 
 	if (bShouldOverrideRotation)
 	{
@@ -75,24 +67,19 @@ void UHeroGameplayAbility_TargetLock::SwitchTarget(const FGameplayTag& InSwitchD
 {
 	GetAvailableActorsToLock();
 
-	TArray<AActor*> ActorsOnLeft;
-	TArray<AActor*> ActorsOnRight;
-	AActor* NewTargetToLock = nullptr;
-
-	GetAvailableActorsAroundTarget(ActorsOnLeft, ActorsOnRight);
-
-	if (InSwitchDirectionTag == WarriorGameplayTags::Player_Event_SwitchTarget_Left)
-	{
-		NewTargetToLock = GetNearestTargetFromAvailableActors(ActorsOnLeft);
-	}
-	else
+	if (!CurrentLockedActor || AvailableActorsToLock.IsEmpty())
 	{
-		NewTargetToLock = GetNearestTargetFromAvailableActors(ActorsOnRight);
+		CancelTargetLockAbility();
+		return;
 	}
 
+	AActor* NewTargetToLock = GetNextTargetAroundCurrent(InSwitchDirectionTag == WarriorGameplayTags::Player_Event_SwitchTarget_Left);
+
 	if (NewTargetToLock)
 	{
 		CurrentLockedActor = NewTargetToLock;
+
+		SetTargetLockWidgetAnchor();
 	}
 }
 
@@ -106,13 +93,13 @@ void UHeroGameplayAbility_TargetLock::TryLockOnTarget()
 		return;
 	}
 
-	CurrentLockedActor = GetNearestTargetFromAvailableActors(AvailableActorsToLock);
+	CurrentLockedActor = GetBestTargetFromAvailableActors();
 
 	if (CurrentLockedActor)
 	{
 		DrawTargetLockWidget();
 
-		SetTargetLockWidgetPosition();
+		SetTargetLockWidgetAnchor();
 	}
 	else
 	{
@@ -122,70 +109,73 @@ void UHeroGameplayAbility_TargetLock::TryLockOnTarget()
 
 void UHeroGameplayAbility_TargetLock::GetAvailableActorsToLock()
 {
-	AvailableActorsToLock.Empty();
+	AvailableActorsToLock.Reset();
+
+	UWarriorTargetingSubsystem* TargetingSubsystem = UWarriorTargetingSubsystem::Get(GetHeroCharacterFromActorInfo());
 
-	TArray<FHitResult> BoxTraceHits;
+	if (!TargetingSubsystem)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	GetHeroControllerFromActorInfo()->GetPlayerViewPoint(ViewLocation, ViewRotation);
 
-	UKismetSystemLibrary::BoxTraceMultiForObjects(
+	TargetingSubsystem->FindTargetCandidates(
 		GetHeroCharacterFromActorInfo(),
-		GetHeroCharacterFromActorInfo()->GetActorLocation(),
-		GetHeroCharacterFromActorInfo()->GetActorLocation() + GetHeroCharacterFromActorInfo()->GetActorForwardVector() * BoxTraceDistance,
-		TraceBoxSize / 2.f,
-		GetHeroCharacterFromActorInfo()->GetActorForwardVector().ToOrientationRotator(),
-		BoxTraceChannel,
-		false,
-		TArray<AActor*>(),
-		bShowPersistanceDebugShape ? EDrawDebugTrace::Persistent : EDrawDebugTrace::None,
-		BoxTraceHits,
-		true
+		ViewLocation,
+		ViewRotation,
+		TargetLockDistance,
+		TargetLockMaxViewAngle,
+		AvailableActorsToLock
 	);
+}
+
+AActor* UHeroGameplayAbility_TargetLock::GetBestTargetFromAvailableActors() const
+{
+	const FWarriorTargetCandidate* BestCandidate = nullptr;
 
-	for (const FHitResult& TraceHit : BoxTraceHits)
+	for (const FWarriorTargetCandidate& Candidate : AvailableActorsToLock)
 	{
-		if (AActor* HitActor = TraceHit.GetActor())
+		if (!BestCandidate || Candidate.Score < BestCandidate->Score)
 		{
-			if (HitActor != GetHeroCharacterFromActorInfo())
-			{
-				AvailableActorsToLock.AddUnique(HitActor);
-			}
+			BestCandidate = &Candidate;
 		}
 	}
-}
 
-AActor* UHeroGameplayAbility_TargetLock::GetNearestTargetFromAvailableActors(const TArray<AActor*>& InAvailableActors)
-{
-	float ClosestDistance = 0.f;
-	return UGameplayStatics::FindNearestActor(GetHeroCharacterFromActorInfo()->GetActorLocation(), InAvailableActors, ClosestDistance);
+	return BestCandidate ? BestCandidate->Actor : nullptr;
 }
 
-void UHeroGameplayAbility_TargetLock::GetAvailableActorsAroundTarget(TArray<AActor*>& OutActorsOnLeft, TArray<AActor*>& OutActorsOnRight)
+AActor* UHeroGameplayAbility_TargetLock::GetNextTargetAroundCurrent(bool bSearchLeft) const
 {
-	if (!CurrentLockedActor || AvailableActorsToLock.IsEmpty())
-	{
-		CancelTargetLockAbility();
-		return;
-	}
-
-	const FVector PlayerLocation = GetHeroCharacterFromActorInfo()->GetActorLocation();
-	const FVector PlayerToCurrentNormalized = (CurrentLockedActor->GetActorLocation() - PlayerLocation).GetSafeNormal();
+	const int32 CurrentIndex = AvailableActorsToLock.IndexOfByPredicate([this](const FWarriorTargetCandidate& Candidate)
+		{
+			return Candidate.Actor == CurrentLockedActor;
+		});
 
-	for (AActor* AvailableActor : AvailableActorsToLock)
+	// The locked enemy drifted out of view, so switch relative to the screen centre instead
+	if (CurrentIndex == INDEX_NONE)
 	{
-		if (!AvailableActor || AvailableActor == CurrentLockedActor) continue;
-
-		const FVector PlayerToAvailableNormalized = (AvailableActor->GetActorLocation() - PlayerLocation).GetSafeNormal();
-
-		const FVector CrossResult = FVector::CrossProduct(PlayerToCurrentNormalized, PlayerToAvailableNormalized);
+		const FWarriorTargetCandidate* NearestOnSide = nullptr;
 
-		if (CrossResult.Z > 0.f)
+		for (const FWarriorTargetCandidate& Candidate : AvailableActorsToLock)
 		{
-			OutActorsOnRight.AddUnique(AvailableActor);
-		}
-		else
-		{
-			OutActorsOnLeft.AddUnique(AvailableActor);
+			const bool bIsOnSearchSide = bSearchLeft ? Candidate.ViewYaw < 0.f : Candidate.ViewYaw >= 0.f;
+
+			if (bIsOnSearchSide && (!NearestOnSide || FMath::Abs(Candidate.ViewYaw) < FMath::Abs(NearestOnSide->ViewYaw)))
+			{
+				NearestOnSide = &Candidate;
+			}
 		}
+
+		return NearestOnSide ? NearestOnSide->Actor : nullptr;
 	}
+
+	// Candidates are already sorted by screen angle, so the neighbours in the array are the next targets on screen
+	const int32 NextIndex = bSearchLeft ? CurrentIndex - 1 : CurrentIndex + 1;
+
+	return AvailableActorsToLock.IsValidIndex(NextIndex) ? AvailableActorsToLock[NextIndex].Actor : nullptr;
 }
 
 void UHeroGameplayAbility_TargetLock::DrawTargetLockWidget()
@@ -202,7 +192,7 @@ void UHeroGameplayAbility_TargetLock::DrawTargetLockWidget()
 	}
 }
 
-void UHeroGameplayAbility_TargetLock::SetTargetLockWidgetPosition()
+void UHeroGameplayAbility_TargetLock::SetTargetLockWidgetAnchor()
 {
 	if (!DrawnTargetLockWidget || !CurrentLockedActor)
 	{
@@ -210,31 +200,11 @@ void UHeroGameplayAbility_TargetLock::SetTargetLockWidgetPosition()
 		return;
 	}
 
-	FVector2D ScreenPosition;
-	UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(
-		GetHeroControllerFromActorInfo(),
-		CurrentLockedActor->GetActorLocation(),
-		ScreenPosition,
-		true
-	);
-
-	if (TargetLockWidgetSize == FVector2D::ZeroVector)
+	// The marker subsystem projects the reticle with every other marker, centred on the locked actor, once per frame
+	if (UWarriorWorldMarkerSubsystem* WorldMarkerSubsystem = UWarriorWorldMarkerSubsystem::Get(GetHeroCharacterFromActorInfo()))
 	{
-		DrawnTargetLockWidget->WidgetTree->ForEachWidget(
-			[this](UWidget* FoundWidget)
-			{
-				if (USizeBox* FoundSizeBox = Cast<USizeBox>(FoundWidget))
-				{
-					TargetLockWidgetSize.X = FoundSizeBox->GetWidthOverride();
-					TargetLockWidgetSize.Y = FoundSizeBox->GetHeightOverride();
-				}
-			}
-		);
+		WorldMarkerSubsystem->AddMarker(DrawnTargetLockWidget, CurrentLockedActor->GetRootComponent(), FVector::ZeroVector);
 	}
-
-	ScreenPosition -= (TargetLockWidgetSize / 2.f);
-
-	DrawnTargetLockWidget->SetPositionInViewport(ScreenPosition, false);
 }
 
 void UHeroGameplayAbility_TargetLock::InitTargetLockMovement()
@@ -268,13 +238,16 @@ void UHeroGameplayAbility_TargetLock::CleanUp()
 
 	if (DrawnTargetLockWidget)
 	{
+		if (UWarriorWorldMarkerSubsystem* WorldMarkerSubsystem = UWarriorWorldMarkerSubsystem::Get(DrawnTargetLockWidget))
+		{
+			WorldMarkerSubsystem->RemoveMarker(DrawnTargetLockWidget);
+		}
+
 		DrawnTargetLockWidget->RemoveFromParent();
 	}
 
 	DrawnTargetLockWidget = nullptr;
 
-	TargetLockWidgetSize = FVector2D::ZeroVector;
-
 	CachedDefaultMaxWalkSpeed = 0.f;
 }
 
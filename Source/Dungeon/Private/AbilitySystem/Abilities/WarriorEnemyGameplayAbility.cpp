@@ -5,6 +5,8 @@
 #include "Characters/WarriorEnemyCharacter.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "WarriorGameplayTags.h"
+#include "Controllers/WarriorAIController.h"
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
 
 AWarriorEnemyCharacter* UWarriorEnemyGameplayAbility::GetEnemyCharacterFromActorInfo()
 {
@@ -25,21 +27,128 @@ FGameplayEffectSpecHandle UWarriorEnemyGameplayAbility::MakeEnemyDamageEffectSpe
 {
     check(EffectClass);
 
-    FGameplayEffectContextHandle ContextHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeEffectContext();
-    ContextHandle.SetAbility(this);
-    ContextHandle.AddSourceObject(GetAvatarActorFromActorInfo());
-    ContextHandle.AddInstigator(GetAvatarActorFromActorInfo(), GetAvatarActorFromActorInfo());
+    const float BaseDamage = InDamageScalableFloat.GetValueAtLevel(GetAbilityLevel());
 
-    FGameplayEffectSpecHandle EffectSpecHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeOutgoingSpec(
-        EffectClass,
-        GetAbilityLevel(),
-        ContextHandle
-    );
+    // Reuse the spec for every victim of the same attack
+    const uint32 SpecKey = HashCombine(GetTypeHash(EffectClass.Get()), GetTypeHash(GetAbilityLevel()));
+
+    FGameplayEffectSpecHandle EffectSpecHandle = FindCachedDamageSpec(SpecKey);
+    if (!EffectSpecHandle.IsValid())
+    {
+        FGameplayEffectContextHandle ContextHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeEffectContext();
+        ContextHandle.SetAbility(this);
+        ContextHandle.AddSourceObject(GetAvatarActorFromActorInfo());
+        ContextHandle.AddInstigator(GetAvatarActorFromActorInfo(), GetAvatarActorFromActorInfo());
+
+        EffectSpecHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeOutgoingSpec(
+            EffectClass,
+            GetAbilityLevel(),
+            ContextHandle
+        );
 
+        CacheDamageSpec(SpecKey, EffectSpecHandle);
+    }
+
+    // Set on every call so a reused spec always carries this attack's damage
     EffectSpecHandle.Data->SetSetByCallerMagnitude(
         WarriorGameplayTags::Shared_SetByCaller_BaseDamage,
-        InDamageScalableFloat.GetValueAtLevel(GetAbilityLevel())
+        BaseDamage
     );
 
     return EffectSpecHandle;
 }
+
+bool UWarriorEnemyGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, OUT FGameplayTagContainer* OptionalRelevantTags) const
+{
+    if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+    {
+        return false;
+    }
+
+    if (!NeedsAttackToken() || !UWarriorAttackTokenSubsystem::IsEnabled())
+    {
+        return true;
+    }
+
+    APawn* EnemyPawn = nullptr;
+    AActor* TargetActor = nullptr;
+    const UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetAttackTokenContext(ActorInfo, EnemyPawn, TargetActor);
+
+    // Only asks, the token is taken in ActivateAbility. A denied enemy fails the activation, so the activate
+    // ability task fails and the tree moves on to strafing.
+    return !AttackTokenSubsystem || AttackTokenSubsystem->CanAcquireToken(EnemyPawn, TargetActor, AttackTokenPriority);
+}
+
+void UWarriorEnemyGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData)
+{
+    if (NeedsAttackToken() && UWarriorAttackTokenSubsystem::IsEnabled() && !TryAcquireAttackToken(ActorInfo))
+    {
+        // Only reached when the token went to someone else between the check and the activation
+        EndAbility(Handle, ActorInfo, ActivationInfo, true, true);
+        return;
+    }
+
+    Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+}
+
+void UWarriorEnemyGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled)
+{
+    // Only the instance that took the token gives it back, another ability of this enemy may be holding it
+    if (bHoldsAttackToken)
+    {
+        bHoldsAttackToken = false;
+
+        if (ActorInfo && ActorInfo->AvatarActor.IsValid())
+        {
+            if (UWarriorAttackTokenSubsystem* AttackTokenSubsystem = ActorInfo->AvatarActor->GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>())
+            {
+                AttackTokenSubsystem->ReleaseToken(ActorInfo->AvatarActor.Get());
+            }
+        }
+    }
+
+    Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+bool UWarriorEnemyGameplayAbility::NeedsAttackToken() const
+{
+    return bRequiresAttackToken && GetAssetTags().HasTag(WarriorGameplayTags::Enemy_Ability_Melee);
+}
+
+UWarriorAttackTokenSubsystem* UWarriorEnemyGameplayAbility::GetAttackTokenContext(const FGameplayAbilityActorInfo* ActorInfo, APawn*& OutEnemyPawn, AActor*& OutTargetActor)
+{
+    OutEnemyPawn = ActorInfo ? Cast<APawn>(ActorInfo->AvatarActor.Get()) : nullptr;
+
+    const AWarriorAIController* EnemyController = OutEnemyPawn ? OutEnemyPawn->GetController<AWarriorAIController>() : nullptr;
+    OutTargetActor = EnemyController ? EnemyController->GetTargetActor() : nullptr;
+
+    // Nothing to contend for without a target
+    if (!OutTargetActor)
+    {
+        return nullptr;
+    }
+
+    return OutEnemyPawn->GetWorld()->GetSubsystem<UWarriorAttackTokenSubsystem>();
+}
+
+bool UWarriorEnemyGameplayAbility::TryAcquireAttackToken(const FGameplayAbilityActorInfo* ActorInfo)
+{
+    APawn* EnemyPawn = nullptr;
+    AActor* TargetActor = nullptr;
+    UWarriorAttackTokenSubsystem* AttackTokenSubsystem = GetAttackTokenContext(ActorInfo, EnemyPawn, TargetActor);
+
+    if (!AttackTokenSubsystem)
+    {
+        return true;
+    }
+
+    // Another ability of this enemy already holds the token for this target and gives it back when it ends
+    if (AttackTokenSubsystem->HasTokenOn(EnemyPawn, TargetActor))
+    {
+        return true;
+    }
+
+    bHoldsAttackToken = AttackTokenSubsystem->TryAcquireToken(EnemyPawn, TargetActor, AttackTokenPriority);
+
+    return bHoldsAttackToken;
+}
@@ -7,6 +7,10 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
+#include "Subsystems/WarriorHitReactSubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Specs Reused"), STAT_WarriorDamageSpecsReused, STATGROUP_Warrior);
 
 void UWarriorGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
 {
@@ -25,6 +29,9 @@ void UWarriorGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle
 {
 	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 
+	CachedDamageSpecHandle.Clear();
+	CachedDamageSpecKey = 0;
+
 	if (AbilityActivationPolicy == EWarriorAbilityActivationPolicy::OnGiven)
 	{
 		if (ActorInfo)
@@ -65,6 +72,21 @@ FActiveGameplayEffectHandle UWarriorGameplayAbility::BP_ApplyEffectSpecHandleToT
 	return ActiveGameplayEffectHandle;
 }
 
+int32 UWarriorGameplayAbility::NativeApplyEffectSpecHandleToTargets(const TArray<AActor*>& TargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors)
+{
+	check(InSpecHandle.IsValid());
+
+	UWarriorAbilitySystemComponent* SourceASC = GetWarriorAbilitySystemComponentFromActorInfo();
+	check(SourceASC);
+
+	return UWarriorFunctionLibrary::NativeApplyGameplayEffectSpecHandleToTargetActors(SourceASC, TargetActors, InSpecHandle, OutAffectedActors);
+}
+
+int32 UWarriorGameplayAbility::BP_ApplyEffectSpecHandleToTargets(const TArray<AActor*>& TargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors)
+{
+	return NativeApplyEffectSpecHandleToTargets(TargetActors, InSpecHandle, OutAffectedActors);
+}
+
 void UWarriorGameplayAbility::ApplyGameplayEffectSpecHandleToHitResults(const FGameplayEffectSpecHandle& InSpecHandle, const TArray<FHitResult>& InHitResults)
 {
 	if (InHitResults.IsEmpty())
@@ -74,27 +96,47 @@ void UWarriorGameplayAbility::ApplyGameplayEffectSpecHandleToHitResults(const FG
 
 	APawn* OwningPawn = CastChecked<APawn>(GetAvatarActorFromActorInfo());
 
+	// Gather the hostile pawns first. A multi-hit trace can report the same pawn more than once.
+	TArray<AActor*> HostileTargets;
+	HostileTargets.Reserve(InHitResults.Num());
+
 	for (const FHitResult& Hit : InHitResults)
 	{
 		if (APawn* HitPawn = Cast<APawn>(Hit.GetActor()))
 		{
 			if (UWarriorFunctionLibrary::IsTargetPawnHostile(OwningPawn, HitPawn))
 			{
-				FActiveGameplayEffectHandle ActiveGameplayEffectHandle = NativeApplyEffectSpecHandleToTarget(HitPawn, InSpecHandle);
-			
-				if (ActiveGameplayEffectHandle.WasSuccessfullyApplied())
-				{
-					FGameplayEventData Data;
-					Data.Instigator = OwningPawn;
-					Data.Target = HitPawn;
-
-					UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-						HitPawn,
-						WarriorGameplayTags::Shared_Event_HitReact,
-						Data
-					);
-				}
+				HostileTargets.AddUnique(HitPawn);
 			}
 		}
 	}
+
+	TArray<AActor*> AffectedActors;
+	NativeApplyEffectSpecHandleToTargets(HostileTargets, InSpecHandle, AffectedActors);
+
+	for (AActor* AffectedActor : AffectedActors)
+	{
+		FGameplayEventData Data;
+		Data.Instigator = OwningPawn;
+		Data.Target = AffectedActor;
+
+		UWarriorHitReactSubsystem::QueueOrSendHitReact(AffectedActor, Data);
+	}
+}
+
+FGameplayEffectSpecHandle UWarriorGameplayAbility::FindCachedDamageSpec(uint32 InSpecKey) const
+{
+	if (CachedDamageSpecHandle.IsValid() && CachedDamageSpecKey == InSpecKey)
+	{
+		INC_DWORD_STAT(STAT_WarriorDamageSpecsReused);
+		return CachedDamageSpecHandle;
+	}
+
+	return FGameplayEffectSpecHandle();
+}
+
+void UWarriorGameplayAbility::CacheDamageSpec(uint32 InSpecKey, const FGameplayEffectSpecHandle& InSpecHandle)
+{
+	CachedDamageSpecHandle = InSpecHandle;
+	CachedDamageSpecKey = InSpecKey;
 }
@@ -36,17 +36,28 @@ FGameplayEffectSpecHandle UWarriorHeroGameplayAbility::MakeHeroDamageEffectSpecH
 {
     check(EffectClass);
 
-    FGameplayEffectContextHandle ContextHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeEffectContext();
-    ContextHandle.SetAbility(this);
-    ContextHandle.AddSourceObject(GetAvatarActorFromActorInfo());
-    ContextHandle.AddInstigator(GetAvatarActorFromActorInfo(), GetAvatarActorFromActorInfo());
-
-    FGameplayEffectSpecHandle EffectSpecHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeOutgoingSpec(
-        EffectClass,
-        GetAbilityLevel(),
-        ContextHandle
-    );
+    // Every victim of one swing gets the same spec, so build it once and hand the same handle back for later hits
+    uint32 SpecKey = HashCombine(GetTypeHash(EffectClass.Get()), GetTypeHash(GetAbilityLevel()));
+    SpecKey = HashCombine(SpecKey, GetTypeHash(InCurrentAttackTypeTag));
+
+    FGameplayEffectSpecHandle EffectSpecHandle = FindCachedDamageSpec(SpecKey);
+    if (!EffectSpecHandle.IsValid())
+    {
+        FGameplayEffectContextHandle ContextHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeEffectContext();
+        ContextHandle.SetAbility(this);
+        ContextHandle.AddSourceObject(GetAvatarActorFromActorInfo());
+        ContextHandle.AddInstigator(GetAvatarActorFromActorInfo(), GetAvatarActorFromActorInfo());
+
+        EffectSpecHandle = GetWarriorAbilitySystemComponentFromActorInfo()->MakeOutgoingSpec(
+            EffectClass,
+            GetAbilityLevel(),
+            ContextHandle
+        );
+
+        CacheDamageSpec(SpecKey, EffectSpecHandle);
+    }
 
+    // Set on every call, a reused spec must never carry the damage or combo count of an earlier hit
     EffectSpecHandle.Data->SetSetByCallerMagnitude(
         WarriorGameplayTags::Shared_SetByCaller_BaseDamage,
         InWeaponBaseDamage
@@ -4,12 +4,14 @@
 #include "AbilitySystem/AbilityTasks/AbilityTask_WaitSpawnEnemies.h"
 #include "AbilitySystemComponent.h"
 #include "Engine/AssetManager.h"
-#include "NavigationSystem.h"
 #include "Characters/WarriorEnemyCharacter.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Subsystems/WarriorDeferredActionSubsystem.h"
+#include "GameFramework/PlayerController.h"
 
 #include "WarriorDebugHelper.h"
 
-UAbilityTask_WaitSpawnEnemies* UAbilityTask_WaitSpawnEnemies::WaitSpawnEnemies(UGameplayAbility* OwningAbility, FGameplayTag EventTag, TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClassToSpawn, int32 NumToSpawn, const FVector& SpawnOrigin, float RandomSpawnRadius)
+UAbilityTask_WaitSpawnEnemies* UAbilityTask_WaitSpawnEnemies::WaitSpawnEnemies(UGameplayAbility* OwningAbility, FGameplayTag EventTag, TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClassToSpawn, int32 NumToSpawn, const FVector& SpawnOrigin, float RandomSpawnRadius, int32 MaxSpawnsPerFrame, float SpawnBudgetMs, bool bPrioritizeNearView)
 {
     UAbilityTask_WaitSpawnEnemies* Node = NewAbilityTask<UAbilityTask_WaitSpawnEnemies>(OwningAbility);
     Node->CachedEventTag = EventTag;
@@ -17,6 +19,9 @@ UAbilityTask_WaitSpawnEnemies* UAbilityTask_WaitSpawnEnemies::WaitSpawnEnemies(U
     Node->CachedNumToSpawn = NumToSpawn;
     Node->CachedSpawnOrigin = SpawnOrigin;
     Node->CachedRandomSpawnRadius = RandomSpawnRadius;
+    Node->CachedMaxSpawnsPerFrame = MaxSpawnsPerFrame;
+    Node->CachedSpawnBudgetMs = SpawnBudgetMs;
+    Node->bCachedPrioritizeNearView = bPrioritizeNearView;
 
     return Node;
 }
@@ -40,6 +45,14 @@ void UAbilityTask_WaitSpawnEnemies::OnDestroy(bool bInOwnerFinished)
 
 void UAbilityTask_WaitSpawnEnemies::OnGameplayEventReceived(const FGameplayEventData* InPayLoad)
 {
+    // The task ends once its wave is out, events sent while the class loads or the wave is spread over frames are dropped
+    if (bIsSpawningWave)
+    {
+        return;
+    }
+
+    bIsSpawningWave = true;
+
     if (ensure(!CachedSoftEnemyClassToSpawn.IsNull()))
     {
         UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
@@ -76,28 +89,132 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
         return;
     }
 
-    TArray<AWarriorEnemyCharacter*> SpawnedEnemies;
+    // One batched navmesh query for every spawn point instead of a reachability query per enemy
+    TArray<FVector> SpawnLocations;
+    UWarriorEnemyPoolSubsystem::QueryNavigableSpawnLocations(this, CachedSpawnOrigin, CachedRandomSpawnRadius, CachedNumToSpawn, SpawnLocations);
+
+    const FRotator SpawnFacingRotation = AbilitySystemComponent->GetAvatarActor()->GetActorForwardVector().ToOrientationRotator();
+
+    PendingSpawnTransforms.Reset(SpawnLocations.Num());
+    NextPendingSpawnIndex = 0;
+
+    for (const FVector& SpawnLocation : SpawnLocations)
+    {
+        PendingSpawnTransforms.Emplace(SpawnFacingRotation, SpawnLocation + FVector(0.f, 0.f, 150.f));
+    }
+
+    if (bCachedPrioritizeNearView)
+    {
+        SortPendingSpawnsByViewDistance();
+    }
+
+    SpawnedEnemies.Reset();
+    SpawnedEnemies.Reserve(PendingSpawnTransforms.Num());
+
+    SpawnNextBatch();
+}
+
+void UAbilityTask_WaitSpawnEnemies::SortPendingSpawnsByViewDistance()
+{
+    APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+    if (!PlayerController)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+    const FVector ViewDirection = ViewRotation.Vector();
+
+    // Points behind the camera count as twice as far, so the enemies the player will see first are live first
+    auto GetViewScore = [&ViewLocation, &ViewDirection](const FTransform& InTransform)
+    {
+        const FVector ToPoint = InTransform.GetLocation() - ViewLocation;
+        const float DistanceSquared = ToPoint.SizeSquared();
+
+        return (FVector::DotProduct(ToPoint, ViewDirection) < 0.f) ? DistanceSquared * 4.f : DistanceSquared;
+    };
+
+    PendingSpawnTransforms.Sort([&GetViewScore](const FTransform& A, const FTransform& B)
+    {
+        return GetViewScore(A) < GetViewScore(B);
+    });
+}
+
+void UAbilityTask_WaitSpawnEnemies::SpawnNextBatch()
+{
+    // The owning ability can end the task while a wave is still being spread over frames
+    if (IsFinished())
+    {
+        return;
+    }
+
+    UClass* LoadedClass = CachedSoftEnemyClassToSpawn.Get();
+    UWorld* World = GetWorld();
+
+    if (!LoadedClass || !World)
+    {
+        FinishSpawning();
+        return;
+    }
+
+    // Pooling is opt in per class, since only those classes reset what their death flow changed
+    UWarriorEnemyPoolSubsystem* EnemyPool = LoadedClass->GetDefaultObject<AWarriorEnemyCharacter>()->UsesEnemyPool() ?
+        UWarriorEnemyPoolSubsystem::Get(World) : nullptr;
 
     FActorSpawnParameters SpawnParam;
     SpawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-    for (int32 i = 0; i < CachedNumToSpawn; i++)
-    {
-        FVector RandomLocation;
-        UNavigationSystemV1::K2_GetRandomReachablePointInRadius(this, CachedSpawnOrigin, RandomLocation, CachedRandomSpawnRadius);
+    const double BatchStartTime = FPlatformTime::Seconds();
+    int32 NumSpawnedThisFrame = 0;
 
-        RandomLocation += FVector(0.f, 0.f, 150.f);
+    while (NextPendingSpawnIndex < PendingSpawnTransforms.Num())
+    {
+        const FTransform& SpawnTransform = PendingSpawnTransforms[NextPendingSpawnIndex++];
 
-        const FRotator SpawnFacingRotation = AbilitySystemComponent->GetAvatarActor()->GetActorForwardVector().ToOrientationRotator();
+        AWarriorEnemyCharacter* SpawnedEnemy = EnemyPool ?
+            EnemyPool->AcquireEnemy(LoadedClass, SpawnTransform) :
+            World->SpawnActor<AWarriorEnemyCharacter>(LoadedClass, SpawnTransform, SpawnParam);
 
-        AWarriorEnemyCharacter* SpawnedEnemy = World->SpawnActor<AWarriorEnemyCharacter>(LoadedClass, RandomLocation, SpawnFacingRotation, SpawnParam);
-    
         if (SpawnedEnemy)
         {
             SpawnedEnemies.Add(SpawnedEnemy);
         }
+
+        ++NumSpawnedThisFrame;
+
+        const bool bCountBudgetUsed = CachedMaxSpawnsPerFrame > 0 && NumSpawnedThisFrame >= CachedMaxSpawnsPerFrame;
+        const bool bTimeBudgetUsed = CachedSpawnBudgetMs > 0.f && (FPlatformTime::Seconds() - BatchStartTime) * 1000.0 >= CachedSpawnBudgetMs;
+
+        if (bCountBudgetUsed || bTimeBudgetUsed)
+        {
+            break;
+        }
     }
 
+    if (NextPendingSpawnIndex < PendingSpawnTransforms.Num())
+    {
+        if (UWarriorDeferredActionSubsystem* DeferredActions = UWarriorDeferredActionSubsystem::Get(World))
+        {
+            DeferredActions->EnqueueAction(this, EWarriorDeferredActionPhase::NextFrame, [this]() { SpawnNextBatch(); });
+            return;
+        }
+
+        // Nothing to defer to, so finish the wave this frame
+        SpawnNextBatch();
+        return;
+    }
+
+    FinishSpawning();
+}
+
+void UAbilityTask_WaitSpawnEnemies::FinishSpawning()
+{
+    PendingSpawnTransforms.Reset();
+    NextPendingSpawnIndex = 0;
+
     if (ShouldBroadcastAbilityTaskDelegates())
     {
         if (!SpawnedEnemies.IsEmpty())
@@ -110,5 +227,7 @@ void UAbilityTask_WaitSpawnEnemies::OnEnemyClassLoaded()
         }
     }
 
+    SpawnedEnemies.Reset();
+
     EndTask();
 }
@@ -4,6 +4,8 @@
 #include "AbilitySystem/GEExecCalc/GEExecCalc_DamageTaken.h"
 #include "AbilitySystem/WarriorAttributeSet.h"
 #include "WarriorGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "Subsystems/WarriorCombatTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -65,30 +67,10 @@ void UGEExecCalc_DamageTaken::Execute_Implementation(const FGameplayEffectCustom
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(GetWarriorDamageCapture().AttackPowerDef, EvaluateParameters, SourceAttackPower);
 	//Debug::Print(TEXT("SourceAttackPower"), SourceAttackPower);
 
-	float BaseDamage = 0.f;
-	int32 UsedLightAttackComboCount = 0;
-	int32 UsedHeavyAttackComboCount = 0;
-
-	for (const TPair<FGameplayTag, float>& TagMagnitude : EffectSpec.SetByCallerTagMagnitudes)
-	{
-		if (TagMagnitude.Key.MatchesTagExact(WarriorGameplayTags::Shared_SetByCaller_BaseDamage))
-		{
-			BaseDamage = TagMagnitude.Value;
-			//Debug::Print(TEXT("BaseDamage"), BaseDamage);
-		}
-
-		if (TagMagnitude.Key.MatchesTagExact(WarriorGameplayTags::Player_SetByCaller_AttackType_Light))
-		{
-			UsedLightAttackComboCount = TagMagnitude.Value;
-			//Debug::Print(TEXT("UsedLightAttackComboCount"), UsedLightAttackComboCount);
-		}
-
-		if (TagMagnitude.Key.MatchesTagExact(WarriorGameplayTags::Player_SetByCaller_AttackType_Heavy))
-		{
-			UsedHeavyAttackComboCount = TagMagnitude.Value;
-			//Debug::Print(TEXT("UsedHeavyAttackComboCount"), UsedHeavyAttackComboCount);
-		}
-	}
+	// Direct lookups into the set by caller map instead of walking every entry
+	float BaseDamage = EffectSpec.GetSetByCallerMagnitude(WarriorGameplayTags::Shared_SetByCaller_BaseDamage, false, 0.f);
+	const int32 UsedLightAttackComboCount = EffectSpec.GetSetByCallerMagnitude(WarriorGameplayTags::Player_SetByCaller_AttackType_Light, false, 0.f);
+	const int32 UsedHeavyAttackComboCount = EffectSpec.GetSetByCallerMagnitude(WarriorGameplayTags::Player_SetByCaller_AttackType_Heavy, false, 0.f);
 
 	float TargetDefensePower = 0.f;
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(GetWarriorDamageCapture().DefensePowerDef, EvaluateParameters, TargetDefensePower);
@@ -113,6 +95,20 @@ void UGEExecCalc_DamageTaken::Execute_Implementation(const FGameplayEffectCustom
 	const float FinalDamageDone = BaseDamage * SourceAttackPower / TargetDefensePower;
 	//Debug::Print(TEXT("FinalDamageDone"), FinalDamageDone);
 
+	if (UWarriorCombatTelemetrySubsystem::IsEnabled())
+	{
+		UAbilitySystemComponent* SourceASC = ExecutionParams.GetSourceAbilitySystemComponent();
+		UAbilitySystemComponent* TargetASC = ExecutionParams.GetTargetAbilitySystemComponent();
+
+		UWarriorCombatTelemetrySubsystem::RecordDamageHit(
+			SourceASC ? SourceASC->GetAvatarActor() : nullptr,
+			TargetASC ? TargetASC->GetAvatarActor() : nullptr,
+			FinalDamageDone,
+			UsedLightAttackComboCount,
+			UsedHeavyAttackComboCount
+		);
+	}
+
 	if (FinalDamageDone > 0.f)
 	{
 		OutExecutionOutput.AddOutputModifier(
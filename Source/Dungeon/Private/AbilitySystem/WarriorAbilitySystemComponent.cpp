@@ -116,3 +116,62 @@ bool UWarriorAbilitySystemComponent::TryActivateAbilityByTag(FGameplayTag Abilit
 
 	return false;
 }
+
+EWarriorStatusFlags UWarriorAbilitySystemComponent::GetStatusFlagForTag(const FGameplayTag& InTag)
+{
+	struct FStatusTagFlag
+	{
+		FGameplayTag Tag;
+		EWarriorStatusFlags Flag;
+	};
+
+	static const FStatusTagFlag StatusTagFlags[] =
+	{
+		{ WarriorGameplayTags::Shared_Status_Dead,			EWarriorStatusFlags::Dead },
+		{ WarriorGameplayTags::Player_Status_Blocking,		EWarriorStatusFlags::Blocking },
+		{ WarriorGameplayTags::Player_Status_Rolling,		EWarriorStatusFlags::Rolling },
+		{ WarriorGameplayTags::Enemy_Status_UnBlockable,	EWarriorStatusFlags::Unblockable },
+		{ WarriorGameplayTags::Player_Status_Rage_Full,		EWarriorStatusFlags::RageFull },
+		{ WarriorGameplayTags::Player_Status_Rage_None,		EWarriorStatusFlags::RageNone },
+		{ WarriorGameplayTags::Player_Status_Rage_Active,	EWarriorStatusFlags::RageActive },
+		{ WarriorGameplayTags::Shared_Status_Invincible,	EWarriorStatusFlags::Invincible },
+		{ WarriorGameplayTags::Player_Status_TargetLock,	EWarriorStatusFlags::TargetLock },
+		{ WarriorGameplayTags::Enemy_Status_UnderAttack,	EWarriorStatusFlags::UnderAttack },
+		{ WarriorGameplayTags::Enemy_Status_Strafing,		EWarriorStatusFlags::Strafing }
+	};
+
+	for (const FStatusTagFlag& StatusTagFlag : StatusTagFlags)
+	{
+		if (StatusTagFlag.Tag == InTag)
+		{
+			return StatusTagFlag.Flag;
+		}
+	}
+
+	return EWarriorStatusFlags::None;
+}
+
+void UWarriorAbilitySystemComponent::OnTagUpdated(const FGameplayTag& Tag, bool TagExists)
+{
+	Super::OnTagUpdated(Tag, TagExists);
+
+	// Only explicit tags are reported here, so walk up to the tracked parent and recount it from the container.
+	// A child like Player.Status.Blocking.Perfect keeps the Blocking bit set just as HasMatchingGameplayTag would.
+	for (FGameplayTag CurrentTag = Tag; CurrentTag.IsValid(); CurrentTag = CurrentTag.RequestDirectParent())
+	{
+		const EWarriorStatusFlags StatusFlag = GetStatusFlagForTag(CurrentTag);
+		if (StatusFlag == EWarriorStatusFlags::None)
+		{
+			continue;
+		}
+
+		if (HasMatchingGameplayTag(CurrentTag))
+		{
+			EnumAddFlags(StatusFlags, StatusFlag);
+		}
+		else
+		{
+			EnumRemoveFlags(StatusFlags, StatusFlag);
+		}
+	}
+}
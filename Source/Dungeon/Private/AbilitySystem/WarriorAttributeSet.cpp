@@ -23,50 +23,16 @@ UWarriorAttributeSet::UWarriorAttributeSet()
 
 void UWarriorAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
-	if (!CachedPawnUIInterface.IsValid())
-	{
-		CachedPawnUIInterface = TWeakInterfacePtr<IPawnUIInterface>(Data.Target.GetAvatarActor());
-	}
-
-	checkf(CachedPawnUIInterface.IsValid(), TEXT("%s didn't implement IPawnUIInterface"), *Data.Target.GetAvatarActor()->GetActorNameOrLabel());
-
-	UPawnUIComponent* PawnUIComponent = CachedPawnUIInterface->GetPawnUIComponent();
-
-	checkf(PawnUIComponent, TEXT("Couldn't extrac a PawnUIComponent from %s"), *Data.Target.GetAvatarActor()->GetActorNameOrLabel());
+	UPawnUIComponent* PawnUIComponent = GetPawnUIComponentFromAvatar(Data.Target.GetAvatarActor());
 
 	if (Data.EvaluatedData.Attribute == GetCurrentHealthAttribute())
 	{
-		const float NewCurrentHealth = FMath::Clamp(GetCurrentHealth(), 0.f, GetMaxHealth());
-
-		SetCurrentHealth(NewCurrentHealth);
-
-		PawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+		HandleCurrentHealthChanged(PawnUIComponent);
 	}
 	
 	if (Data.EvaluatedData.Attribute == GetCurrentRageAttribute())
 	{
-		const float NewCurrentRage = FMath::Clamp(GetCurrentRage(), 0.f, GetMaxRage());
-
-		SetCurrentRage(NewCurrentRage);
-
-		if (GetCurrentRage() == GetMaxRage())
-		{
-			UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(Data.Target.GetAvatarActor(), WarriorGameplayTags::Player_Status_Rage_Full);
-		}
-		else if(GetCurrentRage() == 0.f)
-		{
-			UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(Data.Target.GetAvatarActor(), WarriorGameplayTags::Player_Status_Rage_None);
-		}
-		else
-		{
-			UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(Data.Target.GetAvatarActor(), WarriorGameplayTags::Player_Status_Rage_Full);
-			UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(Data.Target.GetAvatarActor(), WarriorGameplayTags::Player_Status_Rage_None);
-		}
-
-		if (UHeroUIComponent* HeroUIComponent = CachedPawnUIInterface->GetHeroUIComponent())
-		{
-			HeroUIComponent->OnCurrentRageChanged.Broadcast(GetCurrentRage() / GetMaxRage());
-		}
+		HandleCurrentRageChanged(Data.Target.GetAvatarActor());
 	}
 
 	if (Data.EvaluatedData.Attribute == GetDamageTakenAttribute())
@@ -95,3 +61,67 @@ void UWarriorAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCal
 		}
 	}
 }
+
+void UWarriorAttributeSet::HandleBaseValueWritten(AActor* InAvatarActor, const FGameplayAttribute& InAttribute)
+{
+	if (InAttribute == GetCurrentHealthAttribute())
+	{
+		HandleCurrentHealthChanged(GetPawnUIComponentFromAvatar(InAvatarActor));
+	}
+
+	if (InAttribute == GetCurrentRageAttribute())
+	{
+		HandleCurrentRageChanged(InAvatarActor);
+	}
+}
+
+UPawnUIComponent* UWarriorAttributeSet::GetPawnUIComponentFromAvatar(AActor* InAvatarActor)
+{
+	if (!CachedPawnUIInterface.IsValid())
+	{
+		CachedPawnUIInterface = TWeakInterfacePtr<IPawnUIInterface>(InAvatarActor);
+	}
+
+	checkf(CachedPawnUIInterface.IsValid(), TEXT("%s didn't implement IPawnUIInterface"), *InAvatarActor->GetActorNameOrLabel());
+
+	UPawnUIComponent* PawnUIComponent = CachedPawnUIInterface->GetPawnUIComponent();
+
+	checkf(PawnUIComponent, TEXT("Couldn't extrac a PawnUIComponent from %s"), *InAvatarActor->GetActorNameOrLabel());
+
+	return PawnUIComponent;
+}
+
+void UWarriorAttributeSet::HandleCurrentHealthChanged(UPawnUIComponent* InPawnUIComponent)
+{
+	const float NewCurrentHealth = FMath::Clamp(GetCurrentHealth(), 0.f, GetMaxHealth());
+
+	SetCurrentHealth(NewCurrentHealth);
+
+	InPawnUIComponent->OnCurrentHealthChanged.Broadcast(GetCurrentHealth() / GetMaxHealth());
+}
+
+void UWarriorAttributeSet::HandleCurrentRageChanged(AActor* InAvatarActor)
+{
+	const float NewCurrentRage = FMath::Clamp(GetCurrentRage(), 0.f, GetMaxRage());
+
+	SetCurrentRage(NewCurrentRage);
+
+	if (GetCurrentRage() == GetMaxRage())
+	{
+		UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(InAvatarActor, WarriorGameplayTags::Player_Status_Rage_Full);
+	}
+	else if(GetCurrentRage() == 0.f)
+	{
+		UWarriorFunctionLibrary::AddGameplayTagToActorIfNone(InAvatarActor, WarriorGameplayTags::Player_Status_Rage_None);
+	}
+	else
+	{
+		UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(InAvatarActor, WarriorGameplayTags::Player_Status_Rage_Full);
+		UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(InAvatarActor, WarriorGameplayTags::Player_Status_Rage_None);
+	}
+
+	if (UHeroUIComponent* HeroUIComponent = CachedPawnUIInterface->GetHeroUIComponent())
+	{
+		HeroUIComponent->OnCurrentRageChanged.Broadcast(GetCurrentRage() / GetMaxRage());
+	}
+}
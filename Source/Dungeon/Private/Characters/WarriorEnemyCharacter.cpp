@@ -10,7 +10,18 @@
 #include "Components/WidgetComponent.h"
 #include "Widgets/WarriorWidgetBase.h"
 #include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/CollisionProfile.h"
 #include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
+#include "Controllers/WarriorAIController.h"
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Subsystems/WarriorTargetingSubsystem.h"
+#include "Subsystems/WarriorAISignificanceSubsystem.h"
+#include "Subsystems/WarriorHealthBarSubsystem.h"
+#include "TimerManager.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -63,12 +74,61 @@ UEnemyUIComponent* AWarriorEnemyCharacter::GetEnemyUIComponent() const
 
 void AWarriorEnemyCharacter::BeginPlay()
 {
+	if (bUseEnemyPool)
+	{
+		CachePoolResetState();
+	}
+
 	Super::BeginPlay();
 
-	if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
+	UWarriorHealthBarSubsystem* HealthBarSubsystem = bUseHealthBarLayer ? UWarriorHealthBarSubsystem::Get(this) : nullptr;
+
+	if (HealthBarSubsystem)
+	{
+		HealthBarSubsystem->RegisterHealthBar(this);
+		EnemyUIComponent->OnCurrentHealthChanged.AddUniqueDynamic(this, &ThisClass::OnHealthBarPercentChanged);
+
+		// The shared layer draws this bar. The component stays for Blueprints that reference it, but drops its widget
+		// and stops drawing and ticking.
+		EnemyHealthWidgetComponent->SetWidget(nullptr);
+		EnemyHealthWidgetComponent->SetVisibility(false);
+		EnemyHealthWidgetComponent->SetComponentTickEnabled(false);
+		bHealthBarOnLayer = true;
+	}
+	else if (UWarriorWidgetBase* HealthWidget = Cast<UWarriorWidgetBase>(EnemyHealthWidgetComponent->GetUserWidgetObject()))
 	{
 		HealthWidget->InitEnemyCreateWidget(this);
 	}
+
+	if (UWarriorAISignificanceSubsystem* SignificanceSubsystem = UWarriorAISignificanceSubsystem::Get(this))
+	{
+		SignificanceSubsystem->RegisterEnemy(this);
+	}
+
+	if (UWarriorTargetingSubsystem* TargetingSubsystem = UWarriorTargetingSubsystem::Get(this))
+	{
+		TargetingSubsystem->RegisterTarget(this);
+	}
+}
+
+void AWarriorEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWarriorAISignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UWarriorAISignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterEnemy(this);
+	}
+
+	if (UWarriorTargetingSubsystem* TargetingSubsystem = GetWorld()->GetSubsystem<UWarriorTargetingSubsystem>())
+	{
+		TargetingSubsystem->UnregisterTarget(this);
+	}
+
+	if (UWarriorHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UWarriorHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->UnregisterHealthBar(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AWarriorEnemyCharacter::PossessedBy(AController* NewController)
@@ -114,16 +174,180 @@ void AWarriorEnemyCharacter::InitEnemyStartUpData()
 		return;
 	}
 
+	// Every enemy of a type shares one start up data asset, so only the first one to spawn waits for the load
+	if (UDataAsset_StartUpDataBase* LoadedData = CharacterStartUpData.Get())
+	{
+		LoadedStartUpData = LoadedData;
+		LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent);
+		return;
+	}
+
 	UAssetManager::GetStreamableManager().RequestAsyncLoad(
 		CharacterStartUpData.ToSoftObjectPath(),
-		FStreamableDelegate::CreateLambda(
+		FStreamableDelegate::CreateWeakLambda(
+			this,
 			[this]()
 			{
 				if (UDataAsset_StartUpDataBase* LoadedData = CharacterStartUpData.Get())
 				{
+					LoadedStartUpData = LoadedData;
 					LoadedData->GiveToAbilitySystemComponent(WarriorAbilitySystemComponent);
 				}
 			}
 		)
 	);
 }
+
+void AWarriorEnemyCharacter::DeactivateForPool()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	WarriorAbilitySystemComponent->CancelAllAbilities();
+
+	if (AWarriorAIController* AIController = GetController<AWarriorAIController>())
+	{
+		AIController->SetPooledLogicPaused(true);
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+
+	// Weapons are separate actors attached to the mesh and do not inherit the hidden flag
+	TArray<AActor*> AttachedActors;
+	GetAttachedActors(AttachedActors);
+
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		AttachedActor->SetActorHiddenInGame(true);
+	}
+}
+
+void AWarriorEnemyCharacter::ActivateFromPool(const FTransform& InTransform)
+{
+	SetActorLocationAndRotation(InTransform.GetLocation(), InTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	UWarriorFunctionLibrary::RemoveGameplayTagFromActorIfFound(this, WarriorGameplayTags::Shared_Status_Dead);
+
+	RestorePoolResetState();
+
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetCurrentHealthAttribute(), WarriorAttributeSet->GetMaxHealth());
+	WarriorAbilitySystemComponent->SetNumericAttributeBase(UWarriorAttributeSet::GetDamageTakenAttribute(), 0.f);
+	EnemyUIComponent->OnCurrentHealthChanged.Broadcast(1.f);
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	TArray<AActor*> AttachedActors;
+	GetAttachedActors(AttachedActors);
+
+	for (AActor* AttachedActor : AttachedActors)
+	{
+		AttachedActor->SetActorHiddenInGame(false);
+	}
+
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetDefaultMovementMode();
+
+	if (AWarriorAIController* AIController = GetController<AWarriorAIController>())
+	{
+		AIController->SetPooledLogicPaused(false);
+	}
+
+	BP_OnActivatedFromPool();
+}
+
+void AWarriorEnemyCharacter::CachePoolResetState()
+{
+	PoolInitialMeshMaterials = GetMesh()->GetMaterials();
+	PoolInitialMeshRelativeTransform = GetMesh()->GetRelativeTransform();
+
+	PoolInitialCapsuleCollision.Cache(GetCapsuleComponent());
+	PoolInitialMeshCollision.Cache(GetMesh());
+}
+
+void AWarriorEnemyCharacter::RestorePoolResetState()
+{
+	USkeletalMeshComponent* MeshComponent = GetMesh();
+
+	// Ragdoll deaths detach the mesh from the capsule
+	if (MeshComponent->IsSimulatingPhysics())
+	{
+		MeshComponent->SetSimulatePhysics(false);
+		MeshComponent->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+		MeshComponent->SetRelativeTransform(PoolInitialMeshRelativeTransform);
+	}
+
+	for (int32 MaterialIndex = 0; MaterialIndex < PoolInitialMeshMaterials.Num(); MaterialIndex++)
+	{
+		if (MeshComponent->GetMaterial(MaterialIndex) != PoolInitialMeshMaterials[MaterialIndex])
+		{
+			MeshComponent->SetMaterial(MaterialIndex, PoolInitialMeshMaterials[MaterialIndex]);
+		}
+	}
+
+	PoolInitialCapsuleCollision.Restore(GetCapsuleComponent());
+	PoolInitialMeshCollision.Restore(MeshComponent);
+}
+
+void AWarriorEnemyCharacter::FPoolCollisionState::Cache(const UPrimitiveComponent* InComponent)
+{
+	ProfileName = InComponent->GetCollisionProfileName();
+	CollisionEnabled = InComponent->GetCollisionEnabled();
+	ObjectType = InComponent->GetCollisionObjectType();
+	Responses = InComponent->GetCollisionResponseToChannels();
+}
+
+void AWarriorEnemyCharacter::FPoolCollisionState::Restore(UPrimitiveComponent* InComponent) const
+{
+	if (ProfileName != UCollisionProfile::CustomCollisionProfileName)
+	{
+		InComponent->SetCollisionProfileName(ProfileName);
+		return;
+	}
+
+	InComponent->SetCollisionEnabled(CollisionEnabled);
+	InComponent->SetCollisionObjectType(ObjectType);
+	InComponent->SetCollisionResponseToChannels(Responses);
+}
+
+void AWarriorEnemyCharacter::ReleaseToPoolOrDestroy()
+{
+	UWarriorEnemyPoolSubsystem* EnemyPool = UWarriorEnemyPoolSubsystem::Get(this);
+
+	if (bIsPooled && EnemyPool)
+	{
+		EnemyPool->ReleaseEnemy(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AWarriorEnemyCharacter::K2_DestroyActor()
+{
+	const UWorld* World = GetWorld();
+
+	// Level teardown and actors already on their way out are destroyed as usual
+	if (bIsPooled && !IsActorBeingDestroyed() && World && !World->bIsTearingDown)
+	{
+		ReleaseToPoolOrDestroy();
+		return;
+	}
+
+	Super::K2_DestroyActor();
+}
+
+void AWarriorEnemyCharacter::OnHealthBarPercentChanged(float NewPercent)
+{
+	if (UWarriorHealthBarSubsystem* HealthBarSubsystem = GetWorld()->GetSubsystem<UWarriorHealthBarSubsystem>())
+	{
+		HealthBarSubsystem->SetHealthFraction(this, NewPercent);
+	}
+}
@@ -15,6 +15,7 @@
 #include "DataAssets/StartUpData/DataAsset_HeroStartUpData.h"
 #include "Components/Combat/HeroCombatComponent.h"
 #include "Components/UI/HeroUIComponent.h"
+#include "Components/UI/HeroPortraitCaptureComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "Inventory/InventoryComponent.h"
 #include "Inventory/MyPlayerState.h"
@@ -26,6 +27,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Camera/CameraActor.h"
 #include "Inventory/InventoryItemActor.h"
+#include "Engine/StaticMesh.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "DrawDebugHelpers.h"
 #include "Inventory/SlotStruct.h"
@@ -34,6 +36,7 @@
 #include "WarriorDebugHelper.h"
 #include "UI/Inventory/CookingWidget.h" // Include the cooking widget header
 #include "Blueprint/UserWidget.h" // Needed for CreateWidget
+#include "Subsystems/WarriorWorldMarkerSubsystem.h"
 #include "Particles/ParticleSystem.h" // Added for UParticleSystem
 #include "Sound/SoundBase.h" // Added for USoundBase
 #include "NiagaraFunctionLibrary.h" // Added for Niagara SpawnSystem
@@ -65,6 +68,11 @@ AWarriorHeroCharacter::AWarriorHeroCharacter()
 	// Scene Capture Component 2D 생성 및 초기 설정
 	SceneCaptureComponent2D = CreateDefaultSubobject<USceneCaptureComponent2D>(TEXT("SceneCaptureComponent2D"));
 	SceneCaptureComponent2D->SetupAttachment(GetRootComponent());
+	SceneCaptureComponent2D->bCaptureEveryFrame = false;
+	SceneCaptureComponent2D->bCaptureOnMovement = false;
+
+	// Renders the capture only while the inventory portrait is on screen
+	PortraitCaptureComponent = CreateDefaultSubobject<UHeroPortraitCaptureComponent>(TEXT("PortraitCaptureComponent"));
 	
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	GetCharacterMovement()->RotationRate = FRotator(0.f, 500.f, 0.f);
@@ -224,6 +232,7 @@ void AWarriorHeroCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInp
         if (SliceAction)
         {
             EnhancedInputComponent->BindAction(SliceAction, ETriggerEvent::Started, this, &AWarriorHeroCharacter::Input_SliceStart); // Use Started for press
+            EnhancedInputComponent->BindAction(SliceAction, ETriggerEvent::Triggered, this, &AWarriorHeroCharacter::Input_SliceUpdate); // Fires every frame while held, samples the cursor path
             EnhancedInputComponent->BindAction(SliceAction, ETriggerEvent::Completed, this, &AWarriorHeroCharacter::Input_SliceEnd); // Use Completed for release
             EnhancedInputComponent->BindAction(SliceAction, ETriggerEvent::Canceled, this, &AWarriorHeroCharacter::Input_SliceEnd); // Also handle cancellation
              UE_LOG(LogTemp, Log, TEXT("Bound SliceAction to Input_SliceStart/End"));
@@ -281,9 +290,13 @@ void AWarriorHeroCharacter::BeginPlay()
 	// Scene Capture Component 2D 설정
 	if (SceneCaptureComponent2D)
 	{
-		SceneCaptureComponent2D->bCaptureEveryFrame = true;
 		SceneCaptureComponent2D->ShowOnlyActorComponents(this);
 		SceneCaptureComponent2D->CaptureSource = ESceneCaptureSource::SCS_SceneColorHDR;
+
+		if (PortraitCaptureComponent)
+		{
+			PortraitCaptureComponent->SetSceneCapture(SceneCaptureComponent2D);
+		}
 	}
 
 	// Interaction Sphere binding
@@ -383,7 +396,7 @@ void AWarriorHeroCharacter::OnInteractionSphereBeginOverlap(UPrimitiveComponent*
     if (Table && !CurrentInteractableTable) // Check if it's a table and we aren't already focused on one
     {
         CurrentInteractableTable = Table;
-        // TODO: Show UI Prompt (e.g., "Press C to Cook")
+        ShowInteractPrompt(Table);
         UE_LOG(LogTemp, Log, TEXT("Interactable table in range: %s"), *Table->GetName());
     }
 }
@@ -394,11 +407,50 @@ void AWarriorHeroCharacter::OnInteractionSphereEndOverlap(UPrimitiveComponent* O
     if (Table && Table == CurrentInteractableTable) // Check if the exiting actor is our current target
     {
         CurrentInteractableTable = nullptr;
-        // TODO: Hide UI Prompt
+        HideInteractPrompt();
         UE_LOG(LogTemp, Log, TEXT("Interactable table out of range: %s"), *Table->GetName());
     }
 }
 
+void AWarriorHeroCharacter::ShowInteractPrompt(AActor* InInteractable)
+{
+    APlayerController* PlayerController = Cast<APlayerController>(GetController());
+    if (!InteractPromptWidgetClass || !PlayerController || !PlayerController->IsLocalController())
+    {
+        return;
+    }
+
+    if (!InteractPromptWidget)
+    {
+        InteractPromptWidget = CreateWidget<UUserWidget>(PlayerController, InteractPromptWidgetClass);
+    }
+
+    if (!InteractPromptWidget->IsInViewport())
+    {
+        InteractPromptWidget->AddToViewport();
+    }
+
+    if (UWarriorWorldMarkerSubsystem* WorldMarkerSubsystem = UWarriorWorldMarkerSubsystem::Get(this))
+    {
+        WorldMarkerSubsystem->AddMarker(InteractPromptWidget, InInteractable->GetRootComponent(), InteractPromptWorldOffset);
+    }
+}
+
+void AWarriorHeroCharacter::HideInteractPrompt()
+{
+    if (!InteractPromptWidget)
+    {
+        return;
+    }
+
+    if (UWarriorWorldMarkerSubsystem* WorldMarkerSubsystem = UWarriorWorldMarkerSubsystem::Get(this))
+    {
+        WorldMarkerSubsystem->RemoveMarker(InteractPromptWidget);
+    }
+
+    InteractPromptWidget->RemoveFromParent();
+}
+
 void AWarriorHeroCharacter::Input_ToggleCookingModePressed()
 {
     APlayerController* PlayerController = Cast<APlayerController>(GetController());
@@ -449,6 +501,7 @@ void AWarriorHeroCharacter::Input_ToggleCookingModePressed()
 
         bIsInCookingMode = false;
         bIsDraggingSlice = false; // Reset dragging state
+        SliceSampleCount = 0;
     }
     else
     {
@@ -552,180 +605,216 @@ void AWarriorHeroCharacter::Input_SliceStart()
          return;
     }
 
+    // Reset candidate and sample ring initially
+    SlicedItemCandidate = nullptr;
+    bIsDraggingSlice = false;
+    SliceStartWorldLocation = FVector::ZeroVector;
+    SliceSampleHead = 0;
+    SliceSampleCount = 0;
+
     // Get current mouse position
-    if (PlayerController->GetMousePosition(SliceStartScreenPosition.X, SliceStartScreenPosition.Y))
+    if (!PlayerController->GetMousePosition(SliceStartScreenPosition.X, SliceStartScreenPosition.Y))
     {
-        // UE_LOG(LogTemp, Log, TEXT("Slice Start - Screen Pos: %s"), *SliceStartScreenPosition.ToString()); // 제거
-
-        // Use GetHitResultUnderCursor to find the object directly under the mouse
-        FHitResult HitResult;
-        bool bHit = PlayerController->GetHitResultUnderCursorByChannel(
-            UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_GameTraceChannel1), // Use InteractionQuery Channel
-            true, // bTraceComplex
-            HitResult
-        );
-
-        // Draw debug point for where the cursor trace hit (or where it would have been)
-        // We might need WorldOrigin/Direction if trace fails, but let's get it anyway for debug
-        // FVector WorldOrigin, WorldDirection; // 제거
-        // UGameplayStatics::DeprojectScreenToWorld(PlayerController, SliceStartScreenPosition, WorldOrigin, WorldDirection); // 제거
-        // DrawDebugSphere(GetWorld(), WorldOrigin + WorldDirection * HitResult.Distance, 5.0f, 12, FColor::Yellow, false, 30.0f); // 제거
-
-        // Reset candidate initially
-        SlicedItemCandidate = nullptr;
-        bIsDraggingSlice = false; 
-
-        if (bHit && HitResult.GetActor())
-        {   
-            // Check if the hit actor is an inventory item
-            AInventoryItemActor* HitItemActor = Cast<AInventoryItemActor>(HitResult.GetActor());
-            if (HitItemActor)
-            {
-                SliceStartWorldLocation = HitResult.Location; // Use the actual hit location
-                SlicedItemCandidate = HitItemActor; // Store the candidate item
-                // UE_LOG(LogTemp, Log, TEXT("Slice Start - Cursor trace hit INVENTORY ITEM: %s at %s. Storing as candidate. Setting bIsDraggingSlice = true."), // 제거
-                //     *SlicedItemCandidate->GetName(), // 제거
-                //     *SliceStartWorldLocation.ToString() // 제거
-                // ); // 제거
-                 bIsDraggingSlice = true;
-                 // DrawDebugSphere(GetWorld(), SliceStartWorldLocation, 5.0f, 12, FColor::Cyan, false, 30.0f); // 제거
-            }
-            else
-            {
-                // UE_LOG(LogTemp, Log, TEXT("Slice Start - Cursor trace hit actor '%s', but it's not an InventoryItemActor."), *HitResult.GetActor()->GetName()); // 제거
-                SliceStartWorldLocation = FVector::ZeroVector; // Still reset location if not an item
-            }
-        }
-        else
-        {
-             // UE_LOG(LogTemp, Warning, TEXT("Slice Start - Cursor trace did not hit anything.")); // 제거
-             SliceStartWorldLocation = FVector::ZeroVector; // Ensure reset
-        }
-        
-        // Ensure drag state is false if we didn't hit a valid item
-        if (!SlicedItemCandidate)
-        {
-            bIsDraggingSlice = false;
-        }
+        return;
     }
-    else
+
+    // This is the only trace of the gesture: it picks the candidate item, and the cut plane is later fitted against its bounds
+    FHitResult HitResult;
+    const bool bHit = PlayerController->GetHitResultUnderCursorByChannel(
+        UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_GameTraceChannel1), // Use InteractionQuery Channel
+        true, // bTraceComplex
+        HitResult
+    );
+
+    if (bHit)
     {
-        // UE_LOG(LogTemp, Warning, TEXT("Slice Start - Failed to get mouse position. bIsDraggingSlice remains false.")); // 제거
-         bIsDraggingSlice = false; // Explicitly ensure it's false
+        if (AInventoryItemActor* HitItemActor = Cast<AInventoryItemActor>(HitResult.GetActor()))
+        {
+            SliceStartWorldLocation = HitResult.Location; // Use the actual hit location
+            SlicedItemCandidate = HitItemActor; // Store the candidate item
+            bIsDraggingSlice = true;
+
+            RecordSliceSample(SliceStartScreenPosition, true);
+        }
     }
 }
 
-void AWarriorHeroCharacter::Input_SliceEnd()
+void AWarriorHeroCharacter::Input_SliceUpdate()
 {
-    // UE_LOG(LogTemp, Log, TEXT("Input_SliceEnd triggered. Current bIsDraggingSlice = %d"), bIsDraggingSlice); // 제거
-    if (!bIsInCookingMode || !bIsDraggingSlice || !CurrentInteractableTable) 
+    if (!bIsDraggingSlice)
     {
-         // UE_LOG(LogTemp, Warning, TEXT("Input_SliceEnd aborted early: CookingMode=%d, IsDragging=%d, Table=%d"), bIsInCookingMode, bIsDraggingSlice, CurrentInteractableTable != nullptr); // 제거
-         // Reset slice state even if aborted early
-         bIsDraggingSlice = false;
-         SliceStartWorldLocation = FVector::ZeroVector;
-         SliceEndWorldLocation = FVector::ZeroVector;
-         return; 
+        return;
     }
 
-    APlayerController* PlayerController = Cast<APlayerController>(GetController());
-    if (!PlayerController) 
+    const APlayerController* PlayerController = Cast<APlayerController>(GetController());
+    FVector2D ScreenPosition;
+    if (PlayerController && PlayerController->GetMousePosition(ScreenPosition.X, ScreenPosition.Y))
     {
-        // UE_LOG(LogTemp, Warning, TEXT("Input_SliceEnd aborted: No PlayerController.")); // 제거
-        bIsDraggingSlice = false; // Ensure reset
-        SliceStartWorldLocation = FVector::ZeroVector; 
-        return;
+        RecordSliceSample(ScreenPosition);
     }
+}
+
+void AWarriorHeroCharacter::Input_SliceEnd()
+{
+    APlayerController* PlayerController = Cast<APlayerController>(GetController());
 
-    FVector2D SliceEndScreenPosition;
-    if (PlayerController->GetMousePosition(SliceEndScreenPosition.X, SliceEndScreenPosition.Y))
+    if (bIsInCookingMode && bIsDraggingSlice && CurrentInteractableTable && PlayerController && IsValid(SlicedItemCandidate))
     {
-        // UE_LOG(LogTemp, Log, TEXT("Slice End - Screen Pos: %s"), *SliceEndScreenPosition.ToString()); // 제거
+        FVector2D SliceEndScreenPosition;
+        if (PlayerController->GetMousePosition(SliceEndScreenPosition.X, SliceEndScreenPosition.Y))
+        {
+            // Always keep the release point, even if the cursor barely moved since the last sample
+            RecordSliceSample(SliceEndScreenPosition, true);
 
-        // --- Check Screen Distance First ---
-        const float ScreenDistance = FVector2D::Distance(SliceStartScreenPosition, SliceEndScreenPosition);
-        const float ScreenDistanceThreshold = 10.0f; // Minimum pixel distance for a slice
-        // UE_LOG(LogTemp, Log, TEXT("Calculated Screen Distance: %.2f (Threshold: %.1f)"), ScreenDistance, ScreenDistanceThreshold); // 제거
+            // --- Check Screen Distance First ---
+            const float ScreenDistance = FVector2D::Distance(SliceStartScreenPosition, SliceEndScreenPosition);
+            const float ScreenDistanceThreshold = 10.0f; // Minimum pixel distance for a slice
 
-        if (ScreenDistance < ScreenDistanceThreshold)
-        {
-            // UE_LOG(LogTemp, Log, TEXT("Slice canceled - screen drag distance too short.")); // 제거
-        }
-        else
-        {   
-            // Screen distance is sufficient, get world end location via GetHitResultUnderCursor
-            FHitResult EndHitResult;
-            bool bEndHit = PlayerController->GetHitResultUnderCursorByChannel(
-                UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_GameTraceChannel1),
-                true, // bTraceComplex
-                EndHitResult
-            );
-            
-            // Draw debug point for where the end cursor trace hit
-            // FVector EndWorldOrigin, EndWorldDirection; // Need temp vars for debug draw // 제거
-            // UGameplayStatics::DeprojectScreenToWorld(PlayerController, SliceEndScreenPosition, EndWorldOrigin, EndWorldDirection); // 제거
-            // DrawDebugSphere(GetWorld(), EndWorldOrigin + EndWorldDirection * EndHitResult.Distance, 5.0f, 12, FColor::Orange, false, 30.0f); // 제거
-
-            AInventoryItemActor* EndHitItemActor = nullptr;
-            if (bEndHit && EndHitResult.GetActor())
+            FVector PlanePosition;
+            FVector PlaneNormal;
+            if (ScreenDistance >= ScreenDistanceThreshold && FitSlicePlaneToSamples(PlayerController, PlanePosition, PlaneNormal))
             {
-                SliceEndWorldLocation = EndHitResult.Location;
-                EndHitItemActor = Cast<AInventoryItemActor>(EndHitResult.GetActor()); // Try casting end hit actor
-                // ... Log End Cursor trace hit ...
-                // ... Draw Debug Sphere (Magenta) ...
+                PerformSlice(SlicedItemCandidate, PlanePosition, PlaneNormal); // Use the stored candidate
             }
             else
             {
-                 // UE_LOG(LogTemp, Warning, TEXT("Slice End - Cursor trace for end point did not hit anything or invalid actor.")); // 제거
-                 SliceEndWorldLocation = FVector::ZeroVector;
-            }
-
-            // --- Perform Slice only if Start and End hit the SAME Inventory Item ---
-            if (SlicedItemCandidate != nullptr && // Was a valid item hit at the start?
-                EndHitItemActor == SlicedItemCandidate && // Did the end hit the SAME item?
-                !SliceStartWorldLocation.IsNearlyZero() && 
-                !SliceEndWorldLocation.IsNearlyZero())
-            {
-                // All conditions met, proceed with slice
-                if (SlicedItemCandidate)
-                {
-                    // UE_LOG(LogTemp, Log, TEXT("Start/End points valid and hit the SAME InventoryItem (%s). Performing Slice."), *SlicedItemCandidate->GetName()); // 제거
-                     // Draw the debug line representing the slice path
-                    // DrawDebugLine(GetWorld(), SliceStartWorldLocation, SliceEndWorldLocation, FColor::Yellow, false, 30.0f, 0, 1.0f); // 제거
-
-                    // Calculate cutting plane (Moved calculation here)
-                    FVector SliceDirection = (SliceEndWorldLocation - SliceStartWorldLocation).GetSafeNormal();
-                    FVector PlanePosition = (SliceStartWorldLocation + SliceEndWorldLocation) / 2.0f;
-                    FVector PlaneNormal = (SliceDirection ^ FVector::UpVector).GetSafeNormal(); 
-                    if (PlaneNormal.IsNearlyZero()) { PlaneNormal = FVector::ForwardVector; }
-
-                    PerformSlice(SlicedItemCandidate, PlanePosition, PlaneNormal); // Use the stored candidate
-                }
-            }
-            else
-            { 
-                // Log the reason for aborting
-                // FString AbortReason = TEXT("Unknown"); // 제거
-                // if (!SlicedItemCandidate) AbortReason = TEXT("No valid item hit at start"); // 제거
-                // else if (EndHitItemActor != SlicedItemCandidate) AbortReason = FString::Printf(TEXT("End hit different actor (%s) or not an item"), EndHitItemActor ? *EndHitItemActor->GetName() : TEXT("None")); // 제거
-                // else if (SliceStartWorldLocation.IsNearlyZero() || SliceEndWorldLocation.IsNearlyZero()) AbortReason = TEXT("Start or End WorldLocation zero"); // 제거
-                // UE_LOG(LogTemp, Warning, TEXT("Slice aborted - Reason: %s"), *AbortReason); // 제거
+                UE_LOG(LogTemp, Verbose, TEXT("Slice aborted - drag too short (%.1f px) or fitted plane missed %s."), ScreenDistance, *SlicedItemCandidate->GetName());
             }
         }
     }
-    // else // 제거 (else 블록이 비어있게 되므로 제거)
-    // { UE_LOG(LogTemp, Warning, TEXT("Slice End - Failed to get mouse position.")); } // 제거
 
     // Reset locations and dragging state AFTER the operation attempts
-    // UE_LOG(LogTemp, Log, TEXT("Input_SliceEnd finished. Resetting bIsDraggingSlice = false.")); // 제거
     bIsDraggingSlice = false; 
     SliceStartWorldLocation = FVector::ZeroVector; 
-    SliceEndWorldLocation = FVector::ZeroVector;
+    SliceSampleCount = 0;
 
     // Reset candidate at the very end
     SlicedItemCandidate = nullptr;
 }
 
+void AWarriorHeroCharacter::RecordSliceSample(const FVector2D& ScreenPosition, bool bForce)
+{
+    const int32 Capacity = FMath::Max(MaxSliceSamples, 2);
+    if (SliceScreenSamples.Num() != Capacity)
+    {
+        SliceScreenSamples.SetNumUninitialized(Capacity);
+        SliceSampleHead = 0;
+        SliceSampleCount = 0;
+    }
+
+    if (!bForce && SliceSampleCount > 0)
+    {
+        const FVector2D& LastSample = SliceScreenSamples[(SliceSampleHead - 1 + Capacity) % Capacity];
+        if (FVector2D::DistSquared(LastSample, ScreenPosition) < FMath::Square(SliceSampleMinSpacing))
+        {
+            return;
+        }
+    }
+
+    SliceScreenSamples[SliceSampleHead] = ScreenPosition;
+    SliceSampleHead = (SliceSampleHead + 1) % Capacity;
+    SliceSampleCount = FMath::Min(SliceSampleCount + 1, Capacity);
+}
+
+bool AWarriorHeroCharacter::FitSlicePlaneToSamples(const APlayerController* PlayerController, FVector& OutPlanePosition, FVector& OutPlaneNormal) const
+{
+    if (!PlayerController || !SlicedItemCandidate || SliceSampleCount < 2)
+    {
+        return false;
+    }
+
+    // Deproject every buffered sample in one pass, oldest first
+    const int32 Capacity = SliceScreenSamples.Num();
+    const int32 OldestIndex = (SliceSampleHead - SliceSampleCount + Capacity) % Capacity;
+
+    TArray<FVector, TInlineAllocator<64>> RayDirections;
+    FVector RayOriginSum = FVector::ZeroVector;
+    FVector DirectionSum = FVector::ZeroVector;
+
+    for (int32 SampleIndex = 0; SampleIndex < SliceSampleCount; ++SampleIndex)
+    {
+        const FVector2D& Sample = SliceScreenSamples[(OldestIndex + SampleIndex) % Capacity];
+
+        FVector RayOrigin;
+        FVector RayDirection;
+        if (PlayerController->DeprojectScreenPositionToWorld(Sample.X, Sample.Y, RayOrigin, RayDirection))
+        {
+            RayDirections.Add(RayDirection);
+            RayOriginSum += RayOrigin;
+            DirectionSum += RayDirection;
+        }
+    }
+
+    if (RayDirections.Num() < 2)
+    {
+        return false;
+    }
+
+    const FVector RayOrigin = RayOriginSum / RayDirections.Num();
+    const FVector MeanDirection = DirectionSum.GetSafeNormal();
+    if (MeanDirection.IsNearlyZero())
+    {
+        return false;
+    }
+
+    // Least squares fit of the sweep line in the plane perpendicular to the mean ray.
+    // The cut plane contains the mean ray and the principal axis of the fan.
+    FVector AxisX;
+    FVector AxisY;
+    MeanDirection.FindBestAxisVectors(AxisX, AxisY);
+
+    double MeanX = 0.0;
+    double MeanY = 0.0;
+    for (const FVector& RayDirection : RayDirections)
+    {
+        MeanX += RayDirection | AxisX;
+        MeanY += RayDirection | AxisY;
+    }
+    MeanX /= RayDirections.Num();
+    MeanY /= RayDirections.Num();
+
+    double Sxx = 0.0;
+    double Syy = 0.0;
+    double Sxy = 0.0;
+    for (const FVector& RayDirection : RayDirections)
+    {
+        const double DeltaX = (RayDirection | AxisX) - MeanX;
+        const double DeltaY = (RayDirection | AxisY) - MeanY;
+        Sxx += DeltaX * DeltaX;
+        Syy += DeltaY * DeltaY;
+        Sxy += DeltaX * DeltaY;
+    }
+
+    if (Sxx + Syy <= UE_SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    const double SweepAngle = 0.5 * FMath::Atan2(2.0 * Sxy, Sxx - Syy);
+    const FVector SweepDirection = AxisX * FMath::Cos(SweepAngle) + AxisY * FMath::Sin(SweepAngle);
+
+    OutPlaneNormal = (SweepDirection ^ MeanDirection).GetSafeNormal();
+    if (OutPlaneNormal.IsNearlyZero())
+    {
+        return false;
+    }
+
+    // Reject planes that miss the candidate's bounds, otherwise snap the plane position onto the item
+    FVector BoundsOrigin;
+    FVector BoxExtent;
+    SlicedItemCandidate->GetActorBounds(false, BoundsOrigin, BoxExtent);
+
+    const double DistanceToCenter = OutPlaneNormal | (BoundsOrigin - RayOrigin);
+    const double ProjectedExtent = FMath::Abs(OutPlaneNormal.X) * BoxExtent.X + FMath::Abs(OutPlaneNormal.Y) * BoxExtent.Y + FMath::Abs(OutPlaneNormal.Z) * BoxExtent.Z;
+    if (FMath::Abs(DistanceToCenter) > ProjectedExtent)
+    {
+        return false;
+    }
+
+    OutPlanePosition = BoundsOrigin - OutPlaneNormal * DistanceToCenter;
+    return true;
+}
+
 // Placeholder for the actual slicing logic
 void AWarriorHeroCharacter::PerformSlice(AInventoryItemActor* ItemToSlice, const FVector& PlanePosition, const FVector& PlaneNormal)
 {
@@ -777,117 +866,171 @@ void AWarriorHeroCharacter::PerformSlice(AInventoryItemActor* ItemToSlice, const
 
 // Implementation for placing an item from the inventory onto the interactable table/pot
 void AWarriorHeroCharacter::PlaceItemOnTable(int32 SlotIndex)
+{
+	PlaceItemsOnTable(SlotIndex, 1, EWarriorItemPlacementLayout::Grid);
+}
+
+int32 AWarriorHeroCharacter::PlaceItemsOnTable(int32 SlotIndex, int32 Count, EWarriorItemPlacementLayout Layout)
 {
 	// 1. Validate necessary components and state
 	if (!InventoryComponent)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[PlaceItemOnTable] InventoryComponent is null."));
-		return;
+		UE_LOG(LogTemp, Error, TEXT("[PlaceItemsOnTable] InventoryComponent is null."));
+		return 0;
 	}
 	if (!CurrentInteractableTable) // CurrentInteractableTable could be a table OR a pot now
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemOnTable] CurrentInteractableTable is null. Cannot place item."));
-		return;
+		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemsOnTable] CurrentInteractableTable is null. Cannot place item."));
+		return 0;
 	}
-    // DefaultItemActorClass check is only needed if spawning an actor (i.e., not a pot)
-	// Check if SlotIndex is valid directly against the component's array
 	if (!InventoryComponent->InventorySlots.IsValidIndex(SlotIndex))
 	{
-		UE_LOG(LogTemp, Error, TEXT("[PlaceItemOnTable] Invalid SlotIndex: %d"), SlotIndex);
-		return;
+		UE_LOG(LogTemp, Error, TEXT("[PlaceItemsOnTable] Invalid SlotIndex: %d"), SlotIndex);
+		return 0;
 	}
 
 	// 2. Get the item data from the slot (make a copy)
-	FSlotStruct ItemDataToPlace = InventoryComponent->InventorySlots[SlotIndex];
+	const FSlotStruct ItemDataToPlace = InventoryComponent->InventorySlots[SlotIndex];
 
-	// 3. Check if the slot is actually occupied
+	// 3. Clamp the request to what the slot actually holds
 	if (ItemDataToPlace.ItemID.RowName.IsNone() || ItemDataToPlace.Quantity <= 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemOnTable] Slot %d is empty. Cannot place."), SlotIndex);
-		return;
+		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemsOnTable] Slot %d is empty. Cannot place."), SlotIndex);
+		return 0;
+	}
+
+	const int32 NumToPlace = FMath::Min(Count, ItemDataToPlace.Quantity);
+	if (NumToPlace <= 0)
+	{
+		return 0;
 	}
 
-    // Check if the interactable is a Pot
-    AInteractablePot* Pot = Cast<AInteractablePot>(CurrentInteractableTable);
+	AInteractablePot* Pot = Cast<AInteractablePot>(CurrentInteractableTable);
 
-	// 4. Attempt to remove ONE item from the inventory slot
-	if (InventoryComponent->RemoveItemFromSlot(SlotIndex, 1))
+	// DefaultItemActorClass check is only needed if spawning actors (i.e., not a pot)
+	if (!Pot && !DefaultItemActorClass)
 	{
-        // If it's a pot, add the ingredient directly
-        if (Pot)
-        {
-            if (Pot->AddIngredient(ItemDataToPlace.ItemID.RowName))
-            {
-                UE_LOG(LogTemp, Log, TEXT("[PlaceItemOnTable] Added ingredient '%s' to Pot '%s' from slot %d."), *ItemDataToPlace.ItemID.RowName.ToString(), *Pot->GetName(), SlotIndex);
-                // Play "drop in pot" sound/effect?
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[PlaceItemOnTable] Failed to add ingredient '%s' to Pot '%s'."), *ItemDataToPlace.ItemID.RowName.ToString(), *Pot->GetName());
-                // Optionally: Give the item back to the player if adding fails?
-                // InventoryComponent->AddItemToInventory(ItemDataToPlace.ItemID.RowName, 1); // Example: Needs proper function call
-            }
-            return; // Stop here for pots, no actor spawning needed
-        }
-        // If it's not a pot (presumably a regular table), spawn the item actor
-        else
-        {
-             // Check DefaultItemActorClass only if we are going to spawn
-             if (!DefaultItemActorClass)
-             {
-                 UE_LOG(LogTemp, Error, TEXT("[PlaceItemOnTable] DefaultItemActorClass is not set. Cannot spawn item actor on table."));
-                 // Give the item back since we failed to spawn its actor
-                 // InventoryComponent->AddItemToInventory(ItemDataToPlace.ItemID.RowName, 1); // Example: Needs AddItem function
-                 return;
-             }
-
-            // 5. Determine spawn location and rotation on the table
-            FVector SpawnLocation = CurrentInteractableTable->GetActorLocation(); // Default location
-            FRotator SpawnRotation = CurrentInteractableTable->GetActorRotation();
-
-            USceneComponent* SpawnPointComponent = Cast<USceneComponent>(CurrentInteractableTable->GetDefaultSubobjectByName(FName("ItemSpawnPoint")));
-            if (SpawnPointComponent)
-            {
-                SpawnLocation = SpawnPointComponent->GetComponentLocation();
-                SpawnRotation = SpawnPointComponent->GetComponentRotation();
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("[PlaceItemOnTable] Could not find 'ItemSpawnPoint' component on table '%s'. Using fallback location."), *CurrentInteractableTable->GetName());
-                SpawnLocation = CurrentInteractableTable->GetActorLocation() + FVector(0, 0, 10.0f);
-            }
+		UE_LOG(LogTemp, Error, TEXT("[PlaceItemsOnTable] DefaultItemActorClass is not set. Cannot spawn item actors on table."));
+		return 0;
+	}
 
-            FActorSpawnParameters SpawnParams;
-            SpawnParams.Owner = this;
-            SpawnParams.Instigator = GetInstigator();
-            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+	// 4. Remove the whole quantity at once, this is the only inventory UI update of the batch
+	if (!InventoryComponent->RemoveItemFromSlot(SlotIndex, NumToPlace))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemsOnTable] Failed to remove %d item(s) from slot %d. Aborting placement."), NumToPlace, SlotIndex);
+		return 0;
+	}
 
-            // 6. Spawn the item actor at the spawn point location
-            AInventoryItemActor* PlacedActor = GetWorld()->SpawnActor<AInventoryItemActor>(DefaultItemActorClass, SpawnLocation, SpawnRotation, SpawnParams);
+	// Pots take ingredients directly, no actor spawning needed
+	if (Pot)
+	{
+		int32 NumAdded = 0;
+		for (int32 Index = 0; Index < NumToPlace; ++Index)
+		{
+			if (Pot->AddIngredient(ItemDataToPlace.ItemID.RowName))
+			{
+				++NumAdded;
+			}
+		}
 
-            if (PlacedActor)
-            {
-                UE_LOG(LogTemp, Log, TEXT("[PlaceItemOnTable] Spawned actor %s on table %s."), *PlacedActor->GetName(), *CurrentInteractableTable->GetName());
-
-                // 7. Set up the spawned actor
-                FSlotStruct SpawnedItemData = ItemDataToPlace;
-                SpawnedItemData.Quantity = 1;
-                PlacedActor->SetItemData(SpawnedItemData);
-                 // Optionally enable physics for the placed item on the table
-                 // PlacedActor->RequestEnablePhysics();
-            }
-            else
-            {
-                 UE_LOG(LogTemp, Error, TEXT("[PlaceItemOnTable] Failed to spawn Item Actor of class %s on table."), *DefaultItemActorClass->GetName());
-                 // Give the item back if spawning failed
-                 // InventoryComponent->AddItemToInventory(ItemDataToPlace.ItemID.RowName, 1); // Example: Needs AddItem function
-            }
-        }
+		UE_LOG(LogTemp, Log, TEXT("[PlaceItemsOnTable] Added %d/%d of ingredient '%s' to Pot '%s' from slot %d."), NumAdded, NumToPlace, *ItemDataToPlace.ItemID.RowName.ToString(), *Pot->GetName(), SlotIndex);
+		return NumAdded;
+	}
+
+	// 5. Resolve the spawn point once for the whole batch
+	FTransform SpawnPointTransform = CurrentInteractableTable->GetActorTransform();
+
+	if (USceneComponent* SpawnPointComponent = Cast<USceneComponent>(CurrentInteractableTable->GetDefaultSubobjectByName(FName("ItemSpawnPoint"))))
+	{
+		SpawnPointTransform = SpawnPointComponent->GetComponentTransform();
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemOnTable] Failed to remove item from slot %d. Aborting placement."), SlotIndex);
+		UE_LOG(LogTemp, Warning, TEXT("[PlaceItemsOnTable] Could not find 'ItemSpawnPoint' component on table '%s'. Using fallback location."), *CurrentInteractableTable->GetName());
+		SpawnPointTransform.AddToTranslation(FVector(0, 0, 10.0f));
+	}
+
+	// Widen the spacing to the item's footprint if its mesh is already loaded, so neighbours never overlap
+	float Spacing = ItemPlacementSpacing;
+	if (const FInventoryItemStruct* ItemRow = ItemDataToPlace.ItemID.DataTable ? ItemDataToPlace.ItemID.DataTable->FindRow<FInventoryItemStruct>(ItemDataToPlace.ItemID.RowName, TEXT("PlaceItemsOnTable")) : nullptr)
+	{
+		if (const UStaticMesh* ItemMesh = ItemRow->Mesh.Get())
+		{
+			const FBoxSphereBounds MeshBounds = ItemMesh->GetBounds();
+			Spacing = FMath::Max(Spacing, 2.f * FMath::Max(MeshBounds.BoxExtent.X, MeshBounds.BoxExtent.Y));
+		}
+	}
+
+	// 6. Compute all placement offsets in one pass, in the spawn point's local X/Y plane
+	TArray<FVector, TInlineAllocator<16>> LocalOffsets;
+	LocalOffsets.Reserve(NumToPlace);
+
+	switch (Layout)
+	{
+	case EWarriorItemPlacementLayout::Row:
+		for (int32 Index = 0; Index < NumToPlace; ++Index)
+		{
+			LocalOffsets.Add(FVector(0.f, (Index - (NumToPlace - 1) * 0.5f) * Spacing, 0.f));
+		}
+		break;
+
+	case EWarriorItemPlacementLayout::Circle:
+		if (NumToPlace == 1)
+		{
+			LocalOffsets.Add(FVector::ZeroVector);
+			break;
+		}
+		{
+			// Radius at which neighbouring items on the ring are exactly Spacing apart
+			const float Radius = NumToPlace == 2 ? Spacing * 0.5f : Spacing / (2.f * FMath::Sin(PI / NumToPlace));
+			for (int32 Index = 0; Index < NumToPlace; ++Index)
+			{
+				float Sin, Cos;
+				FMath::SinCos(&Sin, &Cos, 2.f * PI * Index / NumToPlace);
+				LocalOffsets.Add(FVector(Cos * Radius, Sin * Radius, 0.f));
+			}
+		}
+		break;
+
+	case EWarriorItemPlacementLayout::Grid:
+	default:
+		{
+			const int32 NumColumns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumToPlace)));
+			const int32 NumRows = FMath::DivideAndRoundUp(NumToPlace, NumColumns);
+			for (int32 Index = 0; Index < NumToPlace; ++Index)
+			{
+				const int32 Row = Index / NumColumns;
+				const int32 Column = Index % NumColumns;
+				LocalOffsets.Add(FVector((Row - (NumRows - 1) * 0.5f) * Spacing, (Column - (NumColumns - 1) * 0.5f) * Spacing, 0.f));
+			}
+		}
+		break;
+	}
+
+	// 7. Spawn deferred so the item data is in place before construction: one DataTable lookup and one mesh build per actor
+	FSlotStruct SpawnedItemData = ItemDataToPlace;
+	SpawnedItemData.Quantity = 1;
+
+	int32 NumSpawned = 0;
+	for (const FVector& LocalOffset : LocalOffsets)
+	{
+		const FTransform SpawnTransform(SpawnPointTransform.GetRotation(), SpawnPointTransform.TransformPositionNoScale(LocalOffset));
+
+		AInventoryItemActor* PlacedActor = GetWorld()->SpawnActorDeferred<AInventoryItemActor>(DefaultItemActorClass, SpawnTransform, this, GetInstigator(), ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!PlacedActor)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[PlaceItemsOnTable] Failed to spawn Item Actor of class %s on table."), *DefaultItemActorClass->GetName());
+			continue;
+		}
+
+		PlacedActor->SetItemDataForDeferredSpawn(SpawnedItemData);
+		PlacedActor->FinishSpawning(SpawnTransform);
+		++NumSpawned;
 	}
+
+	UE_LOG(LogTemp, Log, TEXT("[PlaceItemsOnTable] Spawned %d/%d '%s' actor(s) on table %s."), NumSpawned, NumToPlace, *ItemDataToPlace.ItemID.RowName.ToString(), *CurrentInteractableTable->GetName());
+
+	return NumSpawned;
 }
 
 #pragma region Components Getters
@@ -922,5 +1065,7 @@ void AWarriorHeroCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
     //    UE_LOG(LogTemp, Log, TEXT("AWarriorHeroCharacter::EndPlay: Condition for saving inventory not met. Reason: %s"), *UEnum::GetValueAsString(EndPlayReason));
     // }
 
+	HideInteractPrompt();
+
 	Super::EndPlay(EndPlayReason);
 }
@@ -7,22 +7,22 @@
 #include "WarriorFunctionLibrary.h"
 #include "Characters/WarriorEnemyCharacter.h"
 #include "Components/BoxComponent.h"
+#include "Subsystems/WarriorCombatTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
 void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 {
-	if (OverlappedActors.Contains(HitActor))
+	const FWarriorSwingHitRecord* HitRecord = RegisterSwingHit(HitActor);
+	if (!HitRecord)
 	{
 		return;
 	}
 
-	OverlappedActors.AddUnique(HitActor);
-
 	bool bIsValidBlock = false;
 
-	const bool bIsPlayerBlocking = UWarriorFunctionLibrary::NativeDoesActorHaveTag(HitActor, WarriorGameplayTags::Player_Status_Blocking);
-	const bool bIsMyAttackUnblockable = UWarriorFunctionLibrary::NativeDoesActorHaveTag(GetOwningPawn(), WarriorGameplayTags::Enemy_Status_UnBlockable);
+	const bool bIsPlayerBlocking = UWarriorFunctionLibrary::NativeDoesActorHaveStatus(HitActor, EWarriorStatusFlags::Blocking);
+	const bool bIsMyAttackUnblockable = UWarriorFunctionLibrary::NativeDoesActorHaveStatus(GetOwningPawn(), EWarriorStatusFlags::Unblockable);
 
 	if (bIsPlayerBlocking && !bIsMyAttackUnblockable)
 	{
@@ -32,9 +32,12 @@ void UEnemyCombatComponent::OnHitTargetActor(AActor* HitActor)
 	FGameplayEventData EventData;
 	EventData.Instigator = GetOwningPawn();
 	EventData.Target = HitActor;
+	EventData.TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromHitResult(HitRecord->ToHitResult());
 
 	if (bIsValidBlock)
 	{
+		UWarriorCombatTelemetrySubsystem::RecordBlockedHit(GetOwningPawn(), HitActor);
+
 		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
 			HitActor,
 			WarriorGameplayTags::Player_Event_SuccessfulBlock,
@@ -62,6 +65,29 @@ void UEnemyCombatComponent::ToggleBodyCollisionBoxCollision(bool bShouldEnable,
 
 	check(LeftHandCollisionBox && RightHandCollisionBox);
 
+	if (BodyMeleeTraceSettings.bUseSweptTrace)
+	{
+		UBoxComponent* HandCollisionBox = ToggleDamageType == EToggleDamageType::LeftHand ? LeftHandCollisionBox : RightHandCollisionBox;
+
+		if (bShouldEnable)
+		{
+			FVector LocalStart;
+			FVector LocalEnd;
+			FWarriorMeleeTraceSettings::GetBoxTraceSegment(HandCollisionBox->GetUnscaledBoxExtent(), LocalStart, LocalEnd);
+
+			BeginMeleeTrace(HandCollisionBox, BodyMeleeTraceSettings, LocalStart, LocalEnd);
+		}
+		else
+		{
+			EndMeleeTrace(HandCollisionBox);
+			NotifyMeleeTracePulledFromTargets();
+
+			SwingHitRegistry.BeginSwing();
+		}
+
+		return;
+	}
+
 	switch (ToggleDamageType)
 	{
 	case EToggleDamageType::LeftHand:
@@ -77,6 +103,6 @@ void UEnemyCombatComponent::ToggleBodyCollisionBoxCollision(bool bShouldEnable,
 
 	if (!bShouldEnable)
 	{
-		OverlappedActors.Empty();
+		SwingHitRegistry.BeginSwing();
 	}
 }
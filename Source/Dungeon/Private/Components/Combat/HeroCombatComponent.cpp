@@ -5,6 +5,7 @@
 #include "Items/Weapons/WarriorHeroWeapon.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "WarriorGameplayTags.h"
+#include "Subsystems/WarriorHitPauseSubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -25,16 +26,16 @@ float UHeroCombatComponent::GetHeroCurrentEquippedWeaponDamageAtLevel(float InLe
 
 void UHeroCombatComponent::OnHitTargetActor(AActor* HitActor)
 {
-    if (OverlappedActors.Contains(HitActor))
+    const FWarriorSwingHitRecord* HitRecord = RegisterSwingHit(HitActor);
+    if (!HitRecord)
     {
         return;
     }
-
-    OverlappedActors.AddUnique(HitActor);
     
     FGameplayEventData Data;
     Data.Instigator = GetOwningPawn();
     Data.Target = HitActor;
+    Data.TargetData = UAbilitySystemBlueprintLibrary::AbilityTargetDataFromHitResult(HitRecord->ToHitResult());
 
     UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
         GetOwningPawn(),
@@ -42,15 +43,25 @@ void UHeroCombatComponent::OnHitTargetActor(AActor* HitActor)
         Data
     );
 
-    UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-        GetOwningPawn(),
-        WarriorGameplayTags::Player_Event_HitPause,
-        FGameplayEventData()
-    );
+    RequestHitPause(HitActor, HitPauseIntensity);
 }
 
 void UHeroCombatComponent::OnWeaponPulledFromTargetActor(AActor* InteractedActor)
 {
+    RequestHitPause(InteractedActor, PullOutHitPauseIntensity);
+}
+
+void UHeroCombatComponent::RequestHitPause(AActor* InTargetActor, float InIntensity)
+{
+    if (bUseHitPauseSubsystem)
+    {
+        if (UWarriorHitPauseSubsystem* HitPauseSubsystem = UWarriorHitPauseSubsystem::Get(this))
+        {
+            HitPauseSubsystem->RequestHitPause(GetOwningPawn(), InTargetActor, InIntensity);
+            return;
+        }
+    }
+
     UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
         GetOwningPawn(),
         WarriorGameplayTags::Player_Event_HitPause,
@@ -4,9 +4,46 @@
 #include "Components/Combat/PawnCombatComponent.h"
 #include "Items/Weapons/WarriorWeaponBase.h"
 #include "Components/BoxComponent.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorStats.h"
 
 #include "WarriorDebugHelper.h"
 
+DECLARE_CYCLE_STAT(TEXT("Melee Trace"), STAT_WarriorMeleeTrace, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Trace Sweeps"), STAT_WarriorMeleeTraceSweeps, STATGROUP_Warrior);
+
+UPawnCombatComponent::UPawnCombatComponent()
+{
+	// Only ticks while a swept melee trace is active. Runs after animation so the sampled pose is final for the frame.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UPawnCombatComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorMeleeTrace);
+
+	// Hits are handled once every trace has swept, hit reactions can begin or end traces
+	FMeleeTraceHitArray FrameHits;
+
+	for (FActiveMeleeTrace& ActiveTrace : ActiveMeleeTraces)
+	{
+		TickMeleeTrace(ActiveTrace, DeltaTime, FrameHits);
+	}
+
+	for (const FHitResult& HitResult : FrameHits)
+	{
+		AActor* HitActor = HitResult.GetActor();
+		if (HitActor && !SwingHitRegistry.HasHit(HitActor))
+		{
+			HandleMeleeTraceHit(HitResult);
+		}
+	}
+}
+
 void UPawnCombatComponent::RegisterSpawnedWeapon(FGameplayTag InWeaponTagToRegister, AWarriorWeaponBase* InWeaponToRegister, bool bRegisterAsEquippedWeapon)
 {
 	checkf(!CharacterCarriedWeaponMap.Contains(InWeaponTagToRegister), TEXT("A named named %s has already been added as carried weapon"), *InWeaponTagToRegister.ToString());
@@ -66,12 +103,54 @@ void UPawnCombatComponent::OnWeaponPulledFromTargetActor(AActor* InteractedActor
 {
 }
 
+bool UPawnCombatComponent::GetSwingHitRecord(AActor* InHitActor, FWarriorSwingHitRecord& OutHitRecord) const
+{
+	if (const FWarriorSwingHitRecord* FoundRecord = SwingHitRegistry.FindHit(InHitActor))
+	{
+		OutHitRecord = *FoundRecord;
+		return true;
+	}
+
+	return false;
+}
+
+const FWarriorSwingHitRecord* UPawnCombatComponent::RegisterSwingHit(AActor* HitActor)
+{
+	if (!HitActor)
+	{
+		return nullptr;
+	}
+
+	return SwingHitRegistry.RegisterHit(HitActor, GetOwner(), GetWorld()->GetTimeSeconds(), PendingTraceHitResult);
+}
+
 void UPawnCombatComponent::ToggleCurrentEquippedWeaponCollision(bool bShouldEnable)
 {
 	AWarriorWeaponBase* WeaponToToggle = GetCharacterCurrentEquippedWeapon();
 
 	check(WeaponToToggle);
 
+	if (WeaponToToggle->GetMeleeTraceSettings().bUseSweptTrace)
+	{
+		FVector LocalStart;
+		FVector LocalEnd;
+		UPrimitiveComponent* TraceComponent = WeaponToToggle->GetMeleeTraceSegment(LocalStart, LocalEnd);
+
+		if (bShouldEnable)
+		{
+			BeginMeleeTrace(TraceComponent, WeaponToToggle->GetMeleeTraceSettings(), LocalStart, LocalEnd);
+		}
+		else
+		{
+			EndMeleeTrace(TraceComponent);
+			NotifyMeleeTracePulledFromTargets();
+
+			SwingHitRegistry.BeginSwing();
+		}
+
+		return;
+	}
+
 	if (bShouldEnable)
 	{
 		WeaponToToggle->GetWeaponCollisionBox()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
@@ -80,7 +159,7 @@ void UPawnCombatComponent::ToggleCurrentEquippedWeaponCollision(bool bShouldEnab
 	{
 		WeaponToToggle->GetWeaponCollisionBox()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-		OverlappedActors.Empty();
+		SwingHitRegistry.BeginSwing();
 	}
 }
 
@@ -88,4 +167,136 @@ void UPawnCombatComponent::ToggleBodyCollisionBoxCollision(bool bShouldEnable, E
 {
 }
 
+void UPawnCombatComponent::BeginMeleeTrace(UPrimitiveComponent* InTraceComponent, const FWarriorMeleeTraceSettings& InSettings, const FVector& InLocalStart, const FVector& InLocalEnd)
+{
+	check(InTraceComponent);
+
+	EndMeleeTrace(InTraceComponent);
+
+	FActiveMeleeTrace& NewTrace = ActiveMeleeTraces.AddDefaulted_GetRef();
+	NewTrace.TraceComponent = InTraceComponent;
+	NewTrace.Settings = InSettings;
+	NewTrace.LocalStart = InLocalStart;
+	NewTrace.LocalEnd = InLocalEnd;
+	NewTrace.PreviousTransform = InTraceComponent->GetComponentTransform();
+
+	SetComponentTickEnabled(true);
+}
+
+void UPawnCombatComponent::EndMeleeTrace(UPrimitiveComponent* InTraceComponent)
+{
+	ActiveMeleeTraces.RemoveAllSwap([InTraceComponent](const FActiveMeleeTrace& ActiveTrace)
+		{
+			return !ActiveTrace.TraceComponent.IsValid() || ActiveTrace.TraceComponent.Get() == InTraceComponent;
+		}
+	);
 
+	if (ActiveMeleeTraces.IsEmpty())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UPawnCombatComponent::NotifyMeleeTracePulledFromTargets()
+{
+	// Copy first, the notifications may start a new swing
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<16>> HitActors;
+	for (const FWarriorSwingHitRecord& HitRecord : SwingHitRegistry.GetHits())
+	{
+		HitActors.Add(HitRecord.HitActor);
+	}
+
+	for (const TWeakObjectPtr<AActor>& HitActor : HitActors)
+	{
+		if (HitActor.IsValid())
+		{
+			OnWeaponPulledFromTargetActor(HitActor.Get());
+		}
+	}
+}
+
+void UPawnCombatComponent::TickMeleeTrace(FActiveMeleeTrace& InOutTrace, float DeltaTime, FMeleeTraceHitArray& InOutHits)
+{
+	UPrimitiveComponent* TraceComponent = InOutTrace.TraceComponent.Get();
+	if (!TraceComponent)
+	{
+		return;
+	}
+
+	const FWarriorMeleeTraceSettings& Settings = InOutTrace.Settings;
+	const FTransform CurrentTransform = TraceComponent->GetComponentTransform();
+
+	// Long frames are split into substeps so the hit window does not depend on frame rate
+	const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt(DeltaTime / FMath::Max(Settings.SubstepInterval, UE_KINDA_SMALL_NUMBER)), 1, FMath::Max(Settings.MaxSubsteps, 1));
+	const int32 NumSamplePoints = FMath::Max(Settings.NumSamplePoints, 2);
+
+	// Build every sweep segment for this frame first. Interpolating the whole transform keeps the samples on the swing arc
+	// instead of cutting straight across it between frames.
+	TArray<TPair<FVector, FVector>, TInlineAllocator<32>> SweepSegments;
+	SweepSegments.Reserve(NumSubsteps * NumSamplePoints);
+
+	FTransform PreviousSubstepTransform = InOutTrace.PreviousTransform;
+
+	for (int32 SubstepIndex = 1; SubstepIndex <= NumSubsteps; ++SubstepIndex)
+	{
+		FTransform SubstepTransform;
+		SubstepTransform.Blend(InOutTrace.PreviousTransform, CurrentTransform, static_cast<float>(SubstepIndex) / NumSubsteps);
+
+		for (int32 PointIndex = 0; PointIndex < NumSamplePoints; ++PointIndex)
+		{
+			const FVector LocalPoint = FMath::Lerp(InOutTrace.LocalStart, InOutTrace.LocalEnd, static_cast<float>(PointIndex) / (NumSamplePoints - 1));
+
+			SweepSegments.Emplace(PreviousSubstepTransform.TransformPosition(LocalPoint), SubstepTransform.TransformPosition(LocalPoint));
+		}
+
+		PreviousSubstepTransform = SubstepTransform;
+	}
+
+	InOutTrace.PreviousTransform = CurrentTransform;
+
+	// Then issue them in one pass with shared query params. Actors already hit this swing or this frame are ignored.
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WarriorMeleeTrace), false, GetOwner());
+	QueryParams.AddIgnoredActor(TraceComponent->GetOwner());
+	for (const FWarriorSwingHitRecord& HitRecord : SwingHitRegistry.GetHits())
+	{
+		QueryParams.AddIgnoredActor(HitRecord.HitActor.Get());
+	}
+	for (const FHitResult& FrameHit : InOutHits)
+	{
+		QueryParams.AddIgnoredActor(FrameHit.GetActor());
+	}
+
+	const FCollisionObjectQueryParams ObjectQueryParams(Settings.TraceObjectType.GetValue());
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(Settings.TraceRadius);
+
+	TArray<FHitResult> HitResults;
+
+	for (const TPair<FVector, FVector>& SweepSegment : SweepSegments)
+	{
+		HitResults.Reset();
+		GetWorld()->SweepMultiByObjectType(HitResults, SweepSegment.Key, SweepSegment.Value, FQuat::Identity, ObjectQueryParams, SweepShape, QueryParams);
+
+		for (const FHitResult& HitResult : HitResults)
+		{
+			AActor* HitActor = HitResult.GetActor();
+			if (HitActor && !SwingHitRegistry.HasHit(HitActor))
+			{
+				InOutHits.Add(HitResult);
+				QueryParams.AddIgnoredActor(HitActor);
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_WarriorMeleeTraceSweeps, SweepSegments.Num());
+}
+
+void UPawnCombatComponent::HandleMeleeTraceHit(const FHitResult& InHitResult)
+{
+	// Same filter as the weapon overlap path
+	APawn* HitPawn = Cast<APawn>(InHitResult.GetActor());
+	if (HitPawn && UWarriorFunctionLibrary::IsTargetPawnHostile(GetOwningPawn(), HitPawn))
+	{
+		TGuardValue<const FHitResult*> HitResultGuard(PendingTraceHitResult, &InHitResult);
+		OnHitTargetActor(HitPawn);
+	}
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/Combat/WarriorSwingHitRegistry.h"
+#include "GameFramework/Actor.h"
+
+void FWarriorSwingHitRegistry::BeginSwing()
+{
+	++Generation;
+	SwingHits.Reset();
+
+	if (HitSlots.Num() > MaxStaleEntries)
+	{
+		HitSlots.Reset();
+	}
+}
+
+const FWarriorSwingHitRecord* FWarriorSwingHitRegistry::FindHit(const AActor* InActor) const
+{
+	const FHitSlot* HitSlot = HitSlots.Find(InActor);
+
+	return HitSlot && HitSlot->Generation == Generation ? &SwingHits[HitSlot->HitIndex] : nullptr;
+}
+
+const FWarriorSwingHitRecord* FWarriorSwingHitRegistry::RegisterHit(AActor* InActor, const AActor* InInstigator, double InHitTime, const FHitResult* InHitResult)
+{
+	check(InActor);
+
+	FHitSlot& HitSlot = HitSlots.FindOrAdd(InActor);
+	if (HitSlot.Generation == Generation)
+	{
+		return nullptr;
+	}
+
+	HitSlot.Generation = Generation;
+	HitSlot.HitIndex = SwingHits.Num();
+
+	FWarriorSwingHitRecord& HitRecord = SwingHits.AddDefaulted_GetRef();
+	HitRecord.HitActor = InActor;
+	HitRecord.HitTime = InHitTime;
+
+	if (InHitResult)
+	{
+		HitRecord.BoneName = InHitResult->BoneName;
+		HitRecord.ImpactPoint = InHitResult->ImpactPoint;
+		HitRecord.ImpactNormal = InHitResult->ImpactNormal;
+	}
+	else
+	{
+		// Overlap events carry no contact data, the target's location is the best estimate
+		HitRecord.ImpactPoint = InActor->GetActorLocation();
+	}
+
+	if (InInstigator)
+	{
+		HitRecord.HitDirection = (InActor->GetActorLocation() - InInstigator->GetActorLocation()).GetSafeNormal2D();
+
+		if (!InHitResult)
+		{
+			HitRecord.ImpactNormal = -HitRecord.HitDirection;
+		}
+	}
+
+	return &HitRecord;
+}
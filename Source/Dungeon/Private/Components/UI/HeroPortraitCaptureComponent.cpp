@@ -0,0 +1,198 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/UI/HeroPortraitCaptureComponent.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Image.h"
+#include "GameFramework/Character.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Portrait Capture"), STAT_WarriorPortraitCapture, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Portrait Captures Rendered"), STAT_WarriorPortraitCapturesRendered, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Portrait Captures Skipped"), STAT_WarriorPortraitCapturesSkipped, STATGROUP_Warrior);
+
+UHeroPortraitCaptureComponent::UHeroPortraitCaptureComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UHeroPortraitCaptureComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	PrimaryComponentTick.TickInterval = 1.f / FMath::Max(CaptureRate, 1.f);
+
+	if (!SceneCapture)
+	{
+		SetSceneCapture(GetOwner()->FindComponentByClass<USceneCaptureComponent2D>());
+	}
+}
+
+void UHeroPortraitCaptureComponent::SetSceneCapture(USceneCaptureComponent2D* InSceneCapture)
+{
+	SceneCapture = InSceneCapture;
+
+	if (!SceneCapture)
+	{
+		return;
+	}
+
+	// This component decides when to render, the capture itself never renders on its own
+	SceneCapture->bCaptureEveryFrame = false;
+	SceneCapture->bCaptureOnMovement = false;
+
+	UTextureRenderTarget2D* RenderTarget = SceneCapture->TextureTarget;
+
+	if (RenderTarget && RenderTarget != PortraitRenderTarget && CaptureResolution.X > 0 && CaptureResolution.Y > 0 && (RenderTarget->SizeX != CaptureResolution.X || RenderTarget->SizeY != CaptureResolution.Y))
+	{
+		// The authored render target is a shared asset, so the resized copy lives only as long as this component
+		AuthoredRenderTarget = RenderTarget;
+
+		PortraitRenderTarget = NewObject<UTextureRenderTarget2D>(this, NAME_None, RF_Transient);
+		PortraitRenderTarget->RenderTargetFormat = RenderTarget->RenderTargetFormat;
+		PortraitRenderTarget->ClearColor = RenderTarget->ClearColor;
+		PortraitRenderTarget->bAutoGenerateMips = false;
+		PortraitRenderTarget->InitAutoFormat(CaptureResolution.X, CaptureResolution.Y);
+		PortraitRenderTarget->UpdateResourceImmediate(true);
+
+		SceneCapture->TextureTarget = PortraitRenderTarget;
+	}
+	else if (!PortraitRenderTarget)
+	{
+		PortraitRenderTarget = RenderTarget;
+	}
+
+	bForceNextCapture = true;
+}
+
+void UHeroPortraitCaptureComponent::AddCaptureConsumer(UUserWidget* InConsumer)
+{
+	if (!InConsumer)
+	{
+		return;
+	}
+
+	CaptureConsumers.AddUnique(InConsumer);
+
+	RedirectConsumerImages(InConsumer);
+
+	// The widget has just been shown, so whatever is in the render target is stale
+	bForceNextCapture = true;
+	UpdateTickEnabled();
+}
+
+void UHeroPortraitCaptureComponent::RemoveCaptureConsumer(UUserWidget* InConsumer)
+{
+	CaptureConsumers.Remove(InConsumer);
+	UpdateTickEnabled();
+}
+
+void UHeroPortraitCaptureComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!SceneCapture || !HasVisibleConsumer())
+	{
+		UpdateTickEnabled();
+		return;
+	}
+
+	const uint32 PoseHash = bSkipUnchangedPose ? ComputePoseHash() : 0;
+
+	if (bSkipUnchangedPose && !bForceNextCapture && PoseHash == LastCapturedPoseHash)
+	{
+		INC_DWORD_STAT(STAT_WarriorPortraitCapturesSkipped);
+		return;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_WarriorPortraitCapture);
+		SceneCapture->CaptureScene();
+	}
+	INC_DWORD_STAT(STAT_WarriorPortraitCapturesRendered);
+
+	LastCapturedPoseHash = PoseHash;
+	bForceNextCapture = false;
+}
+
+bool UHeroPortraitCaptureComponent::HasVisibleConsumer()
+{
+	bool bAnyVisible = false;
+
+	for (int32 Index = CaptureConsumers.Num() - 1; Index >= 0; --Index)
+	{
+		const UUserWidget* Consumer = CaptureConsumers[Index].Get();
+		if (!Consumer)
+		{
+			CaptureConsumers.RemoveAtSwap(Index);
+			continue;
+		}
+
+		bAnyVisible |= Consumer->IsInViewport() && Consumer->IsVisible();
+	}
+
+	return bAnyVisible;
+}
+
+uint32 UHeroPortraitCaptureComponent::ComputePoseHash() const
+{
+	uint32 Hash = 0;
+
+	const ACharacter* OwningCharacter = Cast<ACharacter>(GetOwner());
+	if (const USkeletalMeshComponent* Mesh = OwningCharacter ? OwningCharacter->GetMesh() : nullptr)
+	{
+		// Hashed per component, FTransform's memory includes padding that is not guaranteed to be stable
+		for (const FTransform& BoneTransform : Mesh->GetComponentSpaceTransforms())
+		{
+			const FVector Translation = BoneTransform.GetTranslation();
+			const FQuat Rotation = BoneTransform.GetRotation();
+			const FVector Scale = BoneTransform.GetScale3D();
+
+			const FVector::FReal Components[] = { Translation.X, Translation.Y, Translation.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W, Scale.X, Scale.Y, Scale.Z };
+			Hash = FCrc::MemCrc32(Components, sizeof(Components), Hash);
+		}
+
+		Hash = HashCombine(Hash, GetTypeHash(Mesh->GetSkeletalMeshAsset()));
+	}
+
+	// Equipped weapons are attached actors, so equip/unequip changes the hash as well
+	TArray<AActor*> AttachedActors;
+	GetOwner()->GetAttachedActors(AttachedActors);
+	for (const AActor* AttachedActor : AttachedActors)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(AttachedActor));
+		Hash = HashCombine(Hash, GetTypeHash(AttachedActor->IsHidden()));
+	}
+
+	return Hash;
+}
+
+void UHeroPortraitCaptureComponent::RedirectConsumerImages(UUserWidget* InConsumer) const
+{
+	if (!AuthoredRenderTarget || !PortraitRenderTarget || !InConsumer->WidgetTree)
+	{
+		return;
+	}
+
+	// Images that show the authored asset directly are pointed at the resized copy. Materials that sample the asset
+	// have to read GetPortraitRenderTarget() instead.
+	InConsumer->WidgetTree->ForEachWidget([this](UWidget* Widget)
+		{
+			UImage* Image = Cast<UImage>(Widget);
+
+			if (Image && Image->GetBrush().GetResourceObject() == AuthoredRenderTarget)
+			{
+				Image->SetBrushResourceObject(PortraitRenderTarget);
+			}
+		});
+}
+
+void UHeroPortraitCaptureComponent::UpdateTickEnabled()
+{
+	SetComponentTickEnabled(SceneCapture && HasVisibleConsumer());
+}
@@ -6,6 +6,13 @@
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
+#include "BrainComponent.h"
+#include "Perception/AISense_Sight.h"
+#include "Subsystems/WarriorPerceptionSubsystem.h"
+#include "Subsystems/WarriorCrowdDensitySubsystem.h"
+#include "AI/WarriorBehaviorTreeComponent.h"
+#include "Subsystems/WarriorPathSharingSubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -25,6 +32,9 @@ AWarriorAIController::AWarriorAIController(const FObjectInitializer& ObjectIniti
 	EnemyPerceptionComponent->SetDominantSense(UAISenseConfig_Sight::StaticClass());
 	EnemyPerceptionComponent->OnTargetPerceptionUpdated.AddUniqueDynamic(this, &ThisClass::OnEnemyPerceptionUpdated);
 
+	// RunBehaviorTree reuses an existing behaviour tree brain, so trees run on the profiled component
+	BrainComponent = CreateDefaultSubobject<UWarriorBehaviorTreeComponent>("BTComponent");
+
 	SetGenericTeamId(FGenericTeamId(1));
 }
 
@@ -42,6 +52,33 @@ ETeamAttitude::Type AWarriorAIController::GetTeamAttitudeTowards(const AActor& O
 	return ETeamAttitude::Friendly;
 }
 
+void AWarriorAIController::FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const
+{
+	UWarriorPathSharingSubsystem* PathSharingSubsystem = UWarriorPathSharingSubsystem::IsEnabled() ? GetWorld()->GetSubsystem<UWarriorPathSharingSubsystem>() : nullptr;
+
+	if (!PathSharingSubsystem)
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+		return;
+	}
+
+	if (PathSharingSubsystem->FindSharedPath(Query, OutPath))
+	{
+		// Same as Super does for a searched path
+		OutPath->EnableRecalculationOnInvalidation(true);
+	}
+	else
+	{
+		Super::FindPathForMoveRequest(MoveRequest, Query, OutPath);
+		PathSharingSubsystem->AddSearchedPath(Query, OutPath);
+	}
+
+	if (OutPath.IsValid() && MoveRequest.IsMoveToActorRequest() && MoveRequest.GetGoalActor())
+	{
+		OutPath->SetGoalActorObservation(*MoveRequest.GetGoalActor(), PathSharingSubsystem->GetGoalRepathTolerance(*OutPath));
+	}
+}
+
 void AWarriorAIController::BeginPlay()
 {
 	Super::BeginPlay();
@@ -50,33 +87,219 @@ void AWarriorAIController::BeginPlay()
 	{
 		CrowdComp->SetCrowdSimulationState(bEnableDetourCrowdAvoidance ? ECrowdSimulationState::Enabled : ECrowdSimulationState::Disabled);
 		
-		switch (DetourCrowdAvoidanceQuality)
-		{
-		case 1: CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Low);    break;
-		case 2: CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Medium); break;
-		case 3: CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::Good);   break;
-		case 4: CrowdComp->SetCrowdAvoidanceQuality(ECrowdAvoidanceQuality::High);   break;
-		default:
-			break;
-		}
+		AppliedCrowdAvoidanceQuality = GetConfiguredCrowdAvoidanceQuality();
+		CrowdComp->SetCrowdAvoidanceQuality(AppliedCrowdAvoidanceQuality);
 
+		// Matches what ApplyCrowdDensitySettings pushes for enemies outside the melee ring
 		CrowdComp->SetAvoidanceGroup(1);
-		CrowdComp->SetGroupsToAvoid(1);
+		CrowdComp->SetGroupsToAvoid(1 | 2);
 		CrowdComp->SetCrowdCollisionQueryRange(CollisionQueryRange);
+		AppliedCollisionQueryRange = CollisionQueryRange;
+
+		if (bEnableDetourCrowdAvoidance)
+		{
+			if (UWarriorCrowdDensitySubsystem* CrowdDensitySubsystem = UWarriorCrowdDensitySubsystem::Get(this))
+			{
+				CrowdDensitySubsystem->RegisterAgent(this);
+			}
+		}
 	}
 
+	if (bUseSharedPerception)
+	{
+		if (UWarriorPerceptionSubsystem* PerceptionSubsystem = UWarriorPerceptionSubsystem::Get(this))
+		{
+			// The listener stays registered for other senses, but no longer traces toward sight stimuli
+			EnemyPerceptionComponent->SetSenseEnabled(UAISense_Sight::StaticClass(), false);
+
+			PerceptionSubsystem->RegisterController(this);
+		}
+	}
+}
+
+void AWarriorAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWarriorPerceptionSubsystem* PerceptionSubsystem = GetWorld()->GetSubsystem<UWarriorPerceptionSubsystem>())
+	{
+		PerceptionSubsystem->UnregisterController(this);
+	}
+
+	if (UWarriorCrowdDensitySubsystem* CrowdDensitySubsystem = GetWorld()->GetSubsystem<UWarriorCrowdDensitySubsystem>())
+	{
+		CrowdDensitySubsystem->UnregisterAgent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+ECrowdAvoidanceQuality::Type AWarriorAIController::GetConfiguredCrowdAvoidanceQuality() const
+{
+	switch (DetourCrowdAvoidanceQuality)
+	{
+	case 1: return ECrowdAvoidanceQuality::Low;
+	case 2: return ECrowdAvoidanceQuality::Medium;
+	case 3: return ECrowdAvoidanceQuality::Good;
+	default:
+		return ECrowdAvoidanceQuality::High;
+	}
+}
+
+void AWarriorAIController::SetCrowdAvoidanceQualityLimit(ECrowdAvoidanceQuality::Type InMaxQuality)
+{
+	SignificanceQualityLimit = InMaxQuality;
+
+	UpdateCrowdAvoidanceQuality();
+}
+
+void AWarriorAIController::ApplyCrowdDensitySettings(ECrowdAvoidanceQuality::Type InMaxQuality, float InMaxQueryRange, bool bInMeleeRing)
+{
+	DensityQualityLimit = InMaxQuality;
+
+	UpdateCrowdAvoidanceQuality();
+
+	UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent());
+
+	if (!CrowdComp)
+	{
+		return;
+	}
+
+	const float NewQueryRange = FMath::Min(CollisionQueryRange, InMaxQueryRange);
+
+	if (NewQueryRange != AppliedCollisionQueryRange)
+	{
+		AppliedCollisionQueryRange = NewQueryRange;
+		CrowdComp->SetCrowdCollisionQueryRange(NewQueryRange);
+	}
+
+	if (bInMeleeRing != bAppliedMeleeRingGroups)
+	{
+		bAppliedMeleeRingGroups = bInMeleeRing;
+
+		// Ring members hold their own slots and only steer around each other; approaching enemies still avoid the ring
+		CrowdComp->SetAvoidanceGroup(bInMeleeRing ? 2 : 1);
+		CrowdComp->SetGroupsToAvoid(bInMeleeRing ? 2 : (1 | 2));
+	}
+}
+
+void AWarriorAIController::UpdateCrowdAvoidanceQuality()
+{
+	const int32 MaxQuality = FMath::Min<int32>(SignificanceQualityLimit, DensityQualityLimit);
+	const ECrowdAvoidanceQuality::Type NewQuality = static_cast<ECrowdAvoidanceQuality::Type>(FMath::Min<int32>(GetConfiguredCrowdAvoidanceQuality(), MaxQuality));
+
+	if (NewQuality == AppliedCrowdAvoidanceQuality)
+	{
+		return;
+	}
+
+	if (UCrowdFollowingComponent* CrowdComp = Cast<UCrowdFollowingComponent>(GetPathFollowingComponent()))
+	{
+		AppliedCrowdAvoidanceQuality = NewQuality;
+		CrowdComp->SetCrowdAvoidanceQuality(NewQuality);
+	}
 }
 
 void AWarriorAIController::OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
+{
+	if (Stimulus.WasSuccessfullySensed())
+	{
+		SetTargetActorIfUnset(Actor);
+	}
+}
+
+void AWarriorAIController::HandleSharedPerceptionSighted(AActor* InActor)
+{
+	SetTargetActorIfUnset(InActor);
+}
+
+bool AWarriorAIController::HasTargetActor() const
+{
+	return GetTargetActor() != nullptr;
+}
+
+AActor* AWarriorAIController::GetTargetActor() const
+{
+	const UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+
+	return BlackboardComponent ? Cast<AActor>(BlackboardComponent->GetValueAsObject(FName("TargetActor"))) : nullptr;
+}
+
+void AWarriorAIController::SetSurroundSlotLocation(const FVector& InSlotLocation)
+{
+	UBlackboardComponent* BlackboardComponent = GetBlackboardComponent();
+
+	if (!BlackboardComponent)
+	{
+		return;
+	}
+
+	// Blackboards without the key drop the value, so there is nothing to clear later
+	const FBlackboard::FKey SlotKeyID = BlackboardComponent->GetKeyID(FName("SurroundSlotLocation"));
+
+	if (SlotKeyID != FBlackboard::InvalidKey && BlackboardComponent->SetValue<UBlackboardKeyType_Vector>(SlotKeyID, InSlotLocation))
+	{
+		bHasSurroundSlot = true;
+	}
+}
+
+void AWarriorAIController::ClearSurroundSlotLocation()
+{
+	if (!bHasSurroundSlot)
+	{
+		return;
+	}
+
+	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
+	{
+		BlackboardComponent->ClearValue(FName("SurroundSlotLocation"));
+	}
+
+	bHasSurroundSlot = false;
+}
+
+void AWarriorAIController::SetTargetActorIfUnset(AActor* InActor)
 {
 	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
 	{
 		if (!BlackboardComponent->GetValueAsObject(FName("TargetActor")))
 		{
-			if (Stimulus.WasSuccessfullySensed() && Actor)
+			if (InActor)
 			{
-				BlackboardComponent->SetValueAsObject(FName("TargetActor"), Actor);
+				BlackboardComponent->SetValueAsObject(FName("TargetActor"), InActor);
 			}
 		}
 	}
 }
+
+void AWarriorAIController::SetPooledLogicPaused(bool bPaused)
+{
+	static const FString PoolPauseReason = TEXT("EnemyPool");
+
+	if (bPaused)
+	{
+		StopMovement();
+
+		// Forget everything so the hero is reported again once this enemy comes back out of the pool
+		EnemyPerceptionComponent->ForgetAll();
+	}
+
+	// Cleared again on the way out, perception can still write a target while the enemy waits in the pool
+	if (UBlackboardComponent* BlackboardComponent = GetBlackboardComponent())
+	{
+		BlackboardComponent->ClearValue(FName("TargetActor"));
+	}
+
+	ClearSurroundSlotLocation();
+
+	if (UBrainComponent* Brain = GetBrainComponent())
+	{
+		if (bPaused)
+		{
+			Brain->PauseLogic(PoolPauseReason);
+		}
+		else
+		{
+			Brain->ResumeLogic(PoolPauseReason);
+		}
+	}
+}
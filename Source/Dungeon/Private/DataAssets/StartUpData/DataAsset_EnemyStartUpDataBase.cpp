@@ -2,24 +2,17 @@
 
 
 #include "DataAssets/StartUpData/DataAsset_EnemyStartUpDataBase.h"
-#include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "AbilitySystem/Abilities/WarriorEnemyGameplayAbility.h"
 
-void UDataAsset_EnemyStartUpDataBase::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+void UDataAsset_EnemyStartUpDataBase::CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const
 {
-	Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
+	Super::CompileAbilitySpecs(ApplyLevel, OutAbilitySpecs);
 
-	if (!EnemyCombatAbilities.IsEmpty())
+	for (const TSubclassOf <UWarriorEnemyGameplayAbility>& AbilityClass : EnemyCombatAbilities)
 	{
-		for (const TSubclassOf <UWarriorEnemyGameplayAbility>& AbilityClass : EnemyCombatAbilities)
-		{
-			if (!AbilityClass) continue;
+		if (!AbilityClass) continue;
 
-			FGameplayAbilitySpec AbilitySpec(AbilityClass);
-			AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
-			AbilitySpec.Level = ApplyLevel;
-
-			InASCToGive->GiveAbility(AbilitySpec);
-		}
+		FGameplayAbilitySpec& AbilitySpec = OutAbilitySpecs.Emplace_GetRef(AbilityClass);
+		AbilitySpec.Level = ApplyLevel;
 	}
 }
@@ -3,21 +3,17 @@
 
 #include "DataAssets/StartUpData/DataAsset_HeroStartUpData.h"
 #include "AbilitySystem/Abilities/WarriorGameplayAbility.h"
-#include "AbilitySystem/WarriorAbilitySystemComponent.h"
 
-void UDataAsset_HeroStartUpData::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+void UDataAsset_HeroStartUpData::CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const
 {
-    Super::GiveToAbilitySystemComponent(InASCToGive, ApplyLevel);
+    Super::CompileAbilitySpecs(ApplyLevel, OutAbilitySpecs);
 
     for (const FWarriorHeroAbilitySet& AbilitySet : HeroStartUpAbilitySets)
     {
         if (!AbilitySet.IsValid()) continue;
 
-        FGameplayAbilitySpec AbilitySpec(AbilitySet.AbilityToGrant);
-        AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
+        FGameplayAbilitySpec& AbilitySpec = OutAbilitySpecs.Emplace_GetRef(AbilitySet.AbilityToGrant);
         AbilitySpec.Level = ApplyLevel;
         AbilitySpec.GetDynamicSpecSourceTags().AddTag(AbilitySet.InputTag);
-
-        InASCToGive->GiveAbility(AbilitySpec);
     }
 }
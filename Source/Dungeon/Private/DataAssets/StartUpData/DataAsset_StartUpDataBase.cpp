@@ -3,33 +3,111 @@
 
 #include "DataAssets/StartUpData/DataAsset_StartUpDataBase.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
+#include "AbilitySystem/WarriorAttributeSet.h"
 #include "AbilitySystem/Abilities/WarriorGameplayAbility.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectComponents/AssetTagsGameplayEffectComponent.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
+#include "UObject/UObjectHash.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("StartUp Data Give"), STAT_WarriorStartUpDataGive, STATGROUP_Warrior);
+DECLARE_CYCLE_STAT(TEXT("StartUp Data Compile"), STAT_WarriorStartUpDataCompile, STATGROUP_Warrior);
 
 void UDataAsset_StartUpDataBase::GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
 {
+	SCOPE_CYCLE_COUNTER(STAT_WarriorStartUpDataGive);
+
 	check(InASCToGive);
 
-	GrantAbilities(ActivateOnGivenAbilities, InASCToGive, ApplyLevel);
-	GrantAbilities(ReactiveAbilities, InASCToGive, ApplyLevel);
+#if WITH_EDITOR
+	// Effects and curve tables can be edited between play sessions without touching this asset, so every session
+	// compiles its own templates
+	const FObjectKey CurrentWorldKey(InASCToGive->GetWorld());
 
-	if (!StartUpGameplayEffects.IsEmpty())
+	if (CompiledForWorld != CurrentWorldKey)
 	{
-		for (const TSubclassOf < UGameplayEffect >& EffectClass : StartUpGameplayEffects)
+		CompiledGrantTemplates.Empty();
+		CompiledForWorld = CurrentWorldKey;
+	}
+#endif
+
+	const FStartUpGrantTemplate& GrantTemplate = GetOrCompileGrantTemplate(ApplyLevel);
+
+	AActor* AvatarActor = InASCToGive->GetAvatarActor();
+
+	for (const FGameplayAbilitySpec& TemplateSpec : GrantTemplate.AbilitySpecs)
+	{
+		FGameplayAbilitySpec AbilitySpec(TemplateSpec);
+		AbilitySpec.Handle.GenerateNewHandle();
+		AbilitySpec.SourceObject = AvatarActor;
+
+		InASCToGive->GiveAbility(AbilitySpec);
+	}
+
+	if (!GrantTemplate.AttributeBaseline.IsEmpty())
+	{
+		UWarriorAttributeSet* AttributeSet = nullptr;
+
+		for (UAttributeSet* SpawnedSet : InASCToGive->GetSpawnedAttributes())
 		{
-			if (!EffectClass) continue;
+			if (UWarriorAttributeSet* WarriorSet = Cast<UWarriorAttributeSet>(SpawnedSet))
+			{
+				AttributeSet = WarriorSet;
+				break;
+			}
+		}
+
+		for (const FStartUpAttributeMod& AttributeMod : GrantTemplate.AttributeBaseline)
+		{
+			const float CurrentBase = InASCToGive->GetNumericAttributeBase(AttributeMod.Attribute);
+			float NewBase = CurrentBase;
+
+			switch (AttributeMod.ModOp)
+			{
+			case EGameplayModOp::Additive:			NewBase = CurrentBase + AttributeMod.Magnitude;	break;
+			case EGameplayModOp::Multiplicitive:	NewBase = CurrentBase * AttributeMod.Magnitude;	break;
+			case EGameplayModOp::Division:			NewBase = FMath::IsNearlyZero(AttributeMod.Magnitude) ? CurrentBase : CurrentBase / AttributeMod.Magnitude;	break;
+			case EGameplayModOp::Override:			NewBase = AttributeMod.Magnitude;	break;
+			default:
+				break;
+			}
 
-			UGameplayEffect* EffectCDO = EffectClass->GetDefaultObject<UGameplayEffect>();
+			InASCToGive->SetNumericAttributeBase(AttributeMod.Attribute, NewBase);
 
-			InASCToGive->ApplyGameplayEffectToSelf(
-				EffectCDO,
-				ApplyLevel,
-				InASCToGive->MakeEffectContext()
-			);
+			if (AttributeSet)
+			{
+				AttributeSet->HandleBaseValueWritten(AvatarActor, AttributeMod.Attribute);
+			}
 		}
 	}
+
+	for (const UGameplayEffect* EffectCDO : GrantTemplate.EffectsToApply)
+	{
+		InASCToGive->ApplyGameplayEffectToSelf(
+			EffectCDO,
+			ApplyLevel,
+			InASCToGive->MakeEffectContext()
+		);
+	}
 }
 
-void UDataAsset_StartUpDataBase::GrantAbilities(const TArray<TSubclassOf<UWarriorGameplayAbility>>& InAbilitiesToGive, UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel)
+#if WITH_EDITOR
+void UDataAsset_StartUpDataBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompiledGrantTemplates.Empty();
+}
+#endif
+
+void UDataAsset_StartUpDataBase::CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const
+{
+	CompileAbilities(ActivateOnGivenAbilities, ApplyLevel, OutAbilitySpecs);
+	CompileAbilities(ReactiveAbilities, ApplyLevel, OutAbilitySpecs);
+}
+
+void UDataAsset_StartUpDataBase::CompileAbilities(const TArray<TSubclassOf<UWarriorGameplayAbility>>& InAbilitiesToGive, int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs)
 {
 	if (InAbilitiesToGive.IsEmpty())
 	{
@@ -40,10 +118,90 @@ void UDataAsset_StartUpDataBase::GrantAbilities(const TArray<TSubclassOf<UWarrio
 	{
 		if (!Ability) continue;
 
-		FGameplayAbilitySpec AbilitySpec(Ability);
-		AbilitySpec.SourceObject = InASCToGive->GetAvatarActor();
+		FGameplayAbilitySpec& AbilitySpec = OutAbilitySpecs.Emplace_GetRef(Ability);
 		AbilitySpec.Level = ApplyLevel;
+	}
+}
 
-		InASCToGive->GiveAbility(AbilitySpec);
+const UDataAsset_StartUpDataBase::FStartUpGrantTemplate& UDataAsset_StartUpDataBase::GetOrCompileGrantTemplate(int32 ApplyLevel)
+{
+	if (const FStartUpGrantTemplate* CompiledTemplate = CompiledGrantTemplates.Find(ApplyLevel))
+	{
+		return *CompiledTemplate;
 	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorStartUpDataCompile);
+
+	FStartUpGrantTemplate& GrantTemplate = CompiledGrantTemplates.Add(ApplyLevel);
+
+	CompileAbilitySpecs(ApplyLevel, GrantTemplate.AbilitySpecs);
+
+	for (const TSubclassOf < UGameplayEffect >& EffectClass : StartUpGameplayEffects)
+	{
+		if (!EffectClass) continue;
+
+		const UGameplayEffect* EffectCDO = EffectClass->GetDefaultObject<UGameplayEffect>();
+
+		// The baseline is written before any effect is applied, so baking stops at the first effect that cannot be
+		// baked. Everything after it is applied in the authored order.
+		if (!GrantTemplate.EffectsToApply.IsEmpty() || !TryBakeStartUpEffect(EffectCDO, ApplyLevel, GrantTemplate.AttributeBaseline))
+		{
+			GrantTemplate.EffectsToApply.Add(EffectCDO);
+		}
+	}
+
+	return GrantTemplate;
+}
+
+bool UDataAsset_StartUpDataBase::TryBakeStartUpEffect(const UGameplayEffect* InEffect, int32 ApplyLevel, TArray<FStartUpAttributeMod>& OutBaseline)
+{
+	// Anything that needs the ability system at apply time (duration, executions, cues, conditional modifiers) is not baked
+	if (InEffect->DurationPolicy != EGameplayEffectDurationType::Instant || !InEffect->Executions.IsEmpty() || !InEffect->GameplayCues.IsEmpty())
+	{
+		return false;
+	}
+
+	// Asset and target tag components change nothing on an instant effect. Any other component (immunity, blocked
+	// abilities, chance to apply, additional effects...) needs the real application.
+	TArray<UObject*> EffectSubobjects;
+	GetObjectsWithOuter(InEffect, EffectSubobjects, false);
+
+	for (const UObject* Subobject : EffectSubobjects)
+	{
+		if (IsValid(Subobject) && Subobject->IsA<UGameplayEffectComponent>() && !Subobject->IsA<UAssetTagsGameplayEffectComponent>() && !Subobject->IsA<UTargetTagsGameplayEffectComponent>())
+		{
+			return false;
+		}
+	}
+
+	TArray<FStartUpAttributeMod, TInlineAllocator<8>> BakedMods;
+
+	for (const FGameplayModifierInfo& Modifier : InEffect->Modifiers)
+	{
+		const bool bSupportedOp =
+			Modifier.ModifierOp == EGameplayModOp::Additive ||
+			Modifier.ModifierOp == EGameplayModOp::Multiplicitive ||
+			Modifier.ModifierOp == EGameplayModOp::Division ||
+			Modifier.ModifierOp == EGameplayModOp::Override;
+
+		// DamageTaken is a meta attribute handled in PostGameplayEffectExecute, so it has to go through the effect
+		if (!bSupportedOp || Modifier.Attribute == UWarriorAttributeSet::GetDamageTakenAttribute() || !Modifier.SourceTags.IsEmpty() || !Modifier.TargetTags.IsEmpty())
+		{
+			return false;
+		}
+
+		FStartUpAttributeMod& BakedMod = BakedMods.AddDefaulted_GetRef();
+		BakedMod.Attribute = Modifier.Attribute;
+		BakedMod.ModOp = Modifier.ModifierOp;
+
+		// Only scalable float magnitudes are static. Attribute based and custom magnitudes are evaluated by the effect.
+		if (!Modifier.ModifierMagnitude.GetStaticMagnitudeIfPossible(ApplyLevel, BakedMod.Magnitude))
+		{
+			return false;
+		}
+	}
+
+	OutBaseline.Append(BakedMods);
+
+	return true;
 }
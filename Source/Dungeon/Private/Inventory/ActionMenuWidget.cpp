@@ -222,7 +222,7 @@ void UActionMenuWidget::OnDropButtonClicked()
 		// IMPORTANT: Set the item data on the spawned actor!
 		DroppedActor->SetItemData(ItemToActOn);
 
-		// Request physics to be enabled on the actor's next tick
+		// Request physics to be enabled next frame (queued on the deferred action subsystem)
 		DroppedActor->RequestEnablePhysics(); 
 
 		// We also need to trigger its OnConstruction manually if the item property was ExposeOnSpawn=false
@@ -17,6 +17,7 @@
 #include "Characters/WarriorHeroCharacter.h" // Needed to get camera component or owner cast
 #include "Inventory/InventoryWidget.h" // Needed for casting InventoryWidgetInstance
 #include "Inventory/ItemInfoWidget.h" // Needed for getting/using ItemInfoWidget
+#include "Components/UI/HeroPortraitCaptureComponent.h"
 // #include "Camera/CameraComponent.h" // No longer needed
 
 // Include necessary headers for casting
@@ -148,6 +149,11 @@ void UInventoryComponent::ToggleInventory()
 	{
 		InventoryWidgetInstance->RemoveFromParent();
 
+		if (UHeroPortraitCaptureComponent* PortraitCapture = GetOwner()->FindComponentByClass<UHeroPortraitCaptureComponent>())
+		{
+			PortraitCapture->RemoveCaptureConsumer(InventoryWidgetInstance);
+		}
+
 		bool bRestoreGameOnlyInput = true;
 		if (AWarriorHeroCharacter* WarriorChar = Cast<AWarriorHeroCharacter>(GetOwner()))
 		{
@@ -182,6 +188,12 @@ void UInventoryComponent::ToggleInventory()
 		}
 
 		InventoryWidgetInstance->AddToViewport();
+
+		// The inventory shows the hero portrait, so the scene capture only needs to run while it is open
+		if (UHeroPortraitCaptureComponent* PortraitCapture = GetOwner()->FindComponentByClass<UHeroPortraitCaptureComponent>())
+		{
+			PortraitCapture->AddCaptureConsumer(InventoryWidgetInstance);
+		}
 		UE_LOG(LogTemp, Log, TEXT("Called AddToViewport for %s. IsInViewport: %s"), *GetOwner()->GetName(), InventoryWidgetInstance->IsInViewport() ? TEXT("True") : TEXT("False"));
 
 		UInventoryWidget* InventoryWidget = Cast<UInventoryWidget>(InventoryWidgetInstance);
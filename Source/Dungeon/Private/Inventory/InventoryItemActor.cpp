@@ -12,12 +12,13 @@
 #include "Inventory/SlotStruct.h"     // For FSlotStruct (Item Property Type)
 #include "Engine/CollisionProfile.h" // Correct include for UCollisionProfile
 #include "PhysicsEngine/BodySetup.h" // Correct path for UBodySetup
+#include "Subsystems/WarriorDeferredActionSubsystem.h"
 
 // Sets default values
 AInventoryItemActor::AInventoryItemActor()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false; // Optimize: Disable tick if not needed
+	PrimaryActorTick.bCanEverTick = false; // Deferred work (e.g. RequestEnablePhysics) goes through UWarriorDeferredActionSubsystem instead
 
 	DefaultSceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRoot"));
 	RootComponent = DefaultSceneRoot;
@@ -59,7 +60,11 @@ void AInventoryItemActor::BeginPlay()
         SetItemData(Item);
     } else if (ItemData) {
          // If ItemData was already set (e.g., in editor or PostActorCreated), ensure mesh reflects it.
-         UpdateMeshFromData();
+         // Skip the rebuild when OnConstruction already copied the mesh (deferred spawns).
+         if (!ProceduralMeshComponent || ProceduralMeshComponent->GetNumSections() == 0)
+         {
+             UpdateMeshFromData();
+         }
     } else {
          UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: BeginPlay: No valid ItemID or ItemData to initialize mesh."), *GetNameSafe(this));
     }
@@ -365,22 +370,40 @@ void AInventoryItemActor::SliceItem(const FVector& PlanePosition, const FVector&
 
 void AInventoryItemActor::RequestEnablePhysics()
 {
-    UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: RequestEnablePhysics called. Setting bEnablePhysicsRequested = true."), *GetNameSafe(this));
-    // Only set the flag. The actual enabling will happen in Tick.
+    if (bEnablePhysicsRequested)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: RequestEnablePhysics called while a request is already queued. Ignoring."), *GetNameSafe(this));
+        return;
+    }
+
     bEnablePhysicsRequested = true;
-    // Ensure Tick is enabled if it wasn't already (important if Tick was disabled for optimization)
-    if (!PrimaryActorTick.IsTickFunctionEnabled())
+
+    // Physics is enabled one frame later by the world's deferred action queue instead of this actor's tick,
+    // so item actors never need a tick function of their own.
+    if (UWarriorDeferredActionSubsystem* DeferredActionSubsystem = UWarriorDeferredActionSubsystem::Get(this))
     {
-        SetActorTickEnabled(true);
-        UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: Tick function was disabled, re-enabling for physics request."), *GetNameSafe(this));
+        UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: RequestEnablePhysics queued on the deferred action subsystem."), *GetNameSafe(this));
+
+        TWeakObjectPtr<AInventoryItemActor> WeakThis(this);
+        DeferredActionSubsystem->EnqueueAction(this, EWarriorDeferredActionPhase::NextFrame,
+            [WeakThis]()
+            {
+                if (AInventoryItemActor* StrongThis = WeakThis.Get())
+                {
+                    StrongThis->ApplyRequestedPhysics();
+                }
+            }
+        );
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("AInventoryItemActor [%s]: RequestEnablePhysics could not find the deferred action subsystem. Enabling physics immediately."), *GetNameSafe(this));
+        ApplyRequestedPhysics();
     }
 }
 
-// Called every frame
-void AInventoryItemActor::Tick(float DeltaTime)
+void AInventoryItemActor::ApplyRequestedPhysics()
 {
-	Super::Tick(DeltaTime);
-
 	// Handle physics enabling request
 	if (bEnablePhysicsRequested)
 	{
@@ -394,12 +417,12 @@ void AInventoryItemActor::Tick(float DeltaTime)
 			 if (ProceduralMeshComponent && !ProceduralMeshComponent->IsSimulatingPhysics())
              {
                  ProceduralMeshComponent->SetSimulatePhysics(true);
-                 UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: Tick - Ensuring ProceduralMeshComponent simulates physics (already sliced)."), *GetNameSafe(this));
+                 UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: ApplyRequestedPhysics - Ensuring ProceduralMeshComponent simulates physics (already sliced)."), *GetNameSafe(this));
              }
              if (OtherHalfProceduralMeshComponent && !OtherHalfProceduralMeshComponent->IsSimulatingPhysics())
              {
                  OtherHalfProceduralMeshComponent->SetSimulatePhysics(true);
-                  UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: Tick - Ensuring OtherHalfProceduralMeshComponent simulates physics (already sliced)."), *GetNameSafe(this));
+                  UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: ApplyRequestedPhysics - Ensuring OtherHalfProceduralMeshComponent simulates physics (already sliced)."), *GetNameSafe(this));
              }
 		}
 		else
@@ -407,7 +430,7 @@ void AInventoryItemActor::Tick(float DeltaTime)
 			// If not sliced, enable physics on the StaticMeshComponent
 			if (StaticMeshComponent && !StaticMeshComponent->IsSimulatingPhysics())
 			{
-				UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: Tick - Enabling physics on StaticMeshComponent."), *GetNameSafe(this));
+				UE_LOG(LogTemp, Log, TEXT("AInventoryItemActor [%s]: ApplyRequestedPhysics - Enabling physics on StaticMeshComponent."), *GetNameSafe(this));
 				// Ensure compatible collision settings BEFORE enabling physics simulation
 				StaticMeshComponent->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
 				StaticMeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
@@ -415,12 +438,12 @@ void AInventoryItemActor::Tick(float DeltaTime)
 			}
 			else if (!StaticMeshComponent)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("AInventoryItemActor [%s]: Tick - Could not enable physics on StaticMeshComponent (null?)."), *GetNameSafe(this));
+				UE_LOG(LogTemp, Warning, TEXT("AInventoryItemActor [%s]: ApplyRequestedPhysics - Could not enable physics on StaticMeshComponent (null?)."), *GetNameSafe(this));
 			}
             else if (StaticMeshComponent && StaticMeshComponent->IsSimulatingPhysics())
             {
                  // Already simulating, do nothing
-                 UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: Tick - Physics enable requested, but StaticMeshComponent already simulating."), *GetNameSafe(this));
+                 UE_LOG(LogTemp, Verbose, TEXT("AInventoryItemActor [%s]: ApplyRequestedPhysics - Physics enable requested, but StaticMeshComponent already simulating."), *GetNameSafe(this));
             }
 		}
 	}
@@ -8,6 +8,8 @@
 #include "WarriorFunctionLibrary.h"
 #include "WarriorGameplayTags.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "Subsystems/WarriorHitReactSubsystem.h"
+#include "Subsystems/WarriorCombatTelemetrySubsystem.h"
 
 #include "WarriorDebugHelper.h"
 
@@ -61,7 +63,7 @@ void AWarriorProjectileBase::OnProjectileHit(UPrimitiveComponent* HitComponent,
 
 	bool bIsValidBlock = false;
 
-	const bool bIsPlayerBlocking = UWarriorFunctionLibrary::NativeDoesActorHaveTag(HitPawn, WarriorGameplayTags::Player_Status_Blocking);
+	const bool bIsPlayerBlocking = UWarriorFunctionLibrary::NativeDoesActorHaveStatus(HitPawn, EWarriorStatusFlags::Blocking);
 
 	if (bIsPlayerBlocking)
 	{
@@ -74,6 +76,8 @@ void AWarriorProjectileBase::OnProjectileHit(UPrimitiveComponent* HitComponent,
 
 	if (bIsValidBlock)
 	{
+		UWarriorCombatTelemetrySubsystem::RecordBlockedHit(GetInstigator(), HitPawn);
+
 		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
 			HitPawn,
 			WarriorGameplayTags::Player_Event_SuccessfulBlock,
@@ -118,10 +122,7 @@ void AWarriorProjectileBase::HandleApplyProjectileDamage(APawn* InHitPawn, const
 
 	if (bWasApplied)
 	{
-		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
-			InHitPawn,
-			WarriorGameplayTags::Shared_Event_HitReact,
-			InPayload
-		);
+		// A volley landing on the same pawn this frame plays one hit react
+		UWarriorHitReactSubsystem::QueueOrSendHitReact(InHitPawn, InPayload);
 	}
 }
@@ -53,4 +53,17 @@ void AWarriorWeaponBase::OnCollisionBoxEndOverlap(UPrimitiveComponent* Overlappe
 	}
 }
 
+UPrimitiveComponent* AWarriorWeaponBase::GetMeleeTraceSegment(FVector& OutLocalStart, FVector& OutLocalEnd) const
+{
+	if (WeaponMesh->DoesSocketExist(MeleeTraceSettings.TraceStartSocket) && WeaponMesh->DoesSocketExist(MeleeTraceSettings.TraceEndSocket))
+	{
+		OutLocalStart = WeaponMesh->GetSocketTransform(MeleeTraceSettings.TraceStartSocket, RTS_Component).GetLocation();
+		OutLocalEnd = WeaponMesh->GetSocketTransform(MeleeTraceSettings.TraceEndSocket, RTS_Component).GetLocation();
+
+		return WeaponMesh;
+	}
+
+	FWarriorMeleeTraceSettings::GetBoxTraceSegment(WeaponCollisionBox->GetUnscaledBoxExtent(), OutLocalStart, OutLocalEnd);
 
+	return WeaponCollisionBox;
+}
@@ -0,0 +1,323 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorAISignificanceSubsystem.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Controllers/WarriorAIController.h"
+#include "Components/WidgetComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Significance Update"), STAT_WarriorAISignificanceUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Significance Changes"), STAT_WarriorAISignificanceChanges, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI Significance Tracked"), STAT_WarriorAISignificanceTracked, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarAISignificanceEnabled(
+	TEXT("Warrior.AISignificance.Enabled"),
+	true,
+	TEXT("Scales enemy update rates by distance and visibility. When off, every enemy is kept at High significance."));
+
+static TAutoConsoleVariable<int32> CVarAISignificanceUpdatesPerFrame(
+	TEXT("Warrior.AISignificance.UpdatesPerFrame"),
+	24,
+	TEXT("Enemies re-evaluated per frame. The rest keep their bucket until their turn comes round."));
+
+UWarriorAISignificanceSubsystem::UWarriorAISignificanceSubsystem()
+{
+	HighSignificance.MaxDistance = 1500.f;
+
+	MediumSignificance.MaxDistance = 3000.f;
+	MediumSignificance.BTServiceInterval = 0.1f;
+	MediumSignificance.MovementTickInterval = 0.f;
+	MediumSignificance.AnimTickInterval = 0.f;
+	MediumSignificance.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	MediumSignificance.MaxCrowdAvoidanceQuality = ECrowdAvoidanceQuality::Good;
+
+	LowSignificance.MaxDistance = 6000.f;
+	LowSignificance.BTServiceInterval = 0.25f;
+	LowSignificance.MovementTickInterval = 1.f / 15.f;
+	LowSignificance.AnimTickInterval = 1.f / 15.f;
+	LowSignificance.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	LowSignificance.bTickHealthWidget = false;
+	LowSignificance.MaxCrowdAvoidanceQuality = ECrowdAvoidanceQuality::Medium;
+
+	DormantSignificance.BTServiceInterval = 0.5f;
+	DormantSignificance.MovementTickInterval = 0.2f;
+	DormantSignificance.AnimTickInterval = 0.2f;
+	DormantSignificance.VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	DormantSignificance.bTickHealthWidget = false;
+	DormantSignificance.MaxCrowdAvoidanceQuality = ECrowdAvoidanceQuality::Low;
+}
+
+UWarriorAISignificanceSubsystem* UWarriorAISignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorAISignificanceSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorAISignificanceSubsystem::Deinitialize()
+{
+	TrackedEnemies.Empty();
+	ViewLocations.Empty();
+	NextEnemyIndex = 0;
+
+	SET_DWORD_STAT(STAT_WarriorAISignificanceTracked, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorAISignificanceSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorAISignificanceUpdate);
+
+	const bool bEnabled = CVarAISignificanceEnabled.GetValueOnGameThread();
+
+	if (bEnabled && !GatherViewLocations())
+	{
+		return;
+	}
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	const int32 NumToUpdate = FMath::Min(FMath::Max(CVarAISignificanceUpdatesPerFrame.GetValueOnGameThread(), 1), TrackedEnemies.Num());
+
+	for (int32 UpdateCount = 0; UpdateCount < NumToUpdate && !TrackedEnemies.IsEmpty(); ++UpdateCount)
+	{
+		if (NextEnemyIndex >= TrackedEnemies.Num())
+		{
+			NextEnemyIndex = 0;
+		}
+
+		FTrackedEnemy& TrackedEnemy = TrackedEnemies[NextEnemyIndex];
+		AWarriorEnemyCharacter* Enemy = TrackedEnemy.Enemy.Get();
+
+		if (!Enemy)
+		{
+			TrackedEnemies.RemoveAtSwap(NextEnemyIndex, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		++NextEnemyIndex;
+
+		// Pooled enemies waiting in the pool have everything switched off already
+		if (Enemy->IsHidden())
+		{
+			continue;
+		}
+
+		const EWarriorAISignificance CurrentLevel = Enemy->GetAISignificance();
+		const EWarriorAISignificance NewLevel = bEnabled ? EvaluateLevel(Enemy, CurrentLevel) : EWarriorAISignificance::High;
+
+		if (NewLevel == CurrentLevel)
+		{
+			continue;
+		}
+
+		// Dropping back to full rate is never delayed, a player closing in must not see a choppy enemy
+		if (NewLevel > CurrentLevel && CurrentTime - TrackedEnemy.LastLevelChangeTime < MinSecondsInLevel)
+		{
+			continue;
+		}
+
+		TrackedEnemy.LastLevelChangeTime = CurrentTime;
+
+		ApplyLevel(Enemy, NewLevel);
+
+		INC_DWORD_STAT(STAT_WarriorAISignificanceChanges);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorAISignificanceTracked, TrackedEnemies.Num());
+}
+
+ETickableTickType UWarriorAISignificanceSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorAISignificanceSubsystem::IsTickable() const
+{
+	return !TrackedEnemies.IsEmpty();
+}
+
+TStatId UWarriorAISignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorAISignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorAISignificanceSubsystem::RegisterEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	check(InEnemy);
+
+	const bool bAlreadyTracked = TrackedEnemies.ContainsByPredicate([InEnemy](const FTrackedEnemy& TrackedEnemy)
+		{
+			return TrackedEnemy.Enemy == InEnemy;
+		});
+
+	if (!bAlreadyTracked)
+	{
+		FTrackedEnemy& NewEntry = TrackedEnemies.AddDefaulted_GetRef();
+		NewEntry.Enemy = InEnemy;
+		NewEntry.LastLevelChangeTime = GetWorld()->GetTimeSeconds();
+	}
+}
+
+void UWarriorAISignificanceSubsystem::UnregisterEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	const int32 Index = TrackedEnemies.IndexOfByPredicate([InEnemy](const FTrackedEnemy& TrackedEnemy)
+		{
+			return TrackedEnemy.Enemy == InEnemy;
+		});
+
+	if (Index != INDEX_NONE)
+	{
+		TrackedEnemies.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+const FWarriorAISignificanceLevelSettings& UWarriorAISignificanceSubsystem::GetLevelSettings(EWarriorAISignificance InLevel) const
+{
+	switch (InLevel)
+	{
+	case EWarriorAISignificance::Medium:	return MediumSignificance;
+	case EWarriorAISignificance::Low:		return LowSignificance;
+	case EWarriorAISignificance::Dormant:	return DormantSignificance;
+	default:								return HighSignificance;
+	}
+}
+
+float UWarriorAISignificanceSubsystem::GetBTServiceIntervalForPawn(const APawn* InPawn)
+{
+	const AWarriorEnemyCharacter* Enemy = Cast<AWarriorEnemyCharacter>(InPawn);
+
+	if (!Enemy || Enemy->GetAISignificance() == EWarriorAISignificance::High)
+	{
+		return 0.f;
+	}
+
+	const UWorld* World = Enemy->GetWorld();
+	const UWarriorAISignificanceSubsystem* SignificanceSubsystem = World ? World->GetSubsystem<UWarriorAISignificanceSubsystem>() : nullptr;
+
+	return SignificanceSubsystem ? SignificanceSubsystem->GetLevelSettings(Enemy->GetAISignificance()).BTServiceInterval : 0.f;
+}
+
+bool UWarriorAISignificanceSubsystem::GatherViewLocations()
+{
+	ViewLocations.Reset();
+	bHasLocalViewers = false;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* PlayerController = It->Get();
+
+		if (!PlayerController)
+		{
+			continue;
+		}
+
+		if (PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+			ViewLocations.Add(ViewLocation);
+			bHasLocalViewers = true;
+		}
+		else if (const APawn* PlayerPawn = PlayerController->GetPawn())
+		{
+			ViewLocations.Add(PlayerPawn->GetActorLocation());
+		}
+	}
+
+	return !ViewLocations.IsEmpty();
+}
+
+EWarriorAISignificance UWarriorAISignificanceSubsystem::ClassifyDistance(float InDistance) const
+{
+	if (InDistance <= HighSignificance.MaxDistance)
+	{
+		return EWarriorAISignificance::High;
+	}
+
+	if (InDistance <= MediumSignificance.MaxDistance)
+	{
+		return EWarriorAISignificance::Medium;
+	}
+
+	if (InDistance <= LowSignificance.MaxDistance)
+	{
+		return EWarriorAISignificance::Low;
+	}
+
+	return EWarriorAISignificance::Dormant;
+}
+
+EWarriorAISignificance UWarriorAISignificanceSubsystem::EvaluateLevel(const AWarriorEnemyCharacter* InEnemy, EWarriorAISignificance InCurrentLevel) const
+{
+	const FVector EnemyLocation = InEnemy->GetActorLocation();
+
+	float ClosestDistanceSquared = TNumericLimits<float>::Max();
+
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, static_cast<float>(FVector::DistSquared(EnemyLocation, ViewLocation)));
+	}
+
+	const float Distance = FMath::Sqrt(ClosestDistanceSquared);
+
+	EWarriorAISignificance NewLevel = ClassifyDistance(Distance);
+
+	// Only leave the current bucket once the distance is past the boundary by the hysteresis margin
+	if (NewLevel > InCurrentLevel)
+	{
+		NewLevel = FMath::Max(ClassifyDistance(Distance - HysteresisDistance), InCurrentLevel);
+	}
+	else if (NewLevel < InCurrentLevel)
+	{
+		NewLevel = FMath::Min(ClassifyDistance(Distance + HysteresisDistance), InCurrentLevel);
+	}
+
+	const bool bIsOnScreen = !bHasLocalViewers || InEnemy->WasRecentlyRendered(OnScreenTolerance);
+
+	if (!bIsOnScreen && NewLevel < EWarriorAISignificance::Dormant)
+	{
+		NewLevel = static_cast<EWarriorAISignificance>(static_cast<uint8>(NewLevel) + 1);
+	}
+
+	return NewLevel;
+}
+
+void UWarriorAISignificanceSubsystem::ApplyLevel(AWarriorEnemyCharacter* InEnemy, EWarriorAISignificance InLevel) const
+{
+	const FWarriorAISignificanceLevelSettings& Settings = GetLevelSettings(InLevel);
+
+	InEnemy->SetAISignificance(InLevel);
+
+	InEnemy->GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+
+	USkeletalMeshComponent* Mesh = InEnemy->GetMesh();
+	Mesh->SetComponentTickInterval(Settings.AnimTickInterval);
+	Mesh->VisibilityBasedAnimTickOption = Settings.VisibilityBasedAnimTickOption;
+
+	// Left off when the enemy draws its bar through the shared health bar layer
+	UWidgetComponent* HealthWidgetComponent = InEnemy->GetEnemyHealthWidgetComponent();
+
+	if (HealthWidgetComponent && !InEnemy->IsHealthBarOnLayer())
+	{
+		HealthWidgetComponent->SetComponentTickEnabled(Settings.bTickHealthWidget);
+	}
+
+	if (AWarriorAIController* AIController = InEnemy->GetController<AWarriorAIController>())
+	{
+		AIController->SetCrowdAvoidanceQualityLimit(Settings.MaxCrowdAvoidanceQuality);
+	}
+}
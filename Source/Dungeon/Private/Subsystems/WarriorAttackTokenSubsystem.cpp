@@ -0,0 +1,279 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorAttackTokenSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WarriorStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Granted"), STAT_WarriorAttackTokensGranted, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Denied"), STAT_WarriorAttackTokensDenied, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Tokens Held"), STAT_WarriorAttackTokensHeld, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarAttackTokensEnabled(
+	TEXT("Warrior.AttackTokens.Enabled"),
+	true,
+	TEXT("Enemies need an attack token from their target before starting a melee attack."));
+
+UWarriorAttackTokenSubsystem* UWarriorAttackTokenSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorAttackTokenSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorAttackTokenSubsystem::Deinitialize()
+{
+	TokensByTarget.Empty();
+	TargetByHolder.Empty();
+	CooldownEndByAttacker.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorAttackTokensHeld, 0);
+
+	Super::Deinitialize();
+}
+
+bool UWarriorAttackTokenSubsystem::IsEnabled()
+{
+	return CVarAttackTokensEnabled.GetValueOnGameThread();
+}
+
+bool UWarriorAttackTokenSubsystem::TryAcquireToken(AActor* InAttacker, AActor* InTarget, int32 InPriority)
+{
+	check(InAttacker && InTarget);
+
+	if (HasTokenOn(InAttacker, InTarget))
+	{
+		return true;
+	}
+
+	// Switching targets gives the old target's token back
+	ReleaseToken(InAttacker);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (const double* CooldownEnd = CooldownEndByAttacker.Find(InAttacker))
+	{
+		if (Now < *CooldownEnd)
+		{
+			// Cooling down attackers do not queue, they must not hold back anyone else
+			INC_DWORD_STAT(STAT_WarriorAttackTokensDenied);
+			return false;
+		}
+
+		CooldownEndByAttacker.Remove(InAttacker);
+	}
+
+	FTargetTokens& Tokens = TokensByTarget.FindOrAdd(InTarget);
+	PruneTargetTokens(Tokens, Now);
+
+	FTokenRequest* Request = Tokens.Requests.FindByPredicate([InAttacker](const FTokenRequest& Existing)
+		{
+			return Existing.Attacker == InAttacker;
+		});
+
+	if (!Request)
+	{
+		Request = &Tokens.Requests.AddDefaulted_GetRef();
+		Request->Attacker = InAttacker;
+		Request->FirstRequestTime = Now;
+	}
+
+	Request->LastRequestTime = Now;
+	Request->Score = ScoreRequest(InAttacker, InTarget, InPriority, Now - Request->FirstRequestTime);
+
+	const int32 NumFreeTokens = MaxTokensPerTarget - Tokens.Holders.Num();
+
+	if (NumFreeTokens <= 0 || Now - Tokens.LastGrantTime < MinGrantInterval)
+	{
+		INC_DWORD_STAT(STAT_WarriorAttackTokensDenied);
+		return false;
+	}
+
+	// The free tokens belong to the best scores among everyone still asking
+	const float RequestScore = Request->Score;
+	int32 NumBetterRequests = 0;
+
+	for (const FTokenRequest& OtherRequest : Tokens.Requests)
+	{
+		if (OtherRequest.Score > RequestScore)
+		{
+			++NumBetterRequests;
+		}
+	}
+
+	if (NumBetterRequests >= NumFreeTokens)
+	{
+		INC_DWORD_STAT(STAT_WarriorAttackTokensDenied);
+		return false;
+	}
+
+	Tokens.Requests.RemoveAtSwap(UE_PTRDIFF_TO_INT32(Request - Tokens.Requests.GetData()), 1, EAllowShrinking::No);
+
+	FTokenHolder& Holder = Tokens.Holders.AddDefaulted_GetRef();
+	Holder.Attacker = InAttacker;
+	Holder.AttackerKey = InAttacker;
+	Holder.GrantTime = Now;
+
+	Tokens.LastGrantTime = Now;
+	TargetByHolder.Add(InAttacker, InTarget);
+
+	INC_DWORD_STAT(STAT_WarriorAttackTokensGranted);
+	SET_DWORD_STAT(STAT_WarriorAttackTokensHeld, TargetByHolder.Num());
+
+	return true;
+}
+
+bool UWarriorAttackTokenSubsystem::CanAcquireToken(const AActor* InAttacker, const AActor* InTarget, int32 InPriority) const
+{
+	check(InAttacker && InTarget);
+
+	if (HasTokenOn(InAttacker, InTarget))
+	{
+		return true;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (const double* CooldownEnd = CooldownEndByAttacker.Find(InAttacker))
+	{
+		if (Now < *CooldownEnd)
+		{
+			return false;
+		}
+	}
+
+	const FTargetTokens* Tokens = TokensByTarget.Find(InTarget);
+
+	if (!Tokens)
+	{
+		return MaxTokensPerTarget > 0;
+	}
+
+	// Same answer as TryAcquireToken, with the holders and requests it would prune skipped instead of removed
+	int32 NumHolders = 0;
+
+	for (const FTokenHolder& Holder : Tokens->Holders)
+	{
+		NumHolders += IsHolderExpired(Holder, Now) ? 0 : 1;
+	}
+
+	const int32 NumFreeTokens = MaxTokensPerTarget - NumHolders;
+
+	if (NumFreeTokens <= 0 || Now - Tokens->LastGrantTime < MinGrantInterval)
+	{
+		return false;
+	}
+
+	const FTokenRequest* OwnRequest = Tokens->Requests.FindByPredicate([InAttacker](const FTokenRequest& Existing)
+		{
+			return Existing.Attacker == InAttacker;
+		});
+
+	const double WaitTime = OwnRequest && !IsRequestExpired(*OwnRequest, Now) ? Now - OwnRequest->FirstRequestTime : 0.0;
+	const float RequestScore = ScoreRequest(InAttacker, InTarget, InPriority, WaitTime);
+	int32 NumBetterRequests = 0;
+
+	for (const FTokenRequest& OtherRequest : Tokens->Requests)
+	{
+		if (&OtherRequest != OwnRequest && !IsRequestExpired(OtherRequest, Now) && OtherRequest.Score > RequestScore)
+		{
+			++NumBetterRequests;
+		}
+	}
+
+	return NumBetterRequests < NumFreeTokens;
+}
+
+void UWarriorAttackTokenSubsystem::ReleaseToken(AActor* InAttacker)
+{
+	TObjectKey<AActor> TargetKey;
+
+	if (!TargetByHolder.RemoveAndCopyValue(InAttacker, TargetKey))
+	{
+		return;
+	}
+
+	if (FTargetTokens* Tokens = TokensByTarget.Find(TargetKey))
+	{
+		const TObjectKey<AActor> AttackerKey(InAttacker);
+
+		Tokens->Holders.RemoveAllSwap([&AttackerKey](const FTokenHolder& Holder)
+			{
+				return Holder.AttackerKey == AttackerKey;
+			});
+
+		if (Tokens->Holders.IsEmpty() && Tokens->Requests.IsEmpty())
+		{
+			TokensByTarget.Remove(TargetKey);
+		}
+	}
+
+	if (AttackerCooldown > 0.f)
+	{
+		CooldownEndByAttacker.Add(InAttacker, GetWorld()->GetTimeSeconds() + AttackerCooldown);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorAttackTokensHeld, TargetByHolder.Num());
+}
+
+bool UWarriorAttackTokenSubsystem::HasToken(const AActor* InAttacker) const
+{
+	return TargetByHolder.Contains(InAttacker);
+}
+
+bool UWarriorAttackTokenSubsystem::HasTokenOn(const AActor* InAttacker, const AActor* InTarget) const
+{
+	const TObjectKey<AActor>* HeldTarget = TargetByHolder.Find(InAttacker);
+
+	return HeldTarget && *HeldTarget == TObjectKey<AActor>(InTarget);
+}
+
+int32 UWarriorAttackTokenSubsystem::GetNumFreeTokens(const AActor* InTarget) const
+{
+	const FTargetTokens* Tokens = TokensByTarget.Find(InTarget);
+
+	return Tokens ? FMath::Max(MaxTokensPerTarget - Tokens->Holders.Num(), 0) : MaxTokensPerTarget;
+}
+
+void UWarriorAttackTokenSubsystem::PruneTargetTokens(FTargetTokens& InOutTokens, double InNow)
+{
+	for (int32 Index = InOutTokens.Holders.Num() - 1; Index >= 0; --Index)
+	{
+		const FTokenHolder& Holder = InOutTokens.Holders[Index];
+
+		if (IsHolderExpired(Holder, InNow))
+		{
+			TargetByHolder.Remove(Holder.AttackerKey);
+			InOutTokens.Holders.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	InOutTokens.Requests.RemoveAllSwap([this, InNow](const FTokenRequest& Request)
+		{
+			return IsRequestExpired(Request, InNow);
+		});
+}
+
+bool UWarriorAttackTokenSubsystem::IsHolderExpired(const FTokenHolder& InHolder, double InNow) const
+{
+	return !InHolder.Attacker.IsValid() || (MaxHoldTime > 0.f && InNow - InHolder.GrantTime > MaxHoldTime);
+}
+
+bool UWarriorAttackTokenSubsystem::IsRequestExpired(const FTokenRequest& InRequest, double InNow) const
+{
+	return !InRequest.Attacker.IsValid() || InNow - InRequest.LastRequestTime > RequestMemoryTime;
+}
+
+float UWarriorAttackTokenSubsystem::ScoreRequest(const AActor* InAttacker, const AActor* InTarget, int32 InPriority, double InWaitTime) const
+{
+	const float Distance = FVector::Dist(InAttacker->GetActorLocation(), InTarget->GetActorLocation());
+
+	return InPriority * PriorityScore - Distance * DistanceScorePerUnit + static_cast<float>(InWaitTime) * WaitScorePerSecond;
+}
@@ -0,0 +1,335 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorBTProfilerSubsystem.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "BehaviorTree/BTNode.h"
+#include "AIController.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "WarriorStats.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("BT Tree Tick Ms"), STAT_WarriorBTTreeTickMs, STATGROUP_Warrior);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("BT Native Node Ms"), STAT_WarriorBTNativeNodeMs, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("BT Node Activations"), STAT_WarriorBTNodeActivations, STATGROUP_Warrior);
+
+CSV_DEFINE_CATEGORY(WarriorBT, true);
+
+static TAutoConsoleVariable<bool> CVarBTProfilerEnabled(
+	TEXT("Warrior.BTProfiler.Enabled"),
+	false,
+	TEXT("Records activations, ticks and inclusive time of behaviour tree nodes per enemy class."));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GBTProfilerDumpCommand(
+	TEXT("Warrior.BTProfiler.Dump"),
+	TEXT("Prints the behaviour tree profile entries with the most inclusive time. Args: [MaxEntries=20]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UWarriorBTProfilerSubsystem* Profiler = World ? World->GetSubsystem<UWarriorBTProfilerSubsystem>() : nullptr;
+		if (!Profiler)
+		{
+			Ar.Log(TEXT("Warrior.BTProfiler.Dump: No game world to read from."));
+			return;
+		}
+
+		const int32 MaxEntries = Args.IsEmpty() ? 20 : FCString::Atoi(*Args[0]);
+		Profiler->DumpTopEntries(MaxEntries > 0 ? MaxEntries : 20, Ar);
+	}));
+
+static FAutoConsoleCommandWithWorld GBTProfilerResetCommand(
+	TEXT("Warrior.BTProfiler.Reset"),
+	TEXT("Clears the behaviour tree profile totals."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UWarriorBTProfilerSubsystem* Profiler = World ? World->GetSubsystem<UWarriorBTProfilerSubsystem>() : nullptr)
+		{
+			Profiler->ResetProfile();
+		}
+	}));
+#endif
+
+namespace WarriorBTProfiler
+{
+	static const TCHAR* GetTypeName(EWarriorBTProfileEntryType InType)
+	{
+		return InType == EWarriorBTProfileEntryType::Node ? TEXT("Node") : TEXT("Branch");
+	}
+}
+
+bool UWarriorBTProfilerSubsystem::IsEnabled()
+{
+	return CVarBTProfilerEnabled.GetValueOnGameThread();
+}
+
+void UWarriorBTProfilerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+#if CSV_PROFILER
+	if (GetWorld()->IsGameWorld())
+	{
+		CsvProfileStartHandle = FCsvProfiler::Get()->OnCSVProfileStart().AddUObject(this, &ThisClass::HandleCsvProfileStart);
+		CsvProfileFinishedHandle = FCsvProfiler::Get()->OnCSVProfileFinished().AddUObject(this, &ThisClass::HandleCsvProfileFinished);
+	}
+#endif
+}
+
+void UWarriorBTProfilerSubsystem::Deinitialize()
+{
+#if CSV_PROFILER
+	FCsvProfiler::Get()->OnCSVProfileStart().Remove(CsvProfileStartHandle);
+	FCsvProfiler::Get()->OnCSVProfileFinished().Remove(CsvProfileFinishedHandle);
+#endif
+
+	ResetProfile();
+
+	Super::Deinitialize();
+}
+
+void UWarriorBTProfilerSubsystem::Tick(float DeltaTime)
+{
+#if CSV_PROFILER
+	const bool bCsvCapturing = FCsvProfiler::Get()->IsCapturing();
+#endif
+
+	for (TPair<FWarriorBTProfileKey, FProfileEntry>& Pair : Entries)
+	{
+		FProfileEntry& Entry = Pair.Value;
+
+		if (Entry.FrameCycles == 0)
+		{
+			continue;
+		}
+
+#if CSV_PROFILER
+		if (bCsvCapturing)
+		{
+			FCsvProfiler::RecordCustomStat(Entry.CsvStatName, CSV_CATEGORY_INDEX(WarriorBT), static_cast<float>(FPlatformTime::ToMilliseconds64(Entry.FrameCycles)), ECsvCustomStatOp::Set);
+		}
+#endif
+
+		Entry.FrameCycles = 0;
+	}
+
+	CSV_CUSTOM_STAT(WarriorBT, TreeTickMs, FrameSummary.TreeTickMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(WarriorBT, NativeNodeMs, FrameSummary.NodeMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(WarriorBT, Activations, FrameSummary.Activations, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(WarriorBT, Ticks, FrameSummary.Ticks, ECsvCustomStatOp::Set);
+
+	SET_FLOAT_STAT(STAT_WarriorBTTreeTickMs, FrameSummary.TreeTickMs);
+	SET_FLOAT_STAT(STAT_WarriorBTNativeNodeMs, FrameSummary.NodeMs);
+	SET_DWORD_STAT(STAT_WarriorBTNodeActivations, FrameSummary.Activations);
+
+	LastFrameSummary = FrameSummary;
+	FrameSummary = FWarriorBTProfileFrameSummary();
+	bHasFrameSamples = false;
+
+	if (IsEnabled())
+	{
+		++ProfiledFrames;
+	}
+}
+
+ETickableTickType UWarriorBTProfilerSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorBTProfilerSubsystem::IsTickable() const
+{
+	// One more tick after the profiler is turned off flushes the last samples
+	return IsEnabled() || bHasFrameSamples;
+}
+
+TStatId UWarriorBTProfilerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorBTProfilerSubsystem, STATGROUP_Tickables);
+}
+
+FWarriorBTProfileKey UWarriorBTProfilerSubsystem::MakeKey(const UBehaviorTreeComponent& InOwnerComp, const FName& InNodeName, EWarriorBTProfileEntryType InType)
+{
+	const AAIController* AIOwner = InOwnerComp.GetAIOwner();
+	const APawn* OwningPawn = AIOwner ? AIOwner->GetPawn() : nullptr;
+
+	FWarriorBTProfileKey Key;
+	Key.NodeName = InNodeName;
+	Key.PawnClassName = OwningPawn ? OwningPawn->GetClass()->GetFName() : NAME_None;
+	Key.Type = InType;
+
+	return Key;
+}
+
+void UWarriorBTProfilerSubsystem::Record(const FWarriorBTProfileKey& InKey, EWarriorBTProfileEvent InEvent, uint64 InCycles)
+{
+	FProfileEntry* Entry = Entries.Find(InKey);
+
+	if (!Entry)
+	{
+		Entry = &Entries.Add(InKey);
+		Entry->CsvStatName = FName(FString::Printf(TEXT("%s/%s/%s"), WarriorBTProfiler::GetTypeName(InKey.Type), *InKey.NodeName.ToString(), *InKey.PawnClassName.ToString()));
+	}
+
+	const int32 NumActivations = InEvent == EWarriorBTProfileEvent::Activation ? 1 : 0;
+	const int32 NumTicks = InEvent == EWarriorBTProfileEvent::Tick ? 1 : 0;
+
+	Entry->Activations += NumActivations;
+	Entry->Ticks += NumTicks;
+	Entry->Cycles += InCycles;
+	Entry->FrameCycles += InCycles;
+
+	const float Ms = static_cast<float>(FPlatformTime::ToMilliseconds64(InCycles));
+
+	// Branch entries already contain the native node time, so the two are summed separately
+	if (InKey.Type == EWarriorBTProfileEntryType::Branch)
+	{
+		FrameSummary.TreeTickMs += Ms;
+	}
+	else
+	{
+		FrameSummary.NodeMs += Ms;
+		FrameSummary.Activations += NumActivations;
+		FrameSummary.Ticks += NumTicks;
+	}
+
+	bHasFrameSamples = true;
+}
+
+void UWarriorBTProfilerSubsystem::DumpTopEntries(int32 InMaxEntries, FOutputDevice& Ar) const
+{
+	TArray<TPair<FWarriorBTProfileKey, const FProfileEntry*>> SortedEntries;
+	GetSortedEntries(SortedEntries);
+
+	const int32 NumFrames = FMath::Max(ProfiledFrames, 1);
+
+	Ar.Logf(TEXT("Warrior BT profile over %d frames, %d entries%s"), ProfiledFrames, SortedEntries.Num(), IsEnabled() ? TEXT("") : TEXT(" (Warrior.BTProfiler.Enabled is off)"));
+	Ar.Logf(TEXT("%-6s %10s %9s %11s %9s %9s  %s [%s]"), TEXT("Type"), TEXT("Total ms"), TEXT("ms/frame"), TEXT("Activations"), TEXT("Ticks"), TEXT("us/call"), TEXT("Node"), TEXT("Pawn class"));
+
+	for (int32 Index = 0; Index < SortedEntries.Num() && Index < InMaxEntries; ++Index)
+	{
+		const FWarriorBTProfileKey& Key = SortedEntries[Index].Key;
+		const FProfileEntry& Entry = *SortedEntries[Index].Value;
+
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Entry.Cycles);
+		const int32 NumCalls = FMath::Max(Entry.Activations + Entry.Ticks, 1);
+
+		Ar.Logf(TEXT("%-6s %10.2f %9.3f %11d %9d %9.2f  %s [%s]"),
+			WarriorBTProfiler::GetTypeName(Key.Type), TotalMs, TotalMs / NumFrames, Entry.Activations, Entry.Ticks, TotalMs * 1000.0 / NumCalls,
+			*Key.NodeName.ToString(), *Key.PawnClassName.ToString());
+	}
+}
+
+void UWarriorBTProfilerSubsystem::ResetProfile()
+{
+	Entries.Empty();
+	FrameSummary = FWarriorBTProfileFrameSummary();
+	LastFrameSummary = FWarriorBTProfileFrameSummary();
+	ProfiledFrames = 0;
+	bHasFrameSamples = false;
+}
+
+void UWarriorBTProfilerSubsystem::GetSortedEntries(TArray<TPair<FWarriorBTProfileKey, const FProfileEntry*>>& OutEntries) const
+{
+	OutEntries.Reset(Entries.Num());
+
+	for (const TPair<FWarriorBTProfileKey, FProfileEntry>& Pair : Entries)
+	{
+		OutEntries.Emplace(Pair.Key, &Pair.Value);
+	}
+
+	OutEntries.Sort([](const TPair<FWarriorBTProfileKey, const FProfileEntry*>& A, const TPair<FWarriorBTProfileKey, const FProfileEntry*>& B)
+		{
+			return A.Value->Cycles > B.Value->Cycles;
+		});
+}
+
+bool UWarriorBTProfilerSubsystem::WriteProfileFile(const FString& InFilePath) const
+{
+	TArray<TPair<FWarriorBTProfileKey, const FProfileEntry*>> SortedEntries;
+	GetSortedEntries(SortedEntries);
+
+	const int32 NumFrames = FMath::Max(ProfiledFrames, 1);
+
+	FString Output = TEXT("Type,Node,PawnClass,Activations,Ticks,TotalMs,MsPerFrame,UsPerCall\n");
+
+	for (const TPair<FWarriorBTProfileKey, const FProfileEntry*>& Pair : SortedEntries)
+	{
+		const FProfileEntry& Entry = *Pair.Value;
+
+		const double TotalMs = FPlatformTime::ToMilliseconds64(Entry.Cycles);
+		const int32 NumCalls = FMath::Max(Entry.Activations + Entry.Ticks, 1);
+
+		Output += FString::Printf(TEXT("%s,\"%s\",%s,%d,%d,%.3f,%.4f,%.2f\n"),
+			WarriorBTProfiler::GetTypeName(Pair.Key.Type), *Pair.Key.NodeName.ToString(), *Pair.Key.PawnClassName.ToString(),
+			Entry.Activations, Entry.Ticks, TotalMs, TotalMs / NumFrames, TotalMs * 1000.0 / NumCalls);
+	}
+
+	return FFileHelper::SaveStringToFile(Output, *InFilePath);
+}
+
+void UWarriorBTProfilerSubsystem::HandleCsvProfileStart()
+{
+	// The CSV profiler may notify from its own thread, the profile is only touched on the game thread
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<ThisClass>(this)]()
+		{
+			if (ThisClass* Profiler = WeakThis.Get())
+			{
+				// Totals then cover the same frames as the capture they are saved next to
+				Profiler->ResetProfile();
+			}
+		});
+}
+
+void UWarriorBTProfilerSubsystem::HandleCsvProfileFinished(const FString& InCsvFilePath)
+{
+	AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<ThisClass>(this), InCsvFilePath]()
+		{
+			const ThisClass* Profiler = WeakThis.Get();
+
+			if (!Profiler || Profiler->Entries.IsEmpty())
+			{
+				return;
+			}
+
+			const FString ProfilePath = FPaths::GetPath(InCsvFilePath) / FPaths::GetBaseFilename(InCsvFilePath) + TEXT("_BTProfile.csv");
+
+			if (Profiler->WriteProfileFile(ProfilePath))
+			{
+				UE_LOG(LogTemp, Log, TEXT("UWarriorBTProfilerSubsystem: Profile written to %s"), *FPaths::ConvertRelativePathToFull(ProfilePath));
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("UWarriorBTProfilerSubsystem: Failed to write %s"), *ProfilePath);
+			}
+		});
+}
+
+FWarriorBTProfileScope::FWarriorBTProfileScope(const UBTNode* InNode, const UBehaviorTreeComponent& InOwnerComp, EWarriorBTProfileEvent InEvent)
+	: Event(InEvent)
+{
+	if (!UWarriorBTProfilerSubsystem::IsEnabled())
+	{
+		return;
+	}
+
+	const UWorld* World = InOwnerComp.GetWorld();
+	Profiler = World ? World->GetSubsystem<UWarriorBTProfilerSubsystem>() : nullptr;
+
+	if (Profiler)
+	{
+		Key = UWarriorBTProfilerSubsystem::MakeKey(InOwnerComp, FName(*InNode->GetNodeName()), EWarriorBTProfileEntryType::Node);
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FWarriorBTProfileScope::~FWarriorBTProfileScope()
+{
+	if (Profiler)
+	{
+		Profiler->Record(Key, Event, FPlatformTime::Cycles64() - StartCycles);
+	}
+}
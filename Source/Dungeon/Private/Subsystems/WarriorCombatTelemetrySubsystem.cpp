@@ -0,0 +1,418 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorCombatTelemetrySubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+#include <atomic>
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Telemetry Hits Recorded"), STAT_WarriorTelemetryHitsRecorded, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Telemetry Hits Dropped"), STAT_WarriorTelemetryHitsDropped, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarTelemetryEnabled(
+	TEXT("Warrior.Telemetry.Enabled"),
+	false,
+	TEXT("Records every combat hit to Saved/Profiling/CombatTelemetry. Turning it off closes the current file."),
+	FConsoleVariableDelegate::CreateStatic(&UWarriorCombatTelemetrySubsystem::OnEnabledChanged));
+
+static TAutoConsoleVariable<int32> CVarTelemetryFormat(
+	TEXT("Warrior.Telemetry.Format"),
+	0,
+	TEXT("File format of new telemetry sessions. 0: CSV, 1: binary."));
+
+static TAutoConsoleVariable<int32> CVarTelemetryBufferSize(
+	TEXT("Warrior.Telemetry.BufferSize"),
+	4096,
+	TEXT("Hits the ring buffer holds before new ones are dropped. Rounded up to a power of two when a session starts."));
+
+static TAutoConsoleVariable<float> CVarTelemetryFlushInterval(
+	TEXT("Warrior.Telemetry.FlushInterval"),
+	0.25f,
+	TEXT("Seconds the writer thread sleeps between drains of the ring buffer."));
+
+namespace WarriorCombatTelemetry
+{
+	static constexpr uint32 BinaryMagic = 0x31544357; // "WCT1"
+	static constexpr uint32 BinaryVersion = 1;
+
+	static const TCHAR* BlockResultToString(EWarriorTelemetryBlockResult InBlockResult)
+	{
+		switch (InBlockResult)
+		{
+		case EWarriorTelemetryBlockResult::Blocked:		return TEXT("Blocked");
+		case EWarriorTelemetryBlockResult::BlockBroken:	return TEXT("BlockBroken");
+		default:										return TEXT("None");
+		}
+	}
+
+	static const TCHAR* HitReactDirectionToString(EWarriorTelemetryHitReactDirection InDirection)
+	{
+		switch (InDirection)
+		{
+		case EWarriorTelemetryHitReactDirection::Left:	return TEXT("Left");
+		case EWarriorTelemetryHitReactDirection::Right:	return TEXT("Right");
+		case EWarriorTelemetryHitReactDirection::Back:	return TEXT("Back");
+		default:										return TEXT("Front");
+		}
+	}
+}
+
+/**
+ * Owns the ring buffer and the output file. Push is only called from the game thread and Run only from the
+ * writer thread, so two monotonically increasing indices are enough to hand records over without a lock.
+ */
+class FWarriorCombatTelemetryWriter : public FRunnable
+{
+public:
+	FWarriorCombatTelemetryWriter(IFileHandle* InFileHandle, bool bInBinary, int32 InCapacity, float InFlushIntervalSeconds)
+		: FileHandle(InFileHandle)
+		, bBinary(bInBinary)
+		, FlushIntervalMs(FMath::Max(1, FMath::RoundToInt(InFlushIntervalSeconds * 1000.f)))
+	{
+		Records.SetNum(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Clamp(InCapacity, 64, 1 << 20))));
+		IndexMask = Records.Num() - 1;
+
+		WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+		WriteHeader();
+	}
+
+	virtual ~FWarriorCombatTelemetryWriter() override
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		delete FileHandle;
+	}
+
+	// Game thread only. Returns false when the buffer is full and the record was dropped.
+	bool Push(const FWarriorCombatHitRecord& InRecord)
+	{
+		const uint32 CurrentWrite = WriteIndex.load(std::memory_order_relaxed);
+		const uint32 CurrentRead = ReadIndex.load(std::memory_order_acquire);
+
+		if (CurrentWrite - CurrentRead > IndexMask)
+		{
+			return false;
+		}
+
+		Records[CurrentWrite & IndexMask] = InRecord;
+		WriteIndex.store(CurrentWrite + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override
+	{
+		while (!bStopRequested.load(std::memory_order_acquire))
+		{
+			WakeEvent->Wait(FlushIntervalMs);
+			Drain();
+		}
+
+		// Anything pushed before the stop request still makes it to disk
+		Drain();
+
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopRequested.store(true, std::memory_order_release);
+		WakeEvent->Trigger();
+	}
+	//~ End FRunnable Interface
+
+private:
+	void WriteHeader()
+	{
+		if (bBinary)
+		{
+			uint32 Header[] = { WarriorCombatTelemetry::BinaryMagic, WarriorCombatTelemetry::BinaryVersion };
+			FileHandle->Write(reinterpret_cast<const uint8*>(Header), sizeof(Header));
+		}
+		else
+		{
+			WriteString(TEXT("Frame,WorldTime,FrameTimeMs,Attacker,Victim,Damage,LightCombo,HeavyCombo,BlockResult,HitReactDirection,HitReactAngle\n"));
+		}
+	}
+
+	void Drain()
+	{
+		const uint32 CurrentRead = ReadIndex.load(std::memory_order_relaxed);
+		const uint32 CurrentWrite = WriteIndex.load(std::memory_order_acquire);
+
+		if (CurrentRead == CurrentWrite)
+		{
+			return;
+		}
+
+		if (bBinary)
+		{
+			BinaryScratch.Reset();
+			FMemoryWriter Archive(BinaryScratch);
+
+			for (uint32 Index = CurrentRead; Index != CurrentWrite; ++Index)
+			{
+				FWarriorCombatHitRecord& Record = Records[Index & IndexMask];
+
+				FString AttackerName = Record.Attacker.ToString();
+				FString VictimName = Record.Victim.ToString();
+				uint8 BlockResult = static_cast<uint8>(Record.BlockResult);
+				uint8 HitReactDirection = static_cast<uint8>(Record.HitReactDirection);
+
+				Archive << Record.FrameNumber << Record.WorldTimeSeconds << Record.FrameTimeMs;
+				Archive << AttackerName << VictimName;
+				Archive << Record.Damage << Record.LightComboCount << Record.HeavyComboCount;
+				Archive << BlockResult << HitReactDirection << Record.HitReactAngle;
+			}
+
+			// The slots are free again as soon as they have been copied out
+			ReadIndex.store(CurrentWrite, std::memory_order_release);
+
+			FileHandle->Write(BinaryScratch.GetData(), BinaryScratch.Num());
+		}
+		else
+		{
+			TextScratch.Reset();
+
+			for (uint32 Index = CurrentRead; Index != CurrentWrite; ++Index)
+			{
+				const FWarriorCombatHitRecord& Record = Records[Index & IndexMask];
+
+				TextScratch.Appendf(TEXT("%llu,%.4f,%.3f,%s,%s,%.3f,%d,%d,%s,%s,%.1f\n"),
+					Record.FrameNumber,
+					Record.WorldTimeSeconds,
+					Record.FrameTimeMs,
+					*Record.Attacker.ToString(),
+					*Record.Victim.ToString(),
+					Record.Damage,
+					Record.LightComboCount,
+					Record.HeavyComboCount,
+					WarriorCombatTelemetry::BlockResultToString(Record.BlockResult),
+					WarriorCombatTelemetry::HitReactDirectionToString(Record.HitReactDirection),
+					Record.HitReactAngle);
+			}
+
+			ReadIndex.store(CurrentWrite, std::memory_order_release);
+
+			WriteString(TextScratch);
+		}
+
+		FileHandle->Flush();
+	}
+
+	void WriteString(const FString& InString)
+	{
+		const FTCHARToUTF8 Utf8String(*InString);
+		FileHandle->Write(reinterpret_cast<const uint8*>(Utf8String.Get()), Utf8String.Length());
+	}
+
+	TArray<FWarriorCombatHitRecord> Records;
+	uint32 IndexMask = 0;
+
+	std::atomic<uint32> WriteIndex { 0 };
+	std::atomic<uint32> ReadIndex { 0 };
+	std::atomic<bool> bStopRequested { false };
+
+	IFileHandle* FileHandle = nullptr;
+	FEvent* WakeEvent = nullptr;
+	bool bBinary = false;
+	uint32 FlushIntervalMs = 250;
+
+	// Writer thread scratch, reused between drains
+	FString TextScratch;
+	TArray<uint8> BinaryScratch;
+};
+
+bool UWarriorCombatTelemetrySubsystem::bTelemetryEnabled = false;
+
+UWarriorCombatTelemetrySubsystem* UWarriorCombatTelemetrySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorCombatTelemetrySubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorCombatTelemetrySubsystem::Deinitialize()
+{
+	EndSession();
+
+	Super::Deinitialize();
+}
+
+void UWarriorCombatTelemetrySubsystem::RecordDamageHit(AActor* InAttacker, AActor* InVictim, float InDamage, int32 InLightComboCount, int32 InHeavyComboCount)
+{
+	if (!bTelemetryEnabled || !InAttacker || !InVictim)
+	{
+		return;
+	}
+
+	UWarriorCombatTelemetrySubsystem* TelemetrySubsystem = Get(InVictim);
+	if (!TelemetrySubsystem)
+	{
+		return;
+	}
+
+	FWarriorCombatHitRecord Record;
+	Record.Attacker = InAttacker->GetFName();
+	Record.Victim = InVictim->GetFName();
+	Record.Damage = InDamage;
+	Record.LightComboCount = InLightComboCount;
+	Record.HeavyComboCount = InHeavyComboCount;
+
+	// Damage only reaches the calculation when the block failed, so a blocking victim here means the block was broken
+	Record.BlockResult = UWarriorFunctionLibrary::NativeDoesActorHaveStatus(InVictim, EWarriorStatusFlags::Blocking) ? EWarriorTelemetryBlockResult::BlockBroken : EWarriorTelemetryBlockResult::None;
+
+	// Same direction the hit react ability picks
+	const FGameplayTag DirectionTag = UWarriorFunctionLibrary::ComputeHitReactDirectionTag(InAttacker, InVictim, Record.HitReactAngle);
+
+	if (DirectionTag == WarriorGameplayTags::Shared_Status_HitReact_Left)
+	{
+		Record.HitReactDirection = EWarriorTelemetryHitReactDirection::Left;
+	}
+	else if (DirectionTag == WarriorGameplayTags::Shared_Status_HitReact_Right)
+	{
+		Record.HitReactDirection = EWarriorTelemetryHitReactDirection::Right;
+	}
+	else if (DirectionTag == WarriorGameplayTags::Shared_Status_HitReact_Back)
+	{
+		Record.HitReactDirection = EWarriorTelemetryHitReactDirection::Back;
+	}
+
+	TelemetrySubsystem->RecordHit(Record);
+}
+
+void UWarriorCombatTelemetrySubsystem::RecordBlockedHit(AActor* InAttacker, AActor* InVictim)
+{
+	if (!bTelemetryEnabled || !InAttacker || !InVictim)
+	{
+		return;
+	}
+
+	if (UWarriorCombatTelemetrySubsystem* TelemetrySubsystem = Get(InVictim))
+	{
+		FWarriorCombatHitRecord Record;
+		Record.Attacker = InAttacker->GetFName();
+		Record.Victim = InVictim->GetFName();
+		Record.BlockResult = EWarriorTelemetryBlockResult::Blocked;
+
+		TelemetrySubsystem->RecordHit(Record);
+	}
+}
+
+void UWarriorCombatTelemetrySubsystem::RecordHit(FWarriorCombatHitRecord& InOutRecord)
+{
+	check(IsInGameThread());
+
+	if (!bTelemetryEnabled || bSessionFailed)
+	{
+		return;
+	}
+
+	if (!Writer && !BeginSession())
+	{
+		return;
+	}
+
+	InOutRecord.FrameNumber = GFrameCounter;
+	InOutRecord.WorldTimeSeconds = GetWorld()->GetTimeSeconds();
+	InOutRecord.FrameTimeMs = FApp::GetDeltaTime() * 1000.0;
+
+	if (Writer->Push(InOutRecord))
+	{
+		INC_DWORD_STAT(STAT_WarriorTelemetryHitsRecorded);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_WarriorTelemetryHitsDropped);
+	}
+}
+
+void UWarriorCombatTelemetrySubsystem::EndSession()
+{
+	if (WriterThread)
+	{
+		// Kill(true) calls Stop and waits, and Run drains whatever is left before returning
+		WriterThread->Kill(true);
+
+		delete WriterThread;
+		WriterThread = nullptr;
+	}
+
+	delete Writer;
+	Writer = nullptr;
+
+	bSessionFailed = false;
+}
+
+void UWarriorCombatTelemetrySubsystem::OnEnabledChanged(IConsoleVariable* InVariable)
+{
+	bTelemetryEnabled = InVariable->GetBool();
+
+	if (bTelemetryEnabled || !GEngine)
+	{
+		return;
+	}
+
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		if (UWorld* World = WorldContext.World())
+		{
+			if (UWarriorCombatTelemetrySubsystem* TelemetrySubsystem = World->GetSubsystem<UWarriorCombatTelemetrySubsystem>())
+			{
+				TelemetrySubsystem->EndSession();
+			}
+		}
+	}
+}
+
+bool UWarriorCombatTelemetrySubsystem::BeginSession()
+{
+	const bool bBinary = CVarTelemetryFormat.GetValueOnGameThread() == 1;
+
+	const FString Directory = FPaths::ProfilingDir() / TEXT("CombatTelemetry");
+	const FString FilePath = Directory / FString::Printf(TEXT("CombatTelemetry-%s-%s.%s"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString(), bBinary ? TEXT("bin") : TEXT("csv"));
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Directory);
+
+	IFileHandle* FileHandle = PlatformFile.OpenWrite(*FilePath);
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorCombatTelemetrySubsystem: Could not open %s, telemetry is off for this session."), *FilePath);
+		bSessionFailed = true;
+		return false;
+	}
+
+	Writer = new FWarriorCombatTelemetryWriter(FileHandle, bBinary, CVarTelemetryBufferSize.GetValueOnGameThread(), CVarTelemetryFlushInterval.GetValueOnGameThread());
+	WriterThread = FRunnableThread::Create(Writer, TEXT("WarriorCombatTelemetry"), 0, TPri_BelowNormal);
+
+	if (!WriterThread)
+	{
+		delete Writer;
+		Writer = nullptr;
+		bSessionFailed = true;
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UWarriorCombatTelemetrySubsystem: Recording combat hits to %s"), *FPaths::ConvertRelativePathToFull(FilePath));
+
+	return true;
+}
@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorCrowdDensitySubsystem.h"
+#include "Controllers/WarriorAIController.h"
+#include "AI/WarriorCrowdManager.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Density Update"), STAT_WarriorCrowdDensityUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Agents In Melee Rings"), STAT_WarriorCrowdRingAgents, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Agents"), STAT_WarriorCrowdAgents, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarCrowdDensityEnabled(
+	TEXT("Warrior.Crowd.DensityScaling"),
+	true,
+	TEXT("Scales crowd avoidance by local density. When off, agents keep their own avoidance settings."));
+
+static TAutoConsoleVariable<float> CVarCrowdBudgetMs(
+	TEXT("Warrior.Crowd.BudgetMs"),
+	1.5f,
+	TEXT("Crowd simulation time per frame above which every agent is moved one density tier down. Zero disables the budget."));
+
+UWarriorCrowdDensitySubsystem::UWarriorCrowdDensitySubsystem()
+{
+	FWarriorCrowdDensityTier& SparseTier = DensityTiers.AddDefaulted_GetRef();
+	SparseTier.MinNeighbours = 0;
+	SparseTier.MaxAvoidanceQuality = ECrowdAvoidanceQuality::High;
+	SparseTier.MaxQueryRange = 600.f;
+
+	FWarriorCrowdDensityTier& CrowdedTier = DensityTiers.AddDefaulted_GetRef();
+	CrowdedTier.MinNeighbours = 3;
+	CrowdedTier.MaxAvoidanceQuality = ECrowdAvoidanceQuality::Good;
+	CrowdedTier.MaxQueryRange = 450.f;
+
+	FWarriorCrowdDensityTier& DenseTier = DensityTiers.AddDefaulted_GetRef();
+	DenseTier.MinNeighbours = 6;
+	DenseTier.MaxAvoidanceQuality = ECrowdAvoidanceQuality::Low;
+	DenseTier.MaxQueryRange = 300.f;
+}
+
+UWarriorCrowdDensitySubsystem* UWarriorCrowdDensitySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorCrowdDensitySubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorCrowdDensitySubsystem::Deinitialize()
+{
+	RegisteredAgents.Empty();
+	AgentSamples.Empty();
+	AgentsByCell.Empty();
+	RingAgentsByTarget.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorCrowdDensitySubsystem::Tick(float DeltaTime)
+{
+	TimeUntilNextUpdate -= DeltaTime;
+
+	if (TimeUntilNextUpdate > 0.f)
+	{
+		return;
+	}
+
+	TimeUntilNextUpdate = DensityUpdateInterval;
+
+	UpdateDensity();
+}
+
+ETickableTickType UWarriorCrowdDensitySubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorCrowdDensitySubsystem::IsTickable() const
+{
+	return !RegisteredAgents.IsEmpty();
+}
+
+TStatId UWarriorCrowdDensitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorCrowdDensitySubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorCrowdDensitySubsystem::RegisterAgent(AWarriorAIController* InController)
+{
+	check(InController);
+
+	RegisteredAgents.Add(InController);
+}
+
+void UWarriorCrowdDensitySubsystem::UnregisterAgent(AWarriorAIController* InController)
+{
+	RegisteredAgents.Remove(InController);
+}
+
+float UWarriorCrowdDensitySubsystem::GetCrowdSimulationMs() const
+{
+	return UWarriorCrowdManager::GetAverageSimulationMs(GetWorld());
+}
+
+void UWarriorCrowdDensitySubsystem::UpdateDensity()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorCrowdDensityUpdate);
+
+	GatherAgentSamples();
+
+	if (!CVarCrowdDensityEnabled.GetValueOnGameThread() || DensityTiers.IsEmpty())
+	{
+		for (const FAgentSample& Sample : AgentSamples)
+		{
+			Sample.Controller->ApplyCrowdDensitySettings(ECrowdAvoidanceQuality::High, TNumericLimits<float>::Max(), false);
+			Sample.Controller->ClearSurroundSlotLocation();
+		}
+
+		return;
+	}
+
+	CountNeighbours();
+
+	const float BudgetMs = CVarCrowdBudgetMs.GetValueOnGameThread();
+	const bool bOverBudget = BudgetMs > 0.f && GetCrowdSimulationMs() > BudgetMs;
+	const int32 DensestTierIndex = DensityTiers.Num() - 1;
+	const float MeleeRingRadiusSquared = FMath::Square(MeleeRingRadius);
+
+	RingAgentsByTarget.Reset();
+
+	for (int32 SampleIndex = 0; SampleIndex < AgentSamples.Num(); ++SampleIndex)
+	{
+		const FAgentSample& Sample = AgentSamples[SampleIndex];
+		const int32 TierIndex = GetTierIndex(Sample.NumNeighbours, bOverBudget);
+		const FWarriorCrowdDensityTier& Tier = DensityTiers[TierIndex];
+
+		const bool bInMeleeRing = TierIndex == DensestTierIndex
+			&& Sample.Target
+			&& FVector::DistSquared2D(Sample.Location, Sample.Target->GetActorLocation()) <= MeleeRingRadiusSquared;
+
+		Sample.Controller->ApplyCrowdDensitySettings(Tier.MaxAvoidanceQuality, Tier.MaxQueryRange, bInMeleeRing);
+
+		if (bInMeleeRing)
+		{
+			RingAgentsByTarget.FindOrAdd(Sample.Target).Add(SampleIndex);
+		}
+		else
+		{
+			Sample.Controller->ClearSurroundSlotLocation();
+		}
+	}
+
+	int32 NumRingAgents = 0;
+
+	for (TPair<AActor*, TArray<int32>>& RingAgents : RingAgentsByTarget)
+	{
+		NumRingAgents += RingAgents.Value.Num();
+		AssignSurroundSlots(RingAgents.Key, RingAgents.Value);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorCrowdAgents, AgentSamples.Num());
+	SET_DWORD_STAT(STAT_WarriorCrowdRingAgents, NumRingAgents);
+}
+
+void UWarriorCrowdDensitySubsystem::GatherAgentSamples()
+{
+	AgentSamples.Reset();
+
+	for (auto It = RegisteredAgents.CreateIterator(); It; ++It)
+	{
+		AWarriorAIController* Controller = It->Get();
+
+		if (!Controller)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const APawn* Pawn = Controller->GetPawn();
+
+		// Pooled enemies sit hidden in the pool and are not part of any crowd
+		if (!Pawn || Pawn->IsHidden())
+		{
+			continue;
+		}
+
+		FAgentSample& Sample = AgentSamples.AddDefaulted_GetRef();
+		Sample.Controller = Controller;
+		Sample.Location = Pawn->GetActorLocation();
+		Sample.Target = Controller->GetTargetActor();
+	}
+}
+
+void UWarriorCrowdDensitySubsystem::CountNeighbours()
+{
+	// Cells as large as the neighbour radius, so every neighbour is in the 3x3 block around the agent's cell
+	AgentsByCell.Reset();
+
+	for (int32 SampleIndex = 0; SampleIndex < AgentSamples.Num(); ++SampleIndex)
+	{
+		const FVector& Location = AgentSamples[SampleIndex].Location;
+		const FIntPoint Cell(FMath::FloorToInt(Location.X / NeighbourRadius), FMath::FloorToInt(Location.Y / NeighbourRadius));
+
+		AgentsByCell.FindOrAdd(Cell).Add(SampleIndex);
+	}
+
+	const float NeighbourRadiusSquared = FMath::Square(NeighbourRadius);
+
+	for (FAgentSample& Sample : AgentSamples)
+	{
+		const FIntPoint Cell(FMath::FloorToInt(Sample.Location.X / NeighbourRadius), FMath::FloorToInt(Sample.Location.Y / NeighbourRadius));
+
+		for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+			{
+				const TArray<int32, TInlineAllocator<8>>* CellAgents = AgentsByCell.Find(Cell + FIntPoint(OffsetX, OffsetY));
+
+				if (!CellAgents)
+				{
+					continue;
+				}
+
+				for (const int32 OtherIndex : *CellAgents)
+				{
+					if (FVector::DistSquared2D(Sample.Location, AgentSamples[OtherIndex].Location) <= NeighbourRadiusSquared)
+					{
+						++Sample.NumNeighbours;
+					}
+				}
+			}
+		}
+
+		// The agent found itself in its own cell
+		--Sample.NumNeighbours;
+	}
+}
+
+int32 UWarriorCrowdDensitySubsystem::GetTierIndex(int32 InNumNeighbours, bool bInOverBudget) const
+{
+	int32 TierIndex = 0;
+
+	for (int32 Index = DensityTiers.Num() - 1; Index > 0; --Index)
+	{
+		if (InNumNeighbours >= DensityTiers[Index].MinNeighbours)
+		{
+			TierIndex = Index;
+			break;
+		}
+	}
+
+	return bInOverBudget ? FMath::Min(TierIndex + 1, DensityTiers.Num() - 1) : TierIndex;
+}
+
+void UWarriorCrowdDensitySubsystem::AssignSurroundSlots(AActor* InTarget, TArray<int32>& InOutRingAgents)
+{
+	const FVector TargetLocation = InTarget->GetActorLocation();
+
+	auto GetAngleAroundTarget = [this, &TargetLocation](int32 SampleIndex)
+		{
+			const FVector Offset = AgentSamples[SampleIndex].Location - TargetLocation;
+			return FMath::Atan2(Offset.Y, Offset.X);
+		};
+
+	// Handing slots out in angular order keeps every agent next to the neighbours it already has, so nobody crosses the ring
+	InOutRingAgents.Sort([&GetAngleAroundTarget](int32 A, int32 B)
+		{
+			return GetAngleAroundTarget(A) < GetAngleAroundTarget(B);
+		});
+
+	const float SlotStep = UE_TWO_PI / InOutRingAgents.Num();
+
+	// Anchor the ring on the first agent's current angle instead of a fixed world direction
+	const float FirstSlotAngle = GetAngleAroundTarget(InOutRingAgents[0]);
+
+	for (int32 SlotIndex = 0; SlotIndex < InOutRingAgents.Num(); ++SlotIndex)
+	{
+		const float SlotAngle = FirstSlotAngle + SlotStep * SlotIndex;
+		const FVector SlotLocation = TargetLocation + FVector(FMath::Cos(SlotAngle), FMath::Sin(SlotAngle), 0.f) * SurroundSlotRadius;
+
+		AgentSamples[InOutRingAgents[SlotIndex]].Controller->SetSurroundSlotLocation(SlotLocation);
+	}
+}
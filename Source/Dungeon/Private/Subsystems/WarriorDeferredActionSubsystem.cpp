@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorDeferredActionSubsystem.h"
+#include "Engine/World.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Deferred Actions Process"), STAT_WarriorDeferredActionsProcess, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Actions Run"), STAT_WarriorDeferredActionsRun, STATGROUP_Warrior);
+
+UWarriorDeferredActionSubsystem* UWarriorDeferredActionSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorDeferredActionSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorDeferredActionSubsystem::Deinitialize()
+{
+	NextFrameActions.Empty();
+	AfterPhysicsActions.Empty();
+	ActionsToRun.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorDeferredActionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorDeferredActionsProcess);
+
+	// Tickable objects run after every tick group, so physics for this frame has already been fetched
+	ProcessActions(AfterPhysicsActions, false);
+	ProcessActions(NextFrameActions, true);
+}
+
+ETickableTickType UWarriorDeferredActionSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorDeferredActionSubsystem::IsTickable() const
+{
+	return !NextFrameActions.IsEmpty() || !AfterPhysicsActions.IsEmpty();
+}
+
+TStatId UWarriorDeferredActionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorDeferredActionSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorDeferredActionSubsystem::EnqueueAction(const UObject* InOwner, EWarriorDeferredActionPhase InPhase, TFunction<void()>&& InAction)
+{
+	check(InAction);
+
+	FWarriorDeferredAction& NewAction = (InPhase == EWarriorDeferredActionPhase::NextFrame) ? NextFrameActions.AddDefaulted_GetRef() : AfterPhysicsActions.AddDefaulted_GetRef();
+	NewAction.Owner = InOwner;
+	NewAction.Action = MoveTemp(InAction);
+	NewAction.EnqueuedFrame = GFrameCounter;
+}
+
+void UWarriorDeferredActionSubsystem::ProcessActions(TArray<FWarriorDeferredAction>& InOutQueue, bool bOnlyPreviousFrames)
+{
+	if (InOutQueue.IsEmpty())
+	{
+		return;
+	}
+
+	// Move everything that is due into the scratch array first. Actions may enqueue more work while
+	// running, and those must wait for the next pass instead of being picked up here.
+	ActionsToRun.Reset();
+
+	int32 WriteIndex = 0;
+
+	for (int32 ReadIndex = 0; ReadIndex < InOutQueue.Num(); ++ReadIndex)
+	{
+		FWarriorDeferredAction& QueuedAction = InOutQueue[ReadIndex];
+
+		if (!bOnlyPreviousFrames || QueuedAction.EnqueuedFrame < GFrameCounter)
+		{
+			ActionsToRun.Add(MoveTemp(QueuedAction));
+		}
+		else
+		{
+			if (WriteIndex != ReadIndex)
+			{
+				InOutQueue[WriteIndex] = MoveTemp(QueuedAction);
+			}
+
+			++WriteIndex;
+		}
+	}
+
+	InOutQueue.SetNum(WriteIndex, EAllowShrinking::No);
+
+	for (FWarriorDeferredAction& DeferredAction : ActionsToRun)
+	{
+		if (DeferredAction.Owner.IsValid())
+		{
+			DeferredAction.Action();
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_WarriorDeferredActionsRun, ActionsToRun.Num());
+
+	ActionsToRun.Reset();
+}
@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorEnemyPoolSubsystem.h"
+#include "Characters/WarriorEnemyCharacter.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Pool Acquire"), STAT_WarriorEnemyPoolAcquire, STATGROUP_Warrior);
+DECLARE_CYCLE_STAT(TEXT("Enemy Pool Prewarm"), STAT_WarriorEnemyPoolPrewarm, STATGROUP_Warrior);
+DECLARE_CYCLE_STAT(TEXT("Enemy Spawn Location Query"), STAT_WarriorEnemySpawnLocationQuery, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy Pool Misses"), STAT_WarriorEnemyPoolMisses, STATGROUP_Warrior);
+
+UWarriorEnemyPoolSubsystem* UWarriorEnemyPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorEnemyPoolSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorEnemyPoolSubsystem::Deinitialize()
+{
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorEnemyPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!InWorld.IsGameWorld())
+	{
+		return;
+	}
+
+	for (const FWarriorEnemyPoolPrewarmEntry& PrewarmEntry : PrewarmEntries)
+	{
+		PrewarmEnemies(PrewarmEntry.EnemyClass, PrewarmEntry.Count);
+	}
+}
+
+void UWarriorEnemyPoolSubsystem::PrewarmEnemies(TSoftClassPtr<AWarriorEnemyCharacter> InEnemyClass, int32 InCount)
+{
+	if (InEnemyClass.IsNull() || InCount <= 0)
+	{
+		return;
+	}
+
+	if (InEnemyClass.Get())
+	{
+		OnPrewarmClassLoaded(InEnemyClass, InCount);
+		return;
+	}
+
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		InEnemyClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnPrewarmClassLoaded, InEnemyClass, InCount)
+	);
+}
+
+AWarriorEnemyCharacter* UWarriorEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<AWarriorEnemyCharacter> InEnemyClass, const FTransform& InTransform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEnemyPoolAcquire);
+
+	if (!InEnemyClass)
+	{
+		return nullptr;
+	}
+
+	AWarriorEnemyCharacter* Enemy = nullptr;
+
+	if (FWarriorEnemyPoolBucket* Bucket = Buckets.Find(InEnemyClass.Get()))
+	{
+		while (!Enemy && !Bucket->FreeEnemies.IsEmpty())
+		{
+			Enemy = Bucket->FreeEnemies.Pop(EAllowShrinking::No);
+
+			if (!IsValid(Enemy))
+			{
+				Enemy = nullptr;
+			}
+		}
+	}
+
+	if (!Enemy)
+	{
+		INC_DWORD_STAT(STAT_WarriorEnemyPoolMisses);
+
+		Enemy = SpawnPooledEnemy(InEnemyClass, InTransform);
+		if (!Enemy)
+		{
+			return nullptr;
+		}
+	}
+
+	Enemy->ActivateFromPool(InTransform);
+
+	return Enemy;
+}
+
+void UWarriorEnemyPoolSubsystem::ReleaseEnemy(AWarriorEnemyCharacter* InEnemy)
+{
+	// An enemy being destroyed is dropped by OnPooledEnemyDestroyed, it must not be parked again
+	if (!IsValid(InEnemy) || InEnemy->IsActorBeingDestroyed())
+	{
+		return;
+	}
+
+	FWarriorEnemyPoolBucket* Bucket = InEnemy->IsPooled() ? Buckets.Find(InEnemy->GetClass()) : nullptr;
+	if (!Bucket)
+	{
+		InEnemy->Destroy();
+		return;
+	}
+
+	if (Bucket->FreeEnemies.Contains(InEnemy))
+	{
+		return;
+	}
+
+	InEnemy->DeactivateForPool();
+	Bucket->FreeEnemies.Add(InEnemy);
+}
+
+int32 UWarriorEnemyPoolSubsystem::GetNumFreeEnemies(TSubclassOf<AWarriorEnemyCharacter> InEnemyClass) const
+{
+	const FWarriorEnemyPoolBucket* Bucket = Buckets.Find(InEnemyClass.Get());
+	return Bucket ? Bucket->FreeEnemies.Num() : 0;
+}
+
+int32 UWarriorEnemyPoolSubsystem::QueryNavigableSpawnLocations(const UObject* WorldContextObject, const FVector& InOrigin, float InRadius, int32 InCount, TArray<FVector>& OutLocations)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEnemySpawnLocationQuery);
+
+	OutLocations.Reset(InCount);
+
+	if (InCount <= 0)
+	{
+		return 0;
+	}
+
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+	// Uniform random points on the disc around the origin, all projected in one batch below
+	TArray<FNavigationProjectionWork> ProjectionWork;
+	ProjectionWork.Reserve(InCount);
+
+	for (int32 i = 0; i < InCount; i++)
+	{
+		const float Angle = FMath::FRandRange(0.f, UE_TWO_PI);
+		const float Distance = InRadius * FMath::Sqrt(FMath::FRand());
+
+		ProjectionWork.Emplace(InOrigin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.f));
+	}
+
+	const FVector ProjectionExtent(InRadius * 0.25f, InRadius * 0.25f, 500.f);
+	FNavLocation NavOrigin;
+
+	// Without a navmesh under the origin nothing can be checked for reachability, the enemies spread over the disc
+	// and rely on the spawn collision handling instead
+	if (!NavData || !NavData->ProjectPoint(InOrigin, NavOrigin, ProjectionExtent))
+	{
+		for (const FNavigationProjectionWork& Work : ProjectionWork)
+		{
+			OutLocations.Add(Work.Point);
+		}
+
+		return 0;
+	}
+
+	NavData->BatchProjectPoints(ProjectionWork, ProjectionExtent);
+
+	// A point that projects onto an island or behind a wall is not reachable from the origin. Raycasting along the
+	// navmesh from the origin keeps every point reachable: a blocked ray stops at the last reachable location, and
+	// points that missed the navmesh are walked toward the same way. All rays go through one batched query.
+	TArray<FNavigationRaycastWork> RaycastWork;
+	RaycastWork.Reserve(InCount);
+
+	for (const FNavigationProjectionWork& Work : ProjectionWork)
+	{
+		const FVector RayEnd = Work.bResult ? Work.OutLocation.Location : FVector(Work.Point.X, Work.Point.Y, NavOrigin.Location.Z);
+		RaycastWork.Emplace(NavOrigin.Location, RayEnd);
+	}
+
+	NavData->BatchRaycast(RaycastWork, NavData->GetDefaultQueryFilter());
+
+	// Distance kept from the wall a blocked ray stopped at, so the capsule is not placed into it
+	const float WallClearance = 50.f;
+	int32 NumReachable = 0;
+
+	for (int32 i = 0; i < RaycastWork.Num(); i++)
+	{
+		const FNavigationRaycastWork& Work = RaycastWork[i];
+
+		if (!Work.bDidHit)
+		{
+			OutLocations.Add(Work.RayEnd);
+			NumReachable += ProjectionWork[i].bResult ? 1 : 0;
+		}
+		else
+		{
+			const FVector ToOrigin = Work.RayStart - Work.HitLocation.Location;
+			OutLocations.Add(Work.HitLocation.Location + ToOrigin.GetClampedToMaxSize(WallClearance));
+		}
+	}
+
+	return NumReachable;
+}
+
+AWarriorEnemyCharacter* UWarriorEnemyPoolSubsystem::SpawnPooledEnemy(UClass* InEnemyClass, const FTransform& InTransform, bool bInParked)
+{
+	UWorld* World = GetWorld();
+	check(World);
+
+	AWarriorEnemyCharacter* Enemy = World->SpawnActorDeferred<AWarriorEnemyCharacter>(InEnemyClass, InTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Enemy)
+	{
+		return nullptr;
+	}
+
+	// Parked enemies never show up or touch anything, not even for the frame they are spawned in
+	if (bInParked)
+	{
+		Enemy->SetActorHiddenInGame(true);
+		Enemy->SetActorEnableCollision(false);
+	}
+
+	// Finishing the spawn possesses the enemy with its AI controller, which grants the start up abilities
+	Enemy->FinishSpawning(InTransform);
+
+	Enemy->SetPooled(true);
+	Enemy->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnPooledEnemyDestroyed);
+
+	++Buckets.FindOrAdd(InEnemyClass).NumOwned;
+
+	return Enemy;
+}
+
+void UWarriorEnemyPoolSubsystem::OnPrewarmClassLoaded(TSoftClassPtr<AWarriorEnemyCharacter> InEnemyClass, int32 InCount)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorEnemyPoolPrewarm);
+
+	UClass* LoadedClass = InEnemyClass.Get();
+	if (!LoadedClass || !GetWorld())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorEnemyPoolSubsystem: Failed to load %s for prewarming"), *InEnemyClass.ToString());
+		return;
+	}
+
+	// Spawn tasks never take enemies of this class from the pool, so prewarmed ones would only sit there
+	if (!LoadedClass->GetDefaultObject<AWarriorEnemyCharacter>()->UsesEnemyPool())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorEnemyPoolSubsystem: %s does not have bUseEnemyPool set, skipping prewarm"), *LoadedClass->GetName());
+		return;
+	}
+
+	const int32 NumOwned = Buckets.FindOrAdd(LoadedClass).NumOwned;
+
+	// Out of the playable space, but above KillZ so nothing treats the parked enemies as fallen out of the world
+	FVector ParkingLocation = PrewarmParkingLocation;
+
+	if (const AWorldSettings* WorldSettings = GetWorld()->GetWorldSettings())
+	{
+		ParkingLocation.Z = FMath::Max(ParkingLocation.Z, WorldSettings->KillZ + 1000.f);
+	}
+
+	const FTransform ParkingTransform(ParkingLocation);
+
+	for (int32 i = NumOwned; i < InCount; i++)
+	{
+		if (AWarriorEnemyCharacter* Enemy = SpawnPooledEnemy(LoadedClass, ParkingTransform, true))
+		{
+			Enemy->DeactivateForPool();
+			Buckets.FindChecked(LoadedClass).FreeEnemies.Add(Enemy);
+		}
+	}
+}
+
+void UWarriorEnemyPoolSubsystem::OnPooledEnemyDestroyed(AActor* DestroyedActor)
+{
+	if (FWarriorEnemyPoolBucket* Bucket = Buckets.Find(DestroyedActor->GetClass()))
+	{
+		Bucket->FreeEnemies.RemoveSingleSwap(Cast<AWarriorEnemyCharacter>(DestroyedActor), EAllowShrinking::No);
+		--Bucket->NumOwned;
+	}
+}
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorFacingSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "Engine/World.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Facing Update"), STAT_WarriorFacingUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Facing Intents"), STAT_WarriorFacingIntents, STATGROUP_Warrior);
+
+UWarriorFacingSubsystem* UWarriorFacingSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorFacingSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorFacingSubsystem::Deinitialize()
+{
+	Intents.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorFacingIntents, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorFacingSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorFacingUpdate);
+
+	for (int32 Index = Intents.Num() - 1; Index >= 0; --Index)
+	{
+		FWarriorFacingIntent& Intent = Intents[Index];
+
+		APawn* Pawn = Intents.GetPawn(Index);
+		const AActor* Target = Intent.Target.Get();
+
+		if (!Pawn || !Target)
+		{
+			Intents.RemoveAt(Index);
+			continue;
+		}
+
+		const FVector ToTarget = Target->GetActorLocation() - Pawn->GetActorLocation();
+		const FRotator CurrentRotation = Pawn->GetActorRotation();
+
+		if (ToTarget.IsNearlyZero2D())
+		{
+			Intent.bHasReachedAnglePrecision = true;
+			continue;
+		}
+
+		// Same step as RInterpTo on the yaw axis
+		const float DesiredYaw = FMath::RadiansToDegrees(FMath::Atan2(ToTarget.Y, ToTarget.X));
+		const float YawDelta = FRotator::NormalizeAxis(DesiredYaw - CurrentRotation.Yaw);
+		const float YawStep = Intent.InterpSpeed > 0.f ? YawDelta * FMath::Clamp(DeltaTime * Intent.InterpSpeed, 0.f, 1.f) : YawDelta;
+
+		Intent.bHasReachedAnglePrecision = FMath::Abs(YawDelta - YawStep) <= Intent.AnglePrecision;
+
+		if (FMath::IsNearlyZero(YawStep, KINDA_SMALL_NUMBER))
+		{
+			continue;
+		}
+
+		const FRotator NewRotation(CurrentRotation.Pitch, CurrentRotation.Yaw + YawStep, CurrentRotation.Roll);
+
+		if (UPawnMovementComponent* MovementComponent = Pawn->GetMovementComponent())
+		{
+			MovementComponent->MoveUpdatedComponent(FVector::ZeroVector, NewRotation.Quaternion(), false);
+		}
+		else
+		{
+			Pawn->SetActorRotation(NewRotation);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorFacingIntents, Intents.Num());
+}
+
+ETickableTickType UWarriorFacingSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorFacingSubsystem::IsTickable() const
+{
+	return !Intents.IsEmpty();
+}
+
+TStatId UWarriorFacingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorFacingSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorFacingSubsystem::SetFacingTarget(APawn* InPawn, AActor* InTarget, float InInterpSpeed, float InAnglePrecision, const UObject* InRequester, int32 InPriority)
+{
+	check(InPawn && InTarget);
+
+	FWarriorFacingIntent* Intent = Intents.Find(InPawn);
+
+	if (Intent)
+	{
+		// e.g. an orient service ticking under a running rotate task must not take the slot from it
+		if (Intent->Requester != InRequester && Intent->Requester.IsValid() && Intent->Priority > InPriority)
+		{
+			return;
+		}
+
+		// A new target has not been measured yet, so the last result does not apply to it
+		if (Intent->Target != InTarget)
+		{
+			Intent->bHasReachedAnglePrecision = GetYawDeltaToTarget(InPawn, InTarget) <= InAnglePrecision;
+		}
+	}
+	else
+	{
+		Intent = &Intents.Add(InPawn);
+		Intent->bHasReachedAnglePrecision = GetYawDeltaToTarget(InPawn, InTarget) <= InAnglePrecision;
+	}
+
+	Intent->Target = InTarget;
+	Intent->Requester = InRequester;
+	Intent->InterpSpeed = InInterpSpeed;
+	Intent->AnglePrecision = InAnglePrecision;
+	Intent->Priority = InPriority;
+}
+
+void UWarriorFacingSubsystem::ClearFacingTarget(APawn* InPawn, const UObject* InRequester)
+{
+	const FWarriorFacingIntent* Intent = Intents.Find(InPawn);
+
+	if (Intent && Intent->Requester == InRequester)
+	{
+		Intents.Remove(InPawn);
+	}
+}
+
+bool UWarriorFacingSubsystem::GetHasReachedAnglePrecision(const APawn* InPawn, const UObject* InRequester, bool& OutHasReached) const
+{
+	const FWarriorFacingIntent* Intent = Intents.Find(InPawn);
+
+	// Another requester may use a different precision, so its result does not answer this one
+	if (Intent && Intent->Requester == InRequester)
+	{
+		OutHasReached = Intent->bHasReachedAnglePrecision;
+		return true;
+	}
+
+	return false;
+}
+
+float UWarriorFacingSubsystem::GetYawDeltaToTarget(const APawn* InPawn, const AActor* InTarget)
+{
+	const FVector ToTarget = InTarget->GetActorLocation() - InPawn->GetActorLocation();
+
+	if (ToTarget.IsNearlyZero2D())
+	{
+		return 0.f;
+	}
+
+	const float DesiredYaw = FMath::RadiansToDegrees(FMath::Atan2(ToTarget.Y, ToTarget.X));
+
+	return FMath::Abs(FRotator::NormalizeAxis(DesiredYaw - InPawn->GetActorRotation().Yaw));
+}
@@ -0,0 +1,188 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorHealthBarSubsystem.h"
+#include "Subsystems/WarriorWorldMarkerSubsystem.h"
+#include "Widgets/WarriorHealthBarLayerWidget.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Health Bar Update"), STAT_WarriorHealthBarUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Health Bars Tracked"), STAT_WarriorHealthBarsTracked, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Health Bars Drawn"), STAT_WarriorHealthBarsDrawn, STATGROUP_Warrior);
+
+UWarriorHealthBarSubsystem* UWarriorHealthBarSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorHealthBarSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorHealthBarSubsystem::Deinitialize()
+{
+	if (LayerWidget)
+	{
+		LayerWidget->RemoveFromParent();
+		LayerWidget = nullptr;
+	}
+
+	TrackedBars.Empty();
+	VisibleBars.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorHealthBarsTracked, 0);
+	SET_DWORD_STAT(STAT_WarriorHealthBarsDrawn, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorHealthBarSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorHealthBarUpdate);
+
+	VisibleBars.Reset();
+
+	EnsureLayerWidget();
+
+	UWarriorWorldMarkerSubsystem* WorldMarkerSubsystem = GetWorld()->GetSubsystem<UWarriorWorldMarkerSubsystem>();
+
+	if (!LayerWidget || !WorldMarkerSubsystem)
+	{
+		return;
+	}
+
+	WorldMarkerSubsystem->UpdateCachedView();
+
+	const FVector ViewOrigin = WorldMarkerSubsystem->GetCachedViewOrigin();
+	const FVector2D ViewportSize = WorldMarkerSubsystem->GetViewportWidgetSize();
+	const float MaxDrawDistanceSquared = FMath::Square(MaxDrawDistance);
+
+	for (int32 Index = TrackedBars.Num() - 1; Index >= 0; --Index)
+	{
+		const FTrackedHealthBar& TrackedBar = TrackedBars[Index];
+		const APawn* Pawn = TrackedBars.GetPawn(Index);
+
+		if (!Pawn)
+		{
+			TrackedBars.RemoveAt(Index);
+			continue;
+		}
+
+		// Pooled and dead enemies, and optionally untouched ones, show no bar
+		if (Pawn->IsHidden() || TrackedBar.HealthFraction <= 0.f || (bHideAtFullHealth && TrackedBar.HealthFraction >= 1.f))
+		{
+			continue;
+		}
+
+		const FVector BarLocation = Pawn->GetActorLocation() + FVector(0.f, 0.f, TrackedBar.HeightOffset);
+
+		if (FVector::DistSquared(ViewOrigin, BarLocation) > MaxDrawDistanceSquared)
+		{
+			continue;
+		}
+
+		// The renderer's own visibility and occlusion result from the last frames, free compared to a trace
+		if (!Pawn->WasRecentlyRendered(RecentlyRenderedTolerance))
+		{
+			continue;
+		}
+
+		FVector2D WidgetPosition;
+
+		if (!WorldMarkerSubsystem->ProjectToWidget(BarLocation, WidgetPosition))
+		{
+			continue;
+		}
+
+		if (WidgetPosition.X < 0.f || WidgetPosition.Y < 0.f || WidgetPosition.X > ViewportSize.X || WidgetPosition.Y > ViewportSize.Y)
+		{
+			continue;
+		}
+
+		FWarriorHealthBarDrawData& DrawData = VisibleBars.AddDefaulted_GetRef();
+		DrawData.Position = WidgetPosition;
+		DrawData.HealthFraction = TrackedBar.HealthFraction;
+	}
+
+	SET_DWORD_STAT(STAT_WarriorHealthBarsTracked, TrackedBars.Num());
+	SET_DWORD_STAT(STAT_WarriorHealthBarsDrawn, VisibleBars.Num());
+}
+
+ETickableTickType UWarriorHealthBarSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorHealthBarSubsystem::IsTickable() const
+{
+	return !TrackedBars.IsEmpty() || !VisibleBars.IsEmpty();
+}
+
+TStatId UWarriorHealthBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorHealthBarSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorHealthBarSubsystem::RegisterHealthBar(APawn* InPawn, float InHealthFraction)
+{
+	check(InPawn);
+
+	if (FTrackedHealthBar* ExistingBar = TrackedBars.Find(InPawn))
+	{
+		ExistingBar->HealthFraction = FMath::Clamp(InHealthFraction, 0.f, 1.f);
+		return;
+	}
+
+	FTrackedHealthBar& TrackedBar = TrackedBars.Add(InPawn);
+	TrackedBar.HeightOffset = InPawn->GetSimpleCollisionHalfHeight() + HeightAboveCollision;
+	TrackedBar.HealthFraction = FMath::Clamp(InHealthFraction, 0.f, 1.f);
+}
+
+void UWarriorHealthBarSubsystem::UnregisterHealthBar(APawn* InPawn)
+{
+	TrackedBars.Remove(InPawn);
+}
+
+void UWarriorHealthBarSubsystem::SetHealthFraction(APawn* InPawn, float InHealthFraction)
+{
+	if (FTrackedHealthBar* ExistingBar = TrackedBars.Find(InPawn))
+	{
+		ExistingBar->HealthFraction = FMath::Clamp(InHealthFraction, 0.f, 1.f);
+	}
+}
+
+void UWarriorHealthBarSubsystem::EnsureLayerWidget()
+{
+	if (LayerWidget)
+	{
+		return;
+	}
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+
+	if (!PlayerController || !PlayerController->IsLocalController())
+	{
+		return;
+	}
+
+	TSubclassOf<UWarriorHealthBarLayerWidget> WidgetClass = LayerWidgetClass.IsNull() ? UWarriorHealthBarLayerWidget::StaticClass() : LayerWidgetClass.LoadSynchronous();
+
+	if (!WidgetClass)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorHealthBarSubsystem: LayerWidgetClass %s failed to load, using the native layer"), *LayerWidgetClass.ToString());
+		WidgetClass = UWarriorHealthBarLayerWidget::StaticClass();
+	}
+
+	LayerWidget = CreateWidget<UWarriorHealthBarLayerWidget>(PlayerController, WidgetClass);
+	check(LayerWidget);
+
+	LayerWidget->SetHealthBarSource(this);
+	LayerWidget->AddToViewport(LayerZOrder);
+}
@@ -0,0 +1,273 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorHitPauseSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hit Pause Update"), STAT_WarriorHitPauseUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Pause Requests"), STAT_WarriorHitPauseRequests, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hit Pause Actors"), STAT_WarriorHitPauseActors, STATGROUP_Warrior);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Hit Pause Seconds Per Minute"), STAT_WarriorHitPauseSecondsPerMinute, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarHitPauseEnabled(
+	TEXT("Warrior.HitPause.Enabled"),
+	true,
+	TEXT("Enables hit pause. When off, requests are ignored."));
+
+static TAutoConsoleVariable<float> CVarHitPauseMinTimeDilation(
+	TEXT("Warrior.HitPause.MinTimeDilation"),
+	0.05f,
+	TEXT("CustomTimeDilation applied to paused actors at full intensity."));
+
+static TAutoConsoleVariable<float> CVarHitPauseDuration(
+	TEXT("Warrior.HitPause.Duration"),
+	0.08f,
+	TEXT("Real seconds a full intensity hit pause lasts."));
+
+static TAutoConsoleVariable<float> CVarHitPauseBudgetWindow(
+	TEXT("Warrior.HitPause.BudgetWindow"),
+	1.f,
+	TEXT("Length in real seconds of the rolling window the pause budget is measured over."));
+
+static TAutoConsoleVariable<float> CVarHitPauseBudgetSeconds(
+	TEXT("Warrior.HitPause.BudgetSeconds"),
+	0.25f,
+	TEXT("Maximum real seconds of hit pause granted inside one budget window."));
+
+namespace WarriorHitPause
+{
+	// Length of the history kept for the per-minute stat
+	static constexpr double StatWindowSeconds = 60.0;
+}
+
+UWarriorHitPauseSubsystem* UWarriorHitPauseSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorHitPauseSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorHitPauseSubsystem::Deinitialize()
+{
+	RestorePausedActors();
+
+	PendingActors.Empty();
+	PauseHistory.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorHitPauseSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorHitPauseUpdate);
+
+	const double RealTime = GetRealTime();
+
+	FlushPendingRequests(RealTime);
+
+	if (!PausedActors.IsEmpty() && RealTime >= ActivePauseEndRealTime)
+	{
+		RestorePausedActors();
+	}
+
+	TrimPauseHistory(RealTime);
+
+	SET_DWORD_STAT(STAT_WarriorHitPauseActors, PausedActors.Num());
+	SET_FLOAT_STAT(STAT_WarriorHitPauseSecondsPerMinute, GetPauseSecondsLastMinute());
+}
+
+ETickableTickType UWarriorHitPauseSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorHitPauseSubsystem::IsTickable() const
+{
+	// Keep ticking while history remains so the per-minute stat decays back to zero
+	return PendingIntensity >= 0.f || !PausedActors.IsEmpty() || !PauseHistory.IsEmpty();
+}
+
+TStatId UWarriorHitPauseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorHitPauseSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorHitPauseSubsystem::RequestHitPause(AActor* InInstigator, AActor* InTarget, float InIntensity)
+{
+	if (!CVarHitPauseEnabled.GetValueOnGameThread() || InIntensity <= 0.f)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_WarriorHitPauseRequests);
+
+	PendingIntensity = FMath::Max(PendingIntensity, FMath::Min(InIntensity, 1.f));
+
+	if (InInstigator)
+	{
+		PendingActors.AddUnique(InInstigator);
+	}
+
+	if (InTarget)
+	{
+		PendingActors.AddUnique(InTarget);
+	}
+}
+
+void UWarriorHitPauseSubsystem::CancelHitPause()
+{
+	PendingIntensity = -1.f;
+	PendingActors.Reset();
+
+	RestorePausedActors();
+}
+
+float UWarriorHitPauseSubsystem::GetPauseSecondsLastMinute() const
+{
+	return GetGrantedPauseSince(GetRealTime() - WarriorHitPause::StatWindowSeconds);
+}
+
+void UWarriorHitPauseSubsystem::FlushPendingRequests(double InRealTime)
+{
+	if (PendingIntensity < 0.f)
+	{
+		return;
+	}
+
+	const float Intensity = PendingIntensity;
+	PendingIntensity = -1.f;
+
+	// Whatever the budget window has left caps this pause. Time still to run on the active pause is already spent.
+	const float BudgetSeconds = CVarHitPauseBudgetSeconds.GetValueOnGameThread();
+	const float BudgetUsed = GetGrantedPauseSince(InRealTime - CVarHitPauseBudgetWindow.GetValueOnGameThread());
+	const float RequestedDuration = CVarHitPauseDuration.GetValueOnGameThread() * Intensity;
+	const float Duration = FMath::Min(RequestedDuration, BudgetSeconds - BudgetUsed);
+
+	if (Duration <= KINDA_SMALL_NUMBER)
+	{
+		PendingActors.Reset();
+		return;
+	}
+
+	const double NewEndRealTime = InRealTime + Duration;
+	const float NewTimeDilation = FMath::Lerp(1.f, CVarHitPauseMinTimeDilation.GetValueOnGameThread(), Intensity);
+
+	if (!PausedActors.IsEmpty())
+	{
+		// Only the part that extends past the active pause counts as new pause time
+		if (NewEndRealTime > ActivePauseEndRealTime)
+		{
+			FGrantedPause& Extension = PauseHistory.AddDefaulted_GetRef();
+			Extension.StartRealTime = FMath::Max(InRealTime, ActivePauseEndRealTime);
+			Extension.Duration = NewEndRealTime - Extension.StartRealTime;
+
+			ActivePauseEndRealTime = NewEndRealTime;
+		}
+
+		ActiveTimeDilation = FMath::Min(ActiveTimeDilation, NewTimeDilation);
+	}
+	else
+	{
+		FGrantedPause& GrantedPause = PauseHistory.AddDefaulted_GetRef();
+		GrantedPause.StartRealTime = InRealTime;
+		GrantedPause.Duration = Duration;
+
+		ActivePauseEndRealTime = NewEndRealTime;
+		ActiveTimeDilation = NewTimeDilation;
+	}
+
+	for (const TWeakObjectPtr<AActor>& PendingActor : PendingActors)
+	{
+		if (!PendingActor.IsValid() || PausedActors.Contains(PendingActor))
+		{
+			continue;
+		}
+
+		PausedActors.Add(PendingActor, PendingActor->CustomTimeDilation);
+	}
+
+	PendingActors.Reset();
+
+	for (const TPair<TWeakObjectPtr<AActor>, float>& PausedActor : PausedActors)
+	{
+		if (AActor* Actor = PausedActor.Key.Get())
+		{
+			Actor->CustomTimeDilation = PausedActor.Value * ActiveTimeDilation;
+		}
+	}
+}
+
+void UWarriorHitPauseSubsystem::RestorePausedActors()
+{
+	if (PausedActors.IsEmpty())
+	{
+		return;
+	}
+
+	for (const TPair<TWeakObjectPtr<AActor>, float>& PausedActor : PausedActors)
+	{
+		if (AActor* Actor = PausedActor.Key.Get())
+		{
+			Actor->CustomTimeDilation = PausedActor.Value;
+		}
+	}
+
+	PausedActors.Reset();
+	ActiveTimeDilation = 1.f;
+
+	// A cancelled pause only counts up to now
+	const double RealTime = GetRealTime();
+	if (!PauseHistory.IsEmpty())
+	{
+		FGrantedPause& LastPause = PauseHistory.Last();
+		LastPause.Duration = FMath::Max(0.f, FMath::Min(LastPause.Duration, static_cast<float>(RealTime - LastPause.StartRealTime)));
+	}
+}
+
+float UWarriorHitPauseSubsystem::GetGrantedPauseSince(double InWindowStart) const
+{
+	float GrantedSeconds = 0.f;
+
+	for (const FGrantedPause& GrantedPause : PauseHistory)
+	{
+		const double PauseEnd = GrantedPause.StartRealTime + GrantedPause.Duration;
+		if (PauseEnd <= InWindowStart)
+		{
+			continue;
+		}
+
+		GrantedSeconds += PauseEnd - FMath::Max(GrantedPause.StartRealTime, InWindowStart);
+	}
+
+	return GrantedSeconds;
+}
+
+void UWarriorHitPauseSubsystem::TrimPauseHistory(double InRealTime)
+{
+	const double OldestKept = InRealTime - WarriorHitPause::StatWindowSeconds;
+
+	int32 NumExpired = 0;
+	while (NumExpired < PauseHistory.Num() && PauseHistory[NumExpired].StartRealTime + PauseHistory[NumExpired].Duration <= OldestKept)
+	{
+		++NumExpired;
+	}
+
+	if (NumExpired > 0)
+	{
+		PauseHistory.RemoveAt(0, NumExpired, EAllowShrinking::No);
+	}
+}
+
+double UWarriorHitPauseSubsystem::GetRealTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetRealTimeSeconds() : 0.0;
+}
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorHitReactSubsystem.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "Engine/World.h"
+#include "WarriorGameplayTags.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hit React Flush"), STAT_WarriorHitReactFlush, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Reacts Queued"), STAT_WarriorHitReactsQueued, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hit Reacts Sent"), STAT_WarriorHitReactsSent, STATGROUP_Warrior);
+
+UWarriorHitReactSubsystem* UWarriorHitReactSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorHitReactSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorHitReactSubsystem::Deinitialize()
+{
+	PendingHitReacts.Empty();
+	HitReactsToSend.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWarriorHitReactSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorHitReactFlush);
+
+	Swap(PendingHitReacts, HitReactsToSend);
+
+	for (TPair<TWeakObjectPtr<AActor>, FGameplayEventData>& HitReact : HitReactsToSend)
+	{
+		if (AActor* Victim = HitReact.Key.Get())
+		{
+			UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
+				Victim,
+				WarriorGameplayTags::Shared_Event_HitReact,
+				HitReact.Value
+			);
+
+			INC_DWORD_STAT(STAT_WarriorHitReactsSent);
+		}
+	}
+
+	HitReactsToSend.Reset();
+}
+
+ETickableTickType UWarriorHitReactSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorHitReactSubsystem::IsTickable() const
+{
+	return !PendingHitReacts.IsEmpty();
+}
+
+TStatId UWarriorHitReactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorHitReactSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorHitReactSubsystem::QueueHitReact(AActor* InVictim, const FGameplayEventData& InPayload)
+{
+	check(InVictim);
+
+	FGameplayEventData& QueuedPayload = PendingHitReacts.FindOrAdd(InVictim);
+	QueuedPayload = InPayload;
+	QueuedPayload.EventTag = WarriorGameplayTags::Shared_Event_HitReact;
+
+	INC_DWORD_STAT(STAT_WarriorHitReactsQueued);
+}
+
+void UWarriorHitReactSubsystem::QueueOrSendHitReact(AActor* InVictim, const FGameplayEventData& InPayload)
+{
+	if (!InVictim)
+	{
+		return;
+	}
+
+	if (UWarriorHitReactSubsystem* HitReactSubsystem = Get(InVictim))
+	{
+		HitReactSubsystem->QueueHitReact(InVictim, InPayload);
+	}
+	else
+	{
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(InVictim, WarriorGameplayTags::Shared_Event_HitReact, InPayload);
+	}
+}
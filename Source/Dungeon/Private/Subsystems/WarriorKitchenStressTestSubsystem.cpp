@@ -0,0 +1,428 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorKitchenStressTestSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/DataTable.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "InteractablePot.h"
+#include "Inventory/CookingRecipeStruct.h"
+#include "Inventory/InventoryItemActor.h"
+#include "Inventory/InventoryComponent.h"
+#include "Characters/WarriorHeroCharacter.h"
+#include "WarriorStats.h"
+
+static TAutoConsoleVariable<float> CVarKitchenStressBudgetFrameMs(
+	TEXT("Warrior.KitchenStressTest.Budget.FrameMs"),
+	33.3f,
+	TEXT("P95 frame time budget in milliseconds for the kitchen stress test."));
+
+static TAutoConsoleVariable<float> CVarKitchenStressBudgetGameThreadMs(
+	TEXT("Warrior.KitchenStressTest.Budget.GameThreadMs"),
+	16.6f,
+	TEXT("P95 game thread time budget in milliseconds for the kitchen stress test."));
+
+static TAutoConsoleVariable<float> CVarKitchenStressBudgetSliceMs(
+	TEXT("Warrior.KitchenStressTest.Budget.SliceMs"),
+	4.f,
+	TEXT("P95 budget in milliseconds for a single AInventoryItemActor::SliceItem call."));
+
+static TAutoConsoleVariable<float> CVarKitchenStressBudgetInventoryUIMs(
+	TEXT("Warrior.KitchenStressTest.Budget.InventoryUIMs"),
+	1.f,
+	TEXT("P95 budget in milliseconds for UInventoryComponent::UpdateInventoryUI."));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs GKitchenStressTestCommand(
+	TEXT("Warrior.KitchenStressTest"),
+	TEXT("Runs the kitchen stress scenario and writes a frame-time report. Args: Pots= Minigames= Items= Warmup= Frames= Seed= PotClass= ItemClass="),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UWarriorKitchenStressTestSubsystem* StressTestSubsystem = World ? World->GetSubsystem<UWarriorKitchenStressTestSubsystem>() : nullptr;
+		if (!StressTestSubsystem)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Warrior.KitchenStressTest: No game world to run in."));
+			return;
+		}
+
+		const FString JoinedArgs = FString::Join(Args, TEXT(" "));
+
+		FWarriorKitchenStressTestSettings Settings;
+		FParse::Value(*JoinedArgs, TEXT("Pots="), Settings.NumPots);
+		FParse::Value(*JoinedArgs, TEXT("Minigames="), Settings.NumMinigames);
+		FParse::Value(*JoinedArgs, TEXT("Items="), Settings.NumItems);
+		FParse::Value(*JoinedArgs, TEXT("Warmup="), Settings.WarmupFrames);
+		FParse::Value(*JoinedArgs, TEXT("Frames="), Settings.NumFrames);
+		FParse::Value(*JoinedArgs, TEXT("Seed="), Settings.Seed);
+
+		FString ClassPath;
+		if (FParse::Value(*JoinedArgs, TEXT("PotClass="), ClassPath))
+		{
+			Settings.PotClass = LoadClass<AInteractablePot>(nullptr, *ClassPath);
+		}
+		if (FParse::Value(*JoinedArgs, TEXT("ItemClass="), ClassPath))
+		{
+			Settings.ItemClass = LoadClass<AInventoryItemActor>(nullptr, *ClassPath);
+		}
+
+		StressTestSubsystem->StartStressTest(Settings);
+	}));
+#endif
+
+void UWarriorKitchenStressTestSubsystem::Deinitialize()
+{
+	if (bIsRunning)
+	{
+		CleanupScenario();
+		bIsRunning = false;
+	}
+
+	Super::Deinitialize();
+}
+
+ETickableTickType UWarriorKitchenStressTestSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+TStatId UWarriorKitchenStressTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorKitchenStressTestSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorKitchenStressTestSubsystem::StartStressTest(const FWarriorKitchenStressTestSettings& InSettings)
+{
+	if (bIsRunning)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorKitchenStressTestSubsystem: A stress test is already running."));
+		return false;
+	}
+
+	if (!GetWorld()->IsGameWorld())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorKitchenStressTestSubsystem: Stress test requires a game world."));
+		return false;
+	}
+
+	Settings = InSettings;
+	Settings.NumPots = FMath::Max(Settings.NumPots, 0);
+	Settings.NumMinigames = FMath::Clamp(Settings.NumMinigames, 0, Settings.NumPots);
+	Settings.NumItems = FMath::Max(Settings.NumItems, 0);
+	Settings.WarmupFrames = FMath::Max(Settings.WarmupFrames, 0);
+	Settings.NumFrames = FMath::Max(Settings.NumFrames, 1);
+
+	RandomStream.Initialize(Settings.Seed);
+
+	FrameIndex = 0;
+	NextItemToSlice = 0;
+	NumMinigamesStarted = 0;
+	NumPotsCooking = 0;
+
+	FrameTimesMs.Reset(Settings.NumFrames);
+	GameThreadTimesMs.Reset(Settings.NumFrames);
+	SliceTimesMs.Reset(Settings.NumItems);
+	InventoryUITimesMs.Reset(Settings.NumFrames);
+
+	SpawnScenario();
+
+	bIsRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("UWarriorKitchenStressTestSubsystem: Started with %d pots (%d cooking, %d minigames), %d items, %d warmup + %d measured frames."),
+		Settings.NumPots, NumPotsCooking, NumMinigamesStarted, Settings.NumItems, Settings.WarmupFrames, Settings.NumFrames);
+
+	if (NumPotsCooking < Settings.NumPots)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UWarriorKitchenStressTestSubsystem: Only %d of %d pots started cooking. Check the pot's RecipeDataTable, cooking method and the player's known recipes."),
+			NumPotsCooking, Settings.NumPots);
+	}
+
+	return true;
+}
+
+void UWarriorKitchenStressTestSubsystem::Tick(float DeltaTime)
+{
+	++FrameIndex;
+
+	if (FrameIndex == Settings.WarmupFrames + 1)
+	{
+#if CSV_PROFILER
+		if (!FCsvProfiler::Get()->IsCapturing())
+		{
+			FCsvProfiler::Get()->BeginCapture();
+		}
+#endif
+	}
+
+	if (FrameIndex <= Settings.WarmupFrames)
+	{
+		return;
+	}
+
+	FrameTimesMs.Add(DeltaTime * 1000.f);
+	GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	SliceNextItem();
+	MeasureInventoryUI();
+
+	if (FrameTimesMs.Num() >= Settings.NumFrames)
+	{
+		FinishStressTest();
+	}
+}
+
+void UWarriorKitchenStressTestSubsystem::SpawnScenario()
+{
+	UWorld* World = GetWorld();
+
+	FVector Origin = FVector::ZeroVector;
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		if (const APawn* PlayerPawn = PlayerController->GetPawn())
+		{
+			Origin = PlayerPawn->GetActorLocation() + PlayerPawn->GetActorForwardVector() * 500.f;
+		}
+	}
+
+	const float GridSpacing = 200.f;
+	const int32 NumColumns = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Settings.NumPots + Settings.NumItems))), 1);
+	int32 GridIndex = 0;
+
+	auto NextGridLocation = [&]()
+	{
+		const int32 Row = GridIndex / NumColumns;
+		const int32 Column = GridIndex % NumColumns;
+		++GridIndex;
+		return Origin + FVector(Row * GridSpacing, (Column - NumColumns * 0.5f) * GridSpacing, 0.f);
+	};
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	UClass* PotClass = Settings.PotClass ? Settings.PotClass.Get() : AInteractablePot::StaticClass();
+	UDataTable* ItemDataTable = nullptr;
+	UDataTable* RecipeDataTable = nullptr;
+	TArray<FCookingRecipeStruct*> Recipes;
+
+	for (int32 PotIndex = 0; PotIndex < Settings.NumPots; ++PotIndex)
+	{
+		AInteractablePot* Pot = World->SpawnActor<AInteractablePot>(PotClass, NextGridLocation(), FRotator::ZeroRotator, SpawnParams);
+		if (!Pot)
+		{
+			continue;
+		}
+
+		SpawnedActors.Add(Pot);
+
+		if (!ItemDataTable)
+		{
+			ItemDataTable = Pot->GetItemDataTable();
+		}
+
+		if (!RecipeDataTable && Pot->GetRecipeDataTable())
+		{
+			RecipeDataTable = Pot->GetRecipeDataTable();
+			RecipeDataTable->GetAllRows<FCookingRecipeStruct>(TEXT("KitchenStressTest"), Recipes);
+		}
+
+		// A real recipe's ingredients, so StartCooking finds a match and the pot actually cooks
+		if (!Recipes.IsEmpty())
+		{
+			const FCookingRecipeStruct* Recipe = Recipes[RandomStream.RandHelper(Recipes.Num())];
+			for (const FName& IngredientID : Recipe->RequiredIngredients)
+			{
+				Pot->AddIngredient(IngredientID);
+			}
+		}
+
+		const bool bUseMinigame = PotIndex < Settings.NumMinigames;
+		Pot->SetUseMinigameSystem(bUseMinigame);
+		Pot->StartCooking();
+
+		if (Pot->IsCooking())
+		{
+			++NumPotsCooking;
+			NumMinigamesStarted += bUseMinigame ? 1 : 0;
+		}
+	}
+
+	UClass* ItemClass = Settings.ItemClass ? Settings.ItemClass.Get() : AInventoryItemActor::StaticClass();
+	const TArray<FName> ItemRowNames = ItemDataTable ? ItemDataTable->GetRowNames() : TArray<FName>();
+
+	for (int32 ItemIndex = 0; ItemIndex < Settings.NumItems; ++ItemIndex)
+	{
+		const FTransform SpawnTransform(NextGridLocation() + FVector(0.f, 0.f, 50.f));
+
+		AInventoryItemActor* ItemActor = World->SpawnActorDeferred<AInventoryItemActor>(ItemClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!ItemActor)
+		{
+			continue;
+		}
+
+		if (!ItemRowNames.IsEmpty())
+		{
+			FSlotStruct ItemSlot;
+			ItemSlot.ItemID.DataTable = ItemDataTable;
+			ItemSlot.ItemID.RowName = ItemRowNames[RandomStream.RandHelper(ItemRowNames.Num())];
+			ItemSlot.Quantity = 1;
+			ItemActor->SetItemDataForDeferredSpawn(ItemSlot);
+		}
+
+		ItemActor->FinishSpawning(SpawnTransform);
+		ItemActor->RequestEnablePhysics();
+
+		SpawnedActors.Add(ItemActor);
+		ItemsToSlice.Add(ItemActor);
+	}
+}
+
+void UWarriorKitchenStressTestSubsystem::SliceNextItem()
+{
+	// One slice per frame so the slice cost shows up as a per-frame spike rather than a single hitch
+	while (ItemsToSlice.IsValidIndex(NextItemToSlice))
+	{
+		AInventoryItemActor* ItemActor = ItemsToSlice[NextItemToSlice++].Get();
+		if (!ItemActor || ItemActor->IsSliced())
+		{
+			continue;
+		}
+
+		FVector BoundsOrigin;
+		FVector BoxExtent;
+		ItemActor->GetActorBounds(false, BoundsOrigin, BoxExtent);
+
+		const FVector PlaneNormal = FVector(RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-1.f, 1.f), RandomStream.FRandRange(-0.2f, 0.2f)).GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+
+		const double StartTime = FPlatformTime::Seconds();
+		ItemActor->SliceItem(BoundsOrigin, PlaneNormal);
+		SliceTimesMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return;
+	}
+}
+
+void UWarriorKitchenStressTestSubsystem::MeasureInventoryUI()
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const AWarriorHeroCharacter* HeroCharacter = PlayerController ? Cast<AWarriorHeroCharacter>(PlayerController->GetPawn()) : nullptr;
+	UInventoryComponent* InventoryComponent = HeroCharacter ? HeroCharacter->GetInventoryComponent() : nullptr;
+
+	if (!InventoryComponent)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	InventoryComponent->UpdateInventoryUI();
+	InventoryUITimesMs.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void UWarriorKitchenStressTestSubsystem::FinishStressTest()
+{
+	bIsRunning = false;
+
+#if CSV_PROFILER
+	if (FCsvProfiler::Get()->IsCapturing())
+	{
+		FCsvProfiler::Get()->EndCapture();
+	}
+#endif
+
+	const FString ReportPath = FPaths::ProfilingDir() / TEXT("KitchenStressTest") / FString::Printf(TEXT("KitchenStressTest-%s.json"), *FDateTime::Now().ToString());
+
+	bool bPassed = false;
+	if (WriteReport(ReportPath, bPassed))
+	{
+		UE_LOG(LogTemp, Log, TEXT("UWarriorKitchenStressTestSubsystem: Report written to %s"), *FPaths::ConvertRelativePathToFull(ReportPath));
+	}
+
+	if (bPassed)
+	{
+		UE_LOG(LogTemp, Log, TEXT("UWarriorKitchenStressTestSubsystem: All budgets met."));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("UWarriorKitchenStressTestSubsystem: One or more budgets exceeded, see report."));
+	}
+
+	CleanupScenario();
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("KitchenStressTestExit")))
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+void UWarriorKitchenStressTestSubsystem::CleanupScenario()
+{
+	for (const TWeakObjectPtr<AActor>& SpawnedActor : SpawnedActors)
+	{
+		if (AActor* Actor = SpawnedActor.Get())
+		{
+			Actor->Destroy();
+		}
+	}
+
+	SpawnedActors.Reset();
+	ItemsToSlice.Reset();
+}
+
+bool UWarriorKitchenStressTestSubsystem::WriteReport(const FString& ReportPath, bool& bOutPassed) const
+{
+	bOutPassed = true;
+
+	FString MetricsJson;
+	auto AppendMetric = [&](const TCHAR* MetricName, const TArray<float>& Samples, float BudgetMs)
+	{
+		const FMetricSummary Summary = Summarize(Samples);
+		const bool bMetricPassed = Summary.P95 <= BudgetMs;
+		bOutPassed &= bMetricPassed;
+
+		MetricsJson += FString::Printf(TEXT("%s\n\t\t\"%s\": { \"samples\": %d, \"avg_ms\": %.3f, \"p95_ms\": %.3f, \"max_ms\": %.3f, \"budget_p95_ms\": %.3f, \"passed\": %s }"),
+			MetricsJson.IsEmpty() ? TEXT("") : TEXT(","),
+			MetricName, Samples.Num(), Summary.Average, Summary.P95, Summary.Max, BudgetMs,
+			bMetricPassed ? TEXT("true") : TEXT("false"));
+	};
+
+	AppendMetric(TEXT("frame"), FrameTimesMs, CVarKitchenStressBudgetFrameMs.GetValueOnGameThread());
+	AppendMetric(TEXT("game_thread"), GameThreadTimesMs, CVarKitchenStressBudgetGameThreadMs.GetValueOnGameThread());
+	AppendMetric(TEXT("slice"), SliceTimesMs, CVarKitchenStressBudgetSliceMs.GetValueOnGameThread());
+	AppendMetric(TEXT("inventory_ui"), InventoryUITimesMs, CVarKitchenStressBudgetInventoryUIMs.GetValueOnGameThread());
+
+	const FString ReportJson = FString::Printf(
+		TEXT("{\n\t\"map\": \"%s\",\n\t\"settings\": { \"pots\": %d, \"cooking_pots\": %d, \"minigames\": %d, \"items\": %d, \"warmup_frames\": %d, \"frames\": %d, \"seed\": %d },\n\t\"metrics\": {%s\n\t},\n\t\"passed\": %s\n}\n"),
+		*GetWorld()->GetMapName(),
+		Settings.NumPots, NumPotsCooking, NumMinigamesStarted, Settings.NumItems, Settings.WarmupFrames, Settings.NumFrames, Settings.Seed,
+		*MetricsJson,
+		bOutPassed ? TEXT("true") : TEXT("false"));
+
+	UE_LOG(LogTemp, Log, TEXT("UWarriorKitchenStressTestSubsystem report:\n%s"), *ReportJson);
+
+	return FFileHelper::SaveStringToFile(ReportJson, *ReportPath);
+}
+
+UWarriorKitchenStressTestSubsystem::FMetricSummary UWarriorKitchenStressTestSubsystem::Summarize(TArray<float> Samples)
+{
+	FMetricSummary Summary;
+	if (Samples.IsEmpty())
+	{
+		return Summary;
+	}
+
+	Samples.Sort();
+
+	float Total = 0.f;
+	for (const float Sample : Samples)
+	{
+		Total += Sample;
+	}
+
+	Summary.Average = Total / Samples.Num();
+	Summary.P95 = Samples[FMath::Clamp(FMath::CeilToInt(Samples.Num() * 0.95f) - 1, 0, Samples.Num() - 1)];
+	Summary.Max = Samples.Last();
+
+	return Summary;
+}
@@ -0,0 +1,365 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorPathSharingSubsystem.h"
+#include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Path Sharing Lookup"), STAT_WarriorPathSharingLookup, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shared Paths"), STAT_WarriorSharedPaths, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Searched Paths"), STAT_WarriorSearchedPaths, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Path Sharing Goal Cells"), STAT_WarriorPathSharingGoalCells, STATGROUP_Warrior);
+
+static TAutoConsoleVariable<bool> CVarPathSharingEnabled(
+	TEXT("Warrior.PathSharing.Enabled"),
+	true,
+	TEXT("Lets AI agents heading for the same goal cell reuse each other's navmesh corridors instead of searching."));
+
+UWarriorPathSharingSubsystem* UWarriorPathSharingSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorPathSharingSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+bool UWarriorPathSharingSubsystem::IsEnabled()
+{
+	return CVarPathSharingEnabled.GetValueOnGameThread();
+}
+
+void UWarriorPathSharingSubsystem::Deinitialize()
+{
+	GoalCells.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorPathSharingGoalCells, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorPathSharingSubsystem::Tick(float DeltaTime)
+{
+	const float Time = GetWorld()->GetTimeSeconds();
+
+	for (auto It = GoalCells.CreateIterator(); It; ++It)
+	{
+		FGoalCell& GoalCell = It.Value();
+
+		GoalCell.Corridors.RemoveAll([this, Time](const FSharedCorridor& Corridor)
+			{
+				return Time - Corridor.CreationTime > CorridorLifetime;
+			});
+
+		if (GoalCell.Corridors.IsEmpty() && Time - GoalCell.WindowStartTime > RequestWindow * 2.f)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorPathSharingGoalCells, GoalCells.Num());
+}
+
+ETickableTickType UWarriorPathSharingSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorPathSharingSubsystem::IsTickable() const
+{
+	return !GoalCells.IsEmpty();
+}
+
+TStatId UWarriorPathSharingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorPathSharingSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorPathSharingSubsystem::FindSharedPath(const FPathFindingQuery& InQuery, FNavPathSharedPtr& OutPath)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorPathSharingLookup);
+
+	if (!IsEnabled() || !InQuery.QueryFilter.IsValid() || !Cast<const ARecastNavMesh>(InQuery.NavData.Get()))
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(InQuery.StartLocation, InQuery.EndLocation) < FMath::Square(MinShareDistance))
+	{
+		return false;
+	}
+
+	const float Time = GetWorld()->GetTimeSeconds();
+	FGoalCell& GoalCell = GoalCells.FindOrAdd(MakeGoalCellKey(InQuery));
+
+	if (!NoteRequest(GoalCell, InQuery, Time))
+	{
+		return false;
+	}
+
+	struct FJoinCandidate
+	{
+		int32 CorridorIndex = INDEX_NONE;
+		int32 PointIndex = INDEX_NONE;
+
+		// Estimated length of the joined path
+		float Cost = 0.f;
+	};
+
+	TArray<FJoinCandidate, TInlineAllocator<16>> Candidates;
+	const float JoinRadiusSquared = FMath::Square(JoinRadius);
+
+	for (int32 CorridorIndex = 0; CorridorIndex < GoalCell.Corridors.Num(); ++CorridorIndex)
+	{
+		const FSharedCorridor& Corridor = GoalCell.Corridors[CorridorIndex];
+
+		if (Time - Corridor.CreationTime > CorridorLifetime)
+		{
+			continue;
+		}
+
+		// The corridor ends at another agent's goal somewhere in the cell, the joined path is extended to this one
+		const float EndExtension = FVector::Dist(Corridor.PathPoints.Last().Location, InQuery.EndLocation);
+
+		for (int32 PointIndex = 0; PointIndex < Corridor.PathPoints.Num(); ++PointIndex)
+		{
+			const float DistanceSquared = FVector::DistSquared(InQuery.StartLocation, Corridor.PathPoints[PointIndex].Location);
+
+			if (DistanceSquared <= JoinRadiusSquared)
+			{
+				Candidates.Add({ CorridorIndex, PointIndex, FMath::Sqrt(DistanceSquared) + Corridor.DistanceToGoal[PointIndex] + EndExtension });
+			}
+		}
+	}
+
+	Candidates.Sort([](const FJoinCandidate& A, const FJoinCandidate& B)
+		{
+			return A.Cost < B.Cost;
+		});
+
+	for (int32 Index = 0; Index < Candidates.Num() && Index < MaxJoinRaycasts; ++Index)
+	{
+		const FJoinCandidate& Candidate = Candidates[Index];
+
+		if (TryJoinCorridor(InQuery, GoalCell.Corridors[Candidate.CorridorIndex], Candidate.PointIndex, OutPath))
+		{
+			INC_DWORD_STAT(STAT_WarriorSharedPaths);
+
+			// Agents further out can now join this agent's path as well
+			AddCorridor(GoalCell, *OutPath->CastPath<FNavMeshPath>(), Time);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UWarriorPathSharingSubsystem::AddSearchedPath(const FPathFindingQuery& InQuery, const FNavPathSharedPtr& InPath)
+{
+	INC_DWORD_STAT(STAT_WarriorSearchedPaths);
+
+	if (!IsEnabled() || !InPath.IsValid() || !InPath->IsValid() || InPath->IsPartial())
+	{
+		return;
+	}
+
+	const FNavMeshPath* NavMeshPath = InPath->CastPath<FNavMeshPath>();
+
+	if (!NavMeshPath || NavMeshPath->PathCorridor.IsEmpty())
+	{
+		return;
+	}
+
+	FGoalCell* GoalCell = GoalCells.Find(MakeGoalCellKey(InQuery));
+
+	// FindSharedPath has already counted this request, a missing cell means the request was not eligible
+	if (!GoalCell || FMath::Max(GoalCell->RecentQueriers.Num(), GoalCell->PreviousWindowQueriers) < MinAgentsToShare)
+	{
+		return;
+	}
+
+	AddCorridor(*GoalCell, *NavMeshPath, GetWorld()->GetTimeSeconds());
+}
+
+float UWarriorPathSharingSubsystem::GetGoalRepathTolerance(const FNavigationPath& InPath) const
+{
+	return FMath::Clamp(static_cast<float>(InPath.GetLength()) * GoalRepathToleranceFraction, MinGoalRepathTolerance, FMath::Max(MinGoalRepathTolerance, MaxGoalRepathTolerance));
+}
+
+UWarriorPathSharingSubsystem::FGoalCellKey UWarriorPathSharingSubsystem::MakeGoalCellKey(const FPathFindingQuery& InQuery) const
+{
+	FGoalCellKey Key;
+	Key.Cell = FIntVector(
+		FMath::FloorToInt(InQuery.EndLocation.X / GoalCellSize),
+		FMath::FloorToInt(InQuery.EndLocation.Y / GoalCellSize),
+		FMath::FloorToInt(InQuery.EndLocation.Z / GoalCellSize));
+	Key.NavData = InQuery.NavData.Get();
+	Key.QueryFilter = InQuery.QueryFilter.Get();
+
+	return Key;
+}
+
+bool UWarriorPathSharingSubsystem::NoteRequest(FGoalCell& InOutGoalCell, const FPathFindingQuery& InQuery, float InTime) const
+{
+	if (InTime - InOutGoalCell.WindowStartTime > RequestWindow)
+	{
+		// The previous window still counts, so sharing does not switch off for a moment every time a window starts
+		InOutGoalCell.PreviousWindowQueriers = InOutGoalCell.RecentQueriers.Num();
+		InOutGoalCell.RecentQueriers.Reset();
+		InOutGoalCell.WindowStartTime = InTime;
+	}
+
+	InOutGoalCell.RecentQueriers.AddUnique(FObjectKey(InQuery.Owner.Get()));
+
+	return FMath::Max(InOutGoalCell.RecentQueriers.Num(), InOutGoalCell.PreviousWindowQueriers) >= MinAgentsToShare;
+}
+
+void UWarriorPathSharingSubsystem::AddCorridor(FGoalCell& InOutGoalCell, const FNavMeshPath& InPath, float InTime)
+{
+	const TArray<FNavPathPoint>& PathPoints = InPath.GetPathPoints();
+
+	if (PathPoints.Num() < 2)
+	{
+		return;
+	}
+
+	// Corridors are appended in time order, so the first one is the oldest
+	if (InOutGoalCell.Corridors.Num() >= MaxCorridorsPerGoal)
+	{
+		InOutGoalCell.Corridors.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	FSharedCorridor& Corridor = InOutGoalCell.Corridors.AddDefaulted_GetRef();
+	Corridor.PathPoints = PathPoints;
+	Corridor.PathCorridor = InPath.PathCorridor;
+	Corridor.PathCorridorCost = InPath.PathCorridorCost;
+	Corridor.CreationTime = InTime;
+
+	Corridor.DistanceToGoal.SetNumUninitialized(PathPoints.Num());
+	Corridor.DistanceToGoal.Last() = 0.f;
+
+	for (int32 PointIndex = PathPoints.Num() - 2; PointIndex >= 0; --PointIndex)
+	{
+		Corridor.DistanceToGoal[PointIndex] = Corridor.DistanceToGoal[PointIndex + 1] + FVector::Dist(PathPoints[PointIndex].Location, PathPoints[PointIndex + 1].Location);
+	}
+}
+
+bool UWarriorPathSharingSubsystem::TryJoinCorridor(const FPathFindingQuery& InQuery, const FSharedCorridor& InCorridor, int32 InJoinIndex, FNavPathSharedPtr& OutPath) const
+{
+#if WITH_RECAST
+	const ARecastNavMesh* NavMesh = Cast<const ARecastNavMesh>(InQuery.NavData.Get());
+
+	if (!NavMesh)
+	{
+		return false;
+	}
+
+	const auto IsClearRaycast = [](const FRaycastResult& InResult)
+		{
+			return !InResult.HasHit() && InResult.bIsRaycastEndInCorridor && InResult.CorridorPolysCount > 0 && InResult.CorridorPolysCount < InResult.GetMaxCorridorSize();
+		};
+
+	FRaycastResult RaycastResult;
+	FVector HitLocation;
+
+	ARecastNavMesh::NavMeshRaycast(NavMesh, INVALID_NAVNODEREF, InQuery.StartLocation, InCorridor.PathPoints[InJoinIndex].Location, HitLocation, InQuery.QueryFilter, InQuery.Owner.Get(), RaycastResult);
+
+	if (!IsClearRaycast(RaycastResult))
+	{
+		return false;
+	}
+
+	// The raycast has to end on a polygon of the kept corridor, so the two form one connected corridor
+	const int32 CorridorJoinIndex = InCorridor.PathCorridor.Find(RaycastResult.GetLastNodeRef());
+
+	if (CorridorJoinIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Goals only match to a cell, so the corridor's end can be well short of this query's goal. The path has to
+	// reach the query's goal from there in a straight line, otherwise the agent searches its own path.
+	// Projected like a search projects its goal, e.g. the capsule centre of a goal actor
+	FNavLocation GoalLocation;
+
+	if (!NavMesh->ProjectPoint(InQuery.EndLocation, GoalLocation, NavMesh->GetDefaultQueryExtent(), InQuery.QueryFilter, InQuery.Owner.Get()))
+	{
+		return false;
+	}
+
+	const FNavPathPoint& CorridorEnd = InCorridor.PathPoints.Last();
+	const bool bExtendToGoal = !CorridorEnd.Location.Equals(GoalLocation.Location, 1.f);
+
+	FRaycastResult GoalRaycastResult;
+
+	if (bExtendToGoal)
+	{
+		ARecastNavMesh::NavMeshRaycast(NavMesh, CorridorEnd.NodeRef, CorridorEnd.Location, GoalLocation.Location, HitLocation, InQuery.QueryFilter, InQuery.Owner.Get(), GoalRaycastResult);
+
+		if (!IsClearRaycast(GoalRaycastResult))
+		{
+			return false;
+		}
+	}
+
+	FNavPathSharedPtr NewPath = NavMesh->CreatePathInstance<FNavMeshPath>(InQuery);
+	FNavMeshPath* NavMeshPath = NewPath->CastPath<FNavMeshPath>();
+	NavMeshPath->ApplyFlags(InQuery.NavDataFlags);
+
+	TArray<FNavPathPoint>& PathPoints = NavMeshPath->GetPathPoints();
+	PathPoints.Reserve(InCorridor.PathPoints.Num() - InJoinIndex + 2);
+	PathPoints.Add(FNavPathPoint(InQuery.StartLocation, RaycastResult.CorridorPolys[0]));
+
+	for (int32 PointIndex = InJoinIndex; PointIndex < InCorridor.PathPoints.Num(); ++PointIndex)
+	{
+		PathPoints.Add(InCorridor.PathPoints[PointIndex]);
+	}
+
+	// The goal raycast starts on the corridor's last polygon, which is already in the corridor
+	const int32 FirstGoalPolyIndex = bExtendToGoal && GoalRaycastResult.CorridorPolys[0] == InCorridor.PathCorridor.Last() ? 1 : 0;
+	const int32 NumGoalPolys = bExtendToGoal ? GoalRaycastResult.CorridorPolysCount - FirstGoalPolyIndex : 0;
+
+	if (bExtendToGoal)
+	{
+		PathPoints.Add(FNavPathPoint(GoalLocation.Location, GoalLocation.NodeRef));
+	}
+
+	const bool bHasCorridorCost = InCorridor.PathCorridorCost.Num() == InCorridor.PathCorridor.Num();
+	const int32 NumCorridorPolys = RaycastResult.CorridorPolysCount + InCorridor.PathCorridor.Num() - CorridorJoinIndex - 1 + NumGoalPolys;
+
+	NavMeshPath->PathCorridor.Reserve(NumCorridorPolys);
+	NavMeshPath->PathCorridorCost.Reserve(NumCorridorPolys);
+
+	for (int32 PolyIndex = 0; PolyIndex < RaycastResult.CorridorPolysCount; ++PolyIndex)
+	{
+		NavMeshPath->PathCorridor.Add(RaycastResult.CorridorPolys[PolyIndex]);
+		NavMeshPath->PathCorridorCost.Add(RaycastResult.CorridorCost[PolyIndex]);
+	}
+
+	for (int32 PolyIndex = CorridorJoinIndex + 1; PolyIndex < InCorridor.PathCorridor.Num(); ++PolyIndex)
+	{
+		NavMeshPath->PathCorridor.Add(InCorridor.PathCorridor[PolyIndex]);
+		NavMeshPath->PathCorridorCost.Add(bHasCorridorCost ? InCorridor.PathCorridorCost[PolyIndex] : 0.f);
+	}
+
+	for (int32 PolyIndex = FirstGoalPolyIndex; PolyIndex < FirstGoalPolyIndex + NumGoalPolys; ++PolyIndex)
+	{
+		NavMeshPath->PathCorridor.Add(GoalRaycastResult.CorridorPolys[PolyIndex]);
+		NavMeshPath->PathCorridorCost.Add(GoalRaycastResult.CorridorCost[PolyIndex]);
+	}
+
+	NavMeshPath->MarkReady();
+
+	OutPath = NewPath;
+	return true;
+#else
+	return false;
+#endif
+}
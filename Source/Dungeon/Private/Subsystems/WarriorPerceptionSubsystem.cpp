@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorPerceptionSubsystem.h"
+#include "Controllers/WarriorAIController.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Shared Perception Update"), STAT_WarriorSharedPerceptionUpdate, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shared Perception Traces"), STAT_WarriorSharedPerceptionTraces, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shared Perception Listeners"), STAT_WarriorSharedPerceptionListeners, STATGROUP_Warrior);
+
+UWarriorPerceptionSubsystem* UWarriorPerceptionSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorPerceptionSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorPerceptionSubsystem::Deinitialize()
+{
+	RegisteredControllers.Empty();
+	PendingTraces.Empty();
+	OverlapScratch.Empty();
+	ClusterIndexScratch.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorSharedPerceptionListeners, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorPerceptionSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorSharedPerceptionUpdate);
+
+	ResolvePendingTraces();
+
+	TimeUntilNextUpdate -= DeltaTime;
+
+	if (TimeUntilNextUpdate > 0.f)
+	{
+		return;
+	}
+
+	TimeUntilNextUpdate = UpdateInterval;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+
+		if (APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+		{
+			QueueClusterTraces(PlayerPawn);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorSharedPerceptionListeners, RegisteredControllers.Num());
+}
+
+ETickableTickType UWarriorPerceptionSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorPerceptionSubsystem::IsTickable() const
+{
+	return !RegisteredControllers.IsEmpty() || !PendingTraces.IsEmpty();
+}
+
+TStatId UWarriorPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorPerceptionSubsystem::RegisterController(AWarriorAIController* InController)
+{
+	check(InController);
+
+	RegisteredControllers.Add(InController);
+}
+
+void UWarriorPerceptionSubsystem::UnregisterController(AWarriorAIController* InController)
+{
+	RegisteredControllers.Remove(InController);
+}
+
+void UWarriorPerceptionSubsystem::ResolvePendingTraces()
+{
+	if (PendingTraces.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+
+	for (FPendingClusterTrace& PendingTrace : PendingTraces)
+	{
+		FTraceDatum TraceDatum;
+
+		// A result that is gone (a skipped frame) is simply retried at the next update
+		if (!World->QueryTraceData(PendingTrace.TraceHandle, TraceDatum))
+		{
+			continue;
+		}
+
+		const bool bIsOccluded = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit)
+			{
+				return Hit.bBlockingHit;
+			});
+
+		APawn* Player = PendingTrace.Player.Get();
+
+		if (bIsOccluded || !Player)
+		{
+			continue;
+		}
+
+		for (const TWeakObjectPtr<AWarriorAIController>& WeakController : PendingTrace.Controllers)
+		{
+			if (AWarriorAIController* Controller = WeakController.Get())
+			{
+				Controller->HandleSharedPerceptionSighted(Player);
+			}
+		}
+	}
+
+	PendingTraces.Reset();
+}
+
+void UWarriorPerceptionSubsystem::QueueClusterTraces(APawn* InPlayer)
+{
+	UWorld* World = GetWorld();
+	const FVector PlayerLocation = InPlayer->GetActorLocation();
+
+	// The one spatial query for this player
+	OverlapScratch.Reset();
+	World->OverlapMultiByObjectType(
+		OverlapScratch,
+		PlayerLocation,
+		FQuat::Identity,
+		FCollisionObjectQueryParams(ECC_Pawn),
+		FCollisionShape::MakeSphere(SightRadius),
+		FCollisionQueryParams(SCENE_QUERY_STAT(WarriorSharedPerception), false, InPlayer)
+	);
+
+	ClusterIndexScratch.Reset();
+
+	const int32 FirstNewTrace = PendingTraces.Num();
+	TArray<FVector, TInlineAllocator<16>> ClusterEyeSums;
+
+	for (const FOverlapResult& Overlap : OverlapScratch)
+	{
+		const APawn* EnemyPawn = Cast<APawn>(Overlap.GetActor());
+		AWarriorAIController* Controller = EnemyPawn ? EnemyPawn->GetController<AWarriorAIController>() : nullptr;
+
+		// Pooled enemies are hidden and have their logic paused, they must not pick up targets
+		if (!Controller || EnemyPawn->IsHidden() || !RegisteredControllers.Contains(Controller))
+		{
+			continue;
+		}
+
+		// Matches the old sight config, which only detected enemies of the listener's team
+		if (Controller->GetTeamAttitudeTowards(*InPlayer) != ETeamAttitude::Hostile || Controller->HasTargetActor())
+		{
+			continue;
+		}
+
+		const FVector EyeLocation = EnemyPawn->GetPawnViewLocation();
+		const FIntVector Cell(
+			FMath::FloorToInt(EyeLocation.X / ClusterCellSize),
+			FMath::FloorToInt(EyeLocation.Y / ClusterCellSize),
+			FMath::FloorToInt(EyeLocation.Z / ClusterCellSize)
+		);
+
+		int32* ExistingIndex = ClusterIndexScratch.Find(Cell);
+		int32 ClusterIndex = ExistingIndex ? *ExistingIndex : INDEX_NONE;
+
+		if (ClusterIndex == INDEX_NONE)
+		{
+			ClusterIndex = ClusterEyeSums.Add(FVector::ZeroVector);
+			ClusterIndexScratch.Add(Cell, ClusterIndex);
+
+			FPendingClusterTrace& NewTrace = PendingTraces.AddDefaulted_GetRef();
+			NewTrace.Player = InPlayer;
+		}
+
+		ClusterEyeSums[ClusterIndex] += EyeLocation;
+		PendingTraces[FirstNewTrace + ClusterIndex].Controllers.Add(Controller);
+	}
+
+	// Walls block sight, other pawns do not
+	const FCollisionObjectQueryParams OcclusionParams(ECC_WorldStatic);
+	const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(WarriorSharedPerceptionTrace), false, InPlayer);
+
+	for (int32 ClusterIndex = 0; ClusterIndex < ClusterEyeSums.Num(); ++ClusterIndex)
+	{
+		FPendingClusterTrace& PendingTrace = PendingTraces[FirstNewTrace + ClusterIndex];
+		const FVector ClusterEyeLocation = ClusterEyeSums[ClusterIndex] / PendingTrace.Controllers.Num();
+
+		PendingTrace.TraceHandle = World->AsyncLineTraceByObjectType(
+			EAsyncTraceType::Single,
+			ClusterEyeLocation,
+			PlayerLocation,
+			OcclusionParams,
+			TraceParams
+		);
+	}
+
+	INC_DWORD_STAT_BY(STAT_WarriorSharedPerceptionTraces, ClusterEyeSums.Num());
+}
@@ -0,0 +1,457 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorProjectileSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "NiagaraComponent.h"
+#include "Components/BoxComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorGameplayTags.h"
+#include "Subsystems/WarriorHitReactSubsystem.h"
+#include "Subsystems/WarriorCombatTelemetrySubsystem.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectiles Tick"), STAT_WarriorProjectilesTick, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles Live"), STAT_WarriorProjectilesLive, STATGROUP_Warrior);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Sync Sweeps"), STAT_WarriorProjectileSyncSweeps, STATGROUP_Warrior);
+
+namespace WarriorProjectileNames
+{
+	static const FName PositionsParam(TEXT("ProjectilePositions"));
+	static const FName VelocitiesParam(TEXT("ProjectileVelocities"));
+}
+
+namespace WarriorProjectileCollision
+{
+	// The actor projectile's collision box is a WorldDynamic object, so other primitives answer for that channel
+	static constexpr ECollisionChannel SweepChannel = ECC_WorldDynamic;
+
+	// Responses of AWarriorProjectileBase's collision box. A hit only blocks when both sides block, so overlap only
+	// triggers come back as touches, the same way they overlap the actor projectile.
+	static FCollisionResponseParams MakeResponseParams(EProjectileDamagePolicy InDamagePolicy)
+	{
+		FCollisionResponseParams ResponseParams(ECR_Overlap);
+		ResponseParams.CollisionResponse.SetResponse(ECC_WorldStatic, ECR_Block);
+		ResponseParams.CollisionResponse.SetResponse(ECC_WorldDynamic, ECR_Block);
+		ResponseParams.CollisionResponse.SetResponse(ECC_Pawn, InDamagePolicy == EProjectileDamagePolicy::OnBeginOverlap ? ECR_Overlap : ECR_Block);
+
+		return ResponseParams;
+	}
+}
+
+UWarriorProjectileSubsystem* UWarriorProjectileSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorProjectileSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorProjectileSubsystem::Deinitialize()
+{
+	Projectiles.Empty();
+
+	for (FWarriorProjectileVisualGroup& VisualGroup : VisualGroups)
+	{
+		if (IsValid(VisualGroup.Component))
+		{
+			VisualGroup.Component->DestroyComponent();
+		}
+	}
+
+	VisualGroups.Empty();
+	HitScratch.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorProjectilesLive, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorProjectileSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorProjectilesTick);
+
+	UWorld* World = GetWorld();
+
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; --Index)
+	{
+		FWarriorSimProjectile& Projectile = Projectiles[Index];
+
+		bool bIsAlive = true;
+
+		// Sweeps queued last tick have been run by the async trace buffer by now
+		if (Projectile.PendingTrace.IsValid())
+		{
+			FTraceDatum TraceDatum;
+
+			if (World->QueryTraceData(Projectile.PendingTrace, TraceDatum))
+			{
+				bIsAlive = ResolveHits(Projectile, TraceDatum.OutHits);
+			}
+			else
+			{
+				// Result dropped, e.g. a frame where this subsystem did not tick. Trace the segment again here.
+				INC_DWORD_STAT(STAT_WarriorProjectileSyncSweeps);
+
+				FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WarriorProjectileSweep), false, Projectile.Instigator.Get());
+
+				HitScratch.Reset();
+				World->SweepMultiByChannel(
+					HitScratch,
+					Projectile.TraceStart,
+					Projectile.TraceEnd,
+					FQuat::Identity,
+					WarriorProjectileCollision::SweepChannel,
+					FCollisionShape::MakeSphere(Projectile.CollisionRadius),
+					QueryParams,
+					WarriorProjectileCollision::MakeResponseParams(Projectile.DamagePolicy)
+				);
+
+				bIsAlive = ResolveHits(Projectile, HitScratch);
+			}
+
+			Projectile.PendingTrace = FTraceHandle();
+		}
+
+		Projectile.RemainingLifeSpan -= DeltaTime;
+
+		if (!bIsAlive || Projectile.RemainingLifeSpan <= 0.f)
+		{
+			if (Projectile.VisualGroupIndex != INDEX_NONE)
+			{
+				bVisualsDirty = true;
+			}
+
+			Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Projectiles fired since the last tick start moving here, so no handle is ever read back in the frame it was issued
+		if (Projectile.bHasMoved)
+		{
+			Projectile.Velocity.Z += World->GetGravityZ() * Projectile.GravityScale * DeltaTime;
+		}
+
+		Projectile.bHasMoved = true;
+
+		QueueSweep(Projectile, Projectile.Location + Projectile.Velocity * DeltaTime);
+	}
+
+	UpdateVisuals();
+
+	SET_DWORD_STAT(STAT_WarriorProjectilesLive, Projectiles.Num());
+}
+
+ETickableTickType UWarriorProjectileSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorProjectileSubsystem::IsTickable() const
+{
+	return !Projectiles.IsEmpty() || bVisualsDirty;
+}
+
+TStatId UWarriorProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorProjectileSubsystem, STATGROUP_Tickables);
+}
+
+bool UWarriorProjectileSubsystem::FireProjectile(APawn* InInstigator, const FVector& InLocation, const FVector& InDirection, const FWarriorProjectileParams& InParams, const FGameplayEffectSpecHandle& InDamageSpecHandle)
+{
+	checkf(InDamageSpecHandle.IsValid(), TEXT("Forgot to assign a valid spec handle to the projectile fired by: %s"), *GetNameSafe(InInstigator));
+
+	if (!InInstigator || InParams.LifeSpan <= 0.f)
+	{
+		return false;
+	}
+
+	FWarriorSimProjectile& NewProjectile = Projectiles.AddDefaulted_GetRef();
+	NewProjectile.Location = InLocation;
+	NewProjectile.Velocity = InDirection.GetSafeNormal() * InParams.Speed;
+	NewProjectile.RemainingLifeSpan = InParams.LifeSpan;
+	NewProjectile.GravityScale = InParams.GravityScale;
+	NewProjectile.CollisionRadius = InParams.CollisionRadius;
+	NewProjectile.DamagePolicy = InParams.DamagePolicy;
+	NewProjectile.DamageSpecHandle = InDamageSpecHandle;
+	NewProjectile.Instigator = InInstigator;
+	NewProjectile.HitFxSystem = InParams.HitFxSystem;
+	NewProjectile.VisualGroupIndex = InParams.VisualSystem ? FindOrAddVisualGroup(InParams.VisualSystem) : INDEX_NONE;
+
+	return true;
+}
+
+AWarriorProjectileBase* UWarriorProjectileSubsystem::SpawnProjectileFromClass(APawn* InInstigator, TSubclassOf<AWarriorProjectileBase> InProjectileClass, const FTransform& InSpawnTransform, const FGameplayEffectSpecHandle& InDamageSpecHandle)
+{
+	if (!InProjectileClass)
+	{
+		return nullptr;
+	}
+
+	const AWarriorProjectileBase* ProjectileDefaults = InProjectileClass->GetDefaultObject<AWarriorProjectileBase>();
+
+	if (ProjectileDefaults->ShouldSpawnAsActor())
+	{
+		AWarriorProjectileBase* SpawnedProjectile = GetWorld()->SpawnActorDeferred<AWarriorProjectileBase>(InProjectileClass, InSpawnTransform, InInstigator, InInstigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+		if (SpawnedProjectile)
+		{
+			SpawnedProjectile->SetProjectileDamageEffectSpecHandle(InDamageSpecHandle);
+			SpawnedProjectile->FinishSpawning(InSpawnTransform);
+		}
+
+		return SpawnedProjectile;
+	}
+
+	// The movement component's velocity is a direction in the actor's space, scaled by InitialSpeed when that is set
+	const UProjectileMovementComponent* MovementDefaults = ProjectileDefaults->GetProjectileMovementComp();
+	const float Speed = MovementDefaults->InitialSpeed > 0.f ? MovementDefaults->InitialSpeed : MovementDefaults->Velocity.Size();
+
+	FWarriorProjectileParams Params;
+	Params.Speed = MovementDefaults->MaxSpeed > 0.f ? FMath::Min(Speed, MovementDefaults->MaxSpeed) : Speed;
+	Params.GravityScale = MovementDefaults->ProjectileGravityScale;
+	Params.CollisionRadius = FMath::Max(ProjectileDefaults->GetProjectileCollisionBox()->GetScaledBoxExtent().GetMin(), 1.f);
+	Params.LifeSpan = ProjectileDefaults->InitialLifeSpan > 0.f ? ProjectileDefaults->InitialLifeSpan : FWarriorProjectileParams().LifeSpan;
+	Params.DamagePolicy = ProjectileDefaults->GetProjectileDamagePolicy();
+	Params.VisualSystem = ProjectileDefaults->GetSimulatedVisualSystem();
+	Params.HitFxSystem = ProjectileDefaults->GetSimulatedHitFxSystem();
+
+	const FVector Direction = InSpawnTransform.TransformVectorNoScale(MovementDefaults->Velocity.GetSafeNormal());
+
+	FireProjectile(InInstigator, InSpawnTransform.GetLocation(), Direction, Params, InDamageSpecHandle);
+
+	return nullptr;
+}
+
+bool UWarriorProjectileSubsystem::ResolveHits(FWarriorSimProjectile& InOutProjectile, const TArray<FHitResult>& InHits)
+{
+	// Multi sweeps report the touches ordered by distance, followed by the blocking hit the sweep stopped at
+	for (const FHitResult& Hit : InHits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		APawn* HitPawn = Cast<APawn>(HitActor);
+
+		// Overlap only triggers and volumes do not stop the projectile, just like they do not stop the actor one
+		if (!Hit.bBlockingHit && !(InOutProjectile.DamagePolicy == EProjectileDamagePolicy::OnBeginOverlap && HitPawn))
+		{
+			continue;
+		}
+
+		if (InOutProjectile.DamagePolicy == EProjectileDamagePolicy::OnBeginOverlap && HitPawn)
+		{
+			if (InOutProjectile.OverlappedActors.Contains(HitActor))
+			{
+				continue;
+			}
+
+			InOutProjectile.OverlappedActors.Add(HitActor);
+
+			APawn* Instigator = InOutProjectile.Instigator.Get();
+
+			if (Instigator && UWarriorFunctionLibrary::IsTargetPawnHostile(Instigator, HitPawn))
+			{
+				FGameplayEventData Data;
+				Data.Instigator = Instigator;
+				Data.Target = HitPawn;
+
+				HandleApplyProjectileDamage(InOutProjectile, HitPawn, Data);
+			}
+
+			continue;
+		}
+
+		const FVector ImpactPoint = Hit.bStartPenetrating ? Hit.TraceStart : FVector(Hit.ImpactPoint);
+
+		SpawnHitFx(InOutProjectile, ImpactPoint);
+
+		if (InOutProjectile.DamagePolicy == EProjectileDamagePolicy::OnHit && HitPawn)
+		{
+			HandleProjectilePawnHit(InOutProjectile, HitPawn);
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+void UWarriorProjectileSubsystem::HandleProjectilePawnHit(const FWarriorSimProjectile& InProjectile, APawn* InHitPawn)
+{
+	APawn* Instigator = InProjectile.Instigator.Get();
+
+	if (!Instigator || !UWarriorFunctionLibrary::IsTargetPawnHostile(Instigator, InHitPawn))
+	{
+		return;
+	}
+
+	bool bIsValidBlock = false;
+
+	const bool bIsPlayerBlocking = UWarriorFunctionLibrary::NativeDoesActorHaveStatus(InHitPawn, EWarriorStatusFlags::Blocking);
+
+	if (bIsPlayerBlocking)
+	{
+		// There is no projectile actor to take the forward vector from, the travel direction stands in for it
+		bIsValidBlock = UWarriorFunctionLibrary::NativeIsValidBlockFromDirection(InProjectile.Velocity.GetSafeNormal(), InHitPawn);
+	}
+
+	FGameplayEventData Data;
+	Data.Instigator = Instigator;
+	Data.Target = InHitPawn;
+
+	if (bIsValidBlock)
+	{
+		UWarriorCombatTelemetrySubsystem::RecordBlockedHit(Instigator, InHitPawn);
+
+		UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(
+			InHitPawn,
+			WarriorGameplayTags::Player_Event_SuccessfulBlock,
+			Data
+		);
+	}
+	else
+	{
+		HandleApplyProjectileDamage(InProjectile, InHitPawn, Data);
+	}
+}
+
+void UWarriorProjectileSubsystem::HandleApplyProjectileDamage(const FWarriorSimProjectile& InProjectile, APawn* InHitPawn, const FGameplayEventData& InPayload)
+{
+	APawn* Instigator = InProjectile.Instigator.Get();
+
+	if (!Instigator)
+	{
+		return;
+	}
+
+	const bool bWasApplied = UWarriorFunctionLibrary::ApplyGameplayEffectSpecHandleToTargetActor(Instigator, InHitPawn, InProjectile.DamageSpecHandle);
+
+	if (bWasApplied)
+	{
+		UWarriorHitReactSubsystem::QueueOrSendHitReact(InHitPawn, InPayload);
+	}
+}
+
+void UWarriorProjectileSubsystem::SpawnHitFx(const FWarriorSimProjectile& InProjectile, const FVector& InLocation)
+{
+	if (UNiagaraSystem* HitFxSystem = InProjectile.HitFxSystem.Get())
+	{
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+			GetWorld(),
+			HitFxSystem,
+			InLocation,
+			InProjectile.Velocity.Rotation(),
+			FVector::OneVector,
+			true,
+			true,
+			ENCPoolMethod::AutoRelease
+		);
+	}
+}
+
+void UWarriorProjectileSubsystem::QueueSweep(FWarriorSimProjectile& InOutProjectile, const FVector& InEnd)
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WarriorProjectileSweep), false, InOutProjectile.Instigator.Get());
+
+	InOutProjectile.TraceStart = InOutProjectile.Location;
+	InOutProjectile.TraceEnd = InEnd;
+	InOutProjectile.PendingTrace = GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Multi,
+		InOutProjectile.TraceStart,
+		InOutProjectile.TraceEnd,
+		FQuat::Identity,
+		WarriorProjectileCollision::SweepChannel,
+		FCollisionShape::MakeSphere(InOutProjectile.CollisionRadius),
+		QueryParams,
+		WarriorProjectileCollision::MakeResponseParams(InOutProjectile.DamagePolicy)
+	);
+
+	// Visuals lead the trace by one segment, which is a few centimetres at projectile speeds
+	InOutProjectile.Location = InEnd;
+}
+
+int32 UWarriorProjectileSubsystem::FindOrAddVisualGroup(UNiagaraSystem* InSystem)
+{
+	const int32 ExistingIndex = VisualGroups.IndexOfByPredicate([InSystem](const FWarriorProjectileVisualGroup& VisualGroup)
+		{
+			return VisualGroup.System == InSystem;
+		});
+
+	if (ExistingIndex != INDEX_NONE && IsValid(VisualGroups[ExistingIndex].Component))
+	{
+		return ExistingIndex;
+	}
+
+	UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+		GetWorld(),
+		InSystem,
+		FVector::ZeroVector,
+		FRotator::ZeroRotator,
+		FVector::OneVector,
+		false,
+		true,
+		ENCPoolMethod::None
+	);
+
+	if (!Component)
+	{
+		return INDEX_NONE;
+	}
+
+	if (ExistingIndex != INDEX_NONE)
+	{
+		VisualGroups[ExistingIndex].Component = Component;
+		return ExistingIndex;
+	}
+
+	FWarriorProjectileVisualGroup& NewGroup = VisualGroups.AddDefaulted_GetRef();
+	NewGroup.System = InSystem;
+	NewGroup.Component = Component;
+
+	return VisualGroups.Num() - 1;
+}
+
+void UWarriorProjectileSubsystem::UpdateVisuals()
+{
+	if (VisualGroups.IsEmpty())
+	{
+		bVisualsDirty = false;
+		return;
+	}
+
+	for (FWarriorProjectileVisualGroup& VisualGroup : VisualGroups)
+	{
+		VisualGroup.Positions.Reset();
+		VisualGroup.Velocities.Reset();
+	}
+
+	for (const FWarriorSimProjectile& Projectile : Projectiles)
+	{
+		if (VisualGroups.IsValidIndex(Projectile.VisualGroupIndex))
+		{
+			FWarriorProjectileVisualGroup& VisualGroup = VisualGroups[Projectile.VisualGroupIndex];
+			VisualGroup.Positions.Add(Projectile.Location);
+			VisualGroup.Velocities.Add(Projectile.Velocity);
+		}
+	}
+
+	for (FWarriorProjectileVisualGroup& VisualGroup : VisualGroups)
+	{
+		if (IsValid(VisualGroup.Component))
+		{
+			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(VisualGroup.Component, WarriorProjectileNames::PositionsParam, VisualGroup.Positions);
+			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(VisualGroup.Component, WarriorProjectileNames::VelocitiesParam, VisualGroup.Velocities);
+		}
+	}
+
+	bVisualsDirty = false;
+}
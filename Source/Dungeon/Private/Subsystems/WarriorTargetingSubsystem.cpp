@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorTargetingSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "WarriorFunctionLibrary.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Targeting Index Rebuild"), STAT_WarriorTargetingIndexRebuild, STATGROUP_Warrior);
+DECLARE_CYCLE_STAT(TEXT("Targeting Query"), STAT_WarriorTargetingQuery, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Targeting Indexed Pawns"), STAT_WarriorTargetingIndexedPawns, STATGROUP_Warrior);
+
+UWarriorTargetingSubsystem* UWarriorTargetingSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorTargetingSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorTargetingSubsystem::Deinitialize()
+{
+	RegisteredTargets.Empty();
+	IndexedTargets.Empty();
+	TargetsByCell.Empty();
+
+	SET_DWORD_STAT(STAT_WarriorTargetingIndexedPawns, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorTargetingSubsystem::RegisterTarget(APawn* InPawn)
+{
+	check(InPawn);
+
+	RegisteredTargets.Add(InPawn);
+	bIndexDirty = true;
+}
+
+void UWarriorTargetingSubsystem::UnregisterTarget(APawn* InPawn)
+{
+	RegisteredTargets.Remove(InPawn);
+	bIndexDirty = true;
+}
+
+void UWarriorTargetingSubsystem::FindTargetCandidates(const APawn* InQuerier, const FVector& InViewLocation, const FRotator& InViewRotation, float InMaxDistance, float InMaxViewAngle, TArray<FWarriorTargetCandidate>& OutCandidates)
+{
+	check(InQuerier);
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorTargetingQuery);
+
+	OutCandidates.Reset();
+
+	RebuildIndexIfStale();
+
+	const IGenericTeamAgentInterface* QuerierTeamAgent = Cast<IGenericTeamAgentInterface>(InQuerier->GetController());
+
+	if (!QuerierTeamAgent || InMaxDistance <= 0.f || InMaxViewAngle <= 0.f)
+	{
+		return;
+	}
+
+	const FGenericTeamId QuerierTeamId = QuerierTeamAgent->GetGenericTeamId();
+	const FVector QuerierLocation = InQuerier->GetActorLocation();
+	const float MaxDistanceSquared = FMath::Square(InMaxDistance);
+
+	// One extra ring of cells covers pawns that crossed into range since the grid was built
+	const FIntPoint MinCell = GetCell(QuerierLocation - FVector(InMaxDistance)) - FIntPoint(1, 1);
+	const FIntPoint MaxCell = GetCell(QuerierLocation + FVector(InMaxDistance)) + FIntPoint(1, 1);
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const TArray<int32, TInlineAllocator<8>>* CellTargets = TargetsByCell.Find(FIntPoint(CellX, CellY));
+
+			if (!CellTargets)
+			{
+				continue;
+			}
+
+			for (const int32 TargetIndex : *CellTargets)
+			{
+				const FIndexedTarget& IndexedTarget = IndexedTargets[TargetIndex];
+				APawn* TargetPawn = IndexedTarget.Pawn.Get();
+
+				if (!TargetPawn || TargetPawn == InQuerier || IndexedTarget.TeamId == QuerierTeamId)
+				{
+					continue;
+				}
+
+				const FVector TargetLocation = TargetPawn->GetActorLocation();
+				const float DistanceSquared = FVector::DistSquared(QuerierLocation, TargetLocation);
+
+				if (DistanceSquared > MaxDistanceSquared)
+				{
+					continue;
+				}
+
+				const FVector LocalDirection = InViewRotation.UnrotateVector(TargetLocation - InViewLocation);
+				const float ViewYaw = FMath::RadiansToDegrees(FMath::Atan2(LocalDirection.Y, LocalDirection.X));
+
+				if (FMath::Abs(ViewYaw) > InMaxViewAngle)
+				{
+					continue;
+				}
+
+				// The index can be a few frames old, so a pawn that died since then is caught here
+				if (UWarriorFunctionLibrary::NativeDoesActorHaveStatus(TargetPawn, EWarriorStatusFlags::Dead))
+				{
+					continue;
+				}
+
+				const float Distance = FMath::Sqrt(DistanceSquared);
+
+				FWarriorTargetCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+				Candidate.Actor = TargetPawn;
+				Candidate.Distance = Distance;
+				Candidate.ViewYaw = ViewYaw;
+				Candidate.Score = AngleScoreWeight * FMath::Abs(ViewYaw) / InMaxViewAngle + (1.f - AngleScoreWeight) * Distance / InMaxDistance;
+			}
+		}
+	}
+
+	OutCandidates.Sort([](const FWarriorTargetCandidate& A, const FWarriorTargetCandidate& B)
+		{
+			return A.ViewYaw < B.ViewYaw;
+		});
+}
+
+void UWarriorTargetingSubsystem::RebuildIndexIfStale()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	if (!bIndexDirty && Now - LastRebuildTime < IndexMaxAge)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_WarriorTargetingIndexRebuild);
+
+	LastRebuildTime = Now;
+	bIndexDirty = false;
+
+	IndexedTargets.Reset();
+	TargetsByCell.Reset();
+
+	for (auto It = RegisteredTargets.CreateIterator(); It; ++It)
+	{
+		APawn* Pawn = It->Get();
+
+		if (!Pawn)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Pooled pawns sit hidden until they are spawned again
+		if (Pawn->IsHidden() || UWarriorFunctionLibrary::NativeDoesActorHaveStatus(Pawn, EWarriorStatusFlags::Dead))
+		{
+			continue;
+		}
+
+		const IGenericTeamAgentInterface* TeamAgent = Cast<IGenericTeamAgentInterface>(Pawn->GetController());
+
+		if (!TeamAgent)
+		{
+			continue;
+		}
+
+		const int32 TargetIndex = IndexedTargets.Num();
+
+		FIndexedTarget& IndexedTarget = IndexedTargets.AddDefaulted_GetRef();
+		IndexedTarget.Pawn = Pawn;
+		IndexedTarget.TeamId = TeamAgent->GetGenericTeamId();
+
+		TargetsByCell.FindOrAdd(GetCell(Pawn->GetActorLocation())).Add(TargetIndex);
+	}
+
+	SET_DWORD_STAT(STAT_WarriorTargetingIndexedPawns, IndexedTargets.Num());
+}
+
+FIntPoint UWarriorTargetingSubsystem::GetCell(const FVector& InLocation) const
+{
+	return FIntPoint(FMath::FloorToInt(InLocation.X / CellSize), FMath::FloorToInt(InLocation.Y / CellSize));
+}
@@ -0,0 +1,222 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WarriorWorldMarkerSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Components/SceneComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "WarriorStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("World Marker Projection"), STAT_WarriorWorldMarkerProjection, STATGROUP_Warrior);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("World Markers"), STAT_WarriorWorldMarkers, STATGROUP_Warrior);
+
+UWarriorWorldMarkerSubsystem* UWarriorWorldMarkerSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (GEngine)
+	{
+		if (UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull))
+		{
+			return World->GetSubsystem<UWarriorWorldMarkerSubsystem>();
+		}
+	}
+
+	return nullptr;
+}
+
+void UWarriorWorldMarkerSubsystem::Deinitialize()
+{
+	Markers.Empty();
+	bHasCachedView = false;
+
+	SET_DWORD_STAT(STAT_WarriorWorldMarkers, 0);
+
+	Super::Deinitialize();
+}
+
+void UWarriorWorldMarkerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WarriorWorldMarkerProjection);
+
+	UpdateCachedView();
+
+	for (int32 Index = Markers.Num() - 1; Index >= 0; --Index)
+	{
+		FWorldMarker& Marker = Markers[Index];
+
+		if (!Marker.Widget.IsValid())
+		{
+			Markers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		const USceneComponent* Anchor = Marker.Anchor.Get();
+		FVector2D WidgetPosition;
+
+		if (!Anchor || !ProjectToWidget(Anchor->GetComponentLocation() + Marker.WorldOffset, WidgetPosition))
+		{
+			SetMarkerShown(Marker, false);
+			continue;
+		}
+
+		SetMarkerShown(Marker, true);
+
+		// Sub pixel moves would only invalidate the render transform for nothing
+		if (!WidgetPosition.Equals(Marker.LastTranslation, 0.1f))
+		{
+			Marker.LastTranslation = WidgetPosition;
+			Marker.Widget->SetRenderTranslation(WidgetPosition);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_WarriorWorldMarkers, Markers.Num());
+}
+
+ETickableTickType UWarriorWorldMarkerSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UWarriorWorldMarkerSubsystem::IsTickable() const
+{
+	return !Markers.IsEmpty();
+}
+
+TStatId UWarriorWorldMarkerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWarriorWorldMarkerSubsystem, STATGROUP_Tickables);
+}
+
+void UWarriorWorldMarkerSubsystem::AddMarker(UUserWidget* InWidget, USceneComponent* InAnchor, FVector InWorldOffset, FVector2D InPivot)
+{
+	check(InWidget);
+
+	FWorldMarker* Marker = Markers.FindByPredicate([InWidget](const FWorldMarker& Existing)
+		{
+			return Existing.Widget == InWidget;
+		});
+
+	if (!Marker)
+	{
+		Marker = &Markers.AddDefaulted_GetRef();
+		Marker->Widget = InWidget;
+		Marker->ShownVisibility = InWidget->GetVisibility();
+
+		// The only layout change the marker ever makes, everything after this is a render translation
+		InWidget->SetAlignmentInViewport(InPivot);
+		InWidget->SetPositionInViewport(FVector2D::ZeroVector, false);
+
+		// Stays hidden until the next pass has projected it, rather than flashing in the corner for a frame
+		SetMarkerShown(*Marker, false);
+	}
+
+	Marker->Anchor = InAnchor;
+	Marker->WorldOffset = InWorldOffset;
+}
+
+void UWarriorWorldMarkerSubsystem::SetMarkerAnchor(UUserWidget* InWidget, USceneComponent* InAnchor)
+{
+	for (FWorldMarker& Marker : Markers)
+	{
+		if (Marker.Widget == InWidget)
+		{
+			Marker.Anchor = InAnchor;
+			return;
+		}
+	}
+}
+
+void UWarriorWorldMarkerSubsystem::RemoveMarker(UUserWidget* InWidget)
+{
+	const int32 Index = Markers.IndexOfByPredicate([InWidget](const FWorldMarker& Existing)
+		{
+			return Existing.Widget == InWidget;
+		});
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	SetMarkerShown(Markers[Index], true);
+
+	Markers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool UWarriorWorldMarkerSubsystem::ProjectToWidget(const FVector& InWorldLocation, FVector2D& OutWidgetPosition) const
+{
+	if (!bHasCachedView)
+	{
+		return false;
+	}
+
+	FVector2D ScreenPosition;
+
+	if (!FSceneView::ProjectWorldToScreen(InWorldLocation, CachedViewRect, CachedViewProjectionMatrix, ScreenPosition))
+	{
+		return false;
+	}
+
+	// Same result as ProjectWorldLocationToWidgetPosition with bPlayerViewportRelative
+	OutWidgetPosition = (ScreenPosition - FVector2D(CachedViewRect.Min)) / CachedViewportScale;
+
+	return true;
+}
+
+void UWarriorWorldMarkerSubsystem::UpdateCachedView()
+{
+	if (bHasCachedView && CachedViewFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	bHasCachedView = false;
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+
+	if (!LocalPlayer || !LocalPlayer->ViewportClient)
+	{
+		return;
+	}
+
+	FSceneViewProjectionData ProjectionData;
+
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return;
+	}
+
+	CachedViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	CachedViewRect = ProjectionData.GetConstrainedViewRect();
+	CachedViewOrigin = ProjectionData.ViewOrigin;
+	CachedViewportScale = UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+
+	if (CachedViewportScale <= 0.f)
+	{
+		return;
+	}
+
+	ViewportWidgetSize = FVector2D(CachedViewRect.Size()) / CachedViewportScale;
+	CachedViewFrame = GFrameCounter;
+	bHasCachedView = true;
+}
+
+void UWarriorWorldMarkerSubsystem::SetMarkerShown(FWorldMarker& InOutMarker, bool bInShown)
+{
+	if (InOutMarker.bIsShown == bInShown)
+	{
+		return;
+	}
+
+	InOutMarker.bIsShown = bInShown;
+
+	if (UUserWidget* Widget = InOutMarker.Widget.Get())
+	{
+		// Hidden keeps the widget's slot size, so toggling it does not ask the viewport for a new layout
+		Widget->SetVisibility(bInShown ? InOutMarker.ShownVisibility : ESlateVisibility::Hidden);
+	}
+}
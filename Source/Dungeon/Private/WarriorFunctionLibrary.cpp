@@ -4,6 +4,7 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystem/WarriorAbilitySystemComponent.h"
 #include "Interfaces/PawnCombatInterface.h"
+#include "Characters/WarriorBaseCharacter.h"
 #include "GenericTeamAgentInterface.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "WarriorGameplayTags.h"
@@ -15,6 +16,12 @@ UWarriorAbilitySystemComponent* UWarriorFunctionLibrary::NativeGetWarriorASCFrom
 {
     check(InActor);
 
+    // Warrior characters keep their ASC pointer, which skips the interface lookup and the checked cast
+    if (const AWarriorBaseCharacter* WarriorCharacter = Cast<AWarriorBaseCharacter>(InActor))
+    {
+        return WarriorCharacter->GetWarriorAbilitySystemComponent();
+    }
+
     return CastChecked<UWarriorAbilitySystemComponent>(UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(InActor));
 }
 
@@ -42,9 +49,20 @@ bool UWarriorFunctionLibrary::NativeDoesActorHaveTag(AActor* InActor, FGameplayT
 {
     UWarriorAbilitySystemComponent* ASC = NativeGetWarriorASCFromActor(InActor);
 
+    const EWarriorStatusFlags StatusFlag = UWarriorAbilitySystemComponent::GetStatusFlagForTag(TagToCheck);
+    if (StatusFlag != EWarriorStatusFlags::None)
+    {
+        return ASC->HasAnyStatus(StatusFlag);
+    }
+
     return ASC->HasMatchingGameplayTag(TagToCheck);
 }
 
+bool UWarriorFunctionLibrary::NativeDoesActorHaveStatus(AActor* InActor, EWarriorStatusFlags InStatusFlags)
+{
+    return NativeGetWarriorASCFromActor(InActor)->HasAnyStatus(InStatusFlags);
+}
+
 void UWarriorFunctionLibrary::BP_DoesActorHaveTag(AActor* InActor, FGameplayTag TagToCheck, EWarriorConfirmType& OutConfirmType)
 {
     OutConfirmType = NativeDoesActorHaveTag(InActor, TagToCheck) ? EWarriorConfirmType::Yes : EWarriorConfirmType::No;
@@ -132,7 +150,14 @@ bool UWarriorFunctionLibrary::IsValidBlock(AActor* InAttacker, AActor* InDefende
 {
     check(InAttacker && InDefender);
 
-    const float DotResult = FVector::DotProduct(InAttacker->GetActorForwardVector(), InDefender->GetActorForwardVector());
+    return NativeIsValidBlockFromDirection(InAttacker->GetActorForwardVector(), InDefender);
+}
+
+bool UWarriorFunctionLibrary::NativeIsValidBlockFromDirection(const FVector& InAttackDirection, AActor* InDefender)
+{
+    check(InDefender);
+
+    const float DotResult = FVector::DotProduct(InAttackDirection, InDefender->GetActorForwardVector());
 
     //const FString DebugString = FString::Printf(TEXT("Dot Result: %f %s"), DotResult, DotResult < 0.f ? TEXT("Valid Block") : TEXT("InValid Block"));
     
@@ -151,6 +176,41 @@ bool UWarriorFunctionLibrary::ApplyGameplayEffectSpecHandleToTargetActor(AActor*
     return ActiveGameplayEffectHandle.WasSuccessfullyApplied();
 }
 
+int32 UWarriorFunctionLibrary::ApplyGameplayEffectSpecHandleToTargetActors(AActor* InInstigator, const TArray<AActor*>& InTargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors)
+{
+    UWarriorAbilitySystemComponent* SourceASC = InInstigator ? NativeGetWarriorASCFromActor(InInstigator) : nullptr;
+
+    return NativeApplyGameplayEffectSpecHandleToTargetActors(SourceASC, InTargetActors, InSpecHandle, OutAffectedActors);
+}
+
+int32 UWarriorFunctionLibrary::NativeApplyGameplayEffectSpecHandleToTargetActors(UAbilitySystemComponent* InSourceASC, const TArray<AActor*>& InTargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors)
+{
+    OutAffectedActors.Reset();
+
+    if (!InSourceASC || InTargetActors.IsEmpty() || !InSpecHandle.IsValid())
+    {
+        return 0;
+    }
+
+    OutAffectedActors.Reserve(InTargetActors.Num());
+
+    for (AActor* TargetActor : InTargetActors)
+    {
+        UAbilitySystemComponent* TargetASC = TargetActor ? UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(TargetActor) : nullptr;
+        if (!TargetASC)
+        {
+            continue;
+        }
+
+        if (InSourceASC->ApplyGameplayEffectSpecToTarget(*InSpecHandle.Data, TargetASC).WasSuccessfullyApplied())
+        {
+            OutAffectedActors.Add(TargetActor);
+        }
+    }
+
+    return OutAffectedActors.Num();
+}
+
 void UWarriorFunctionLibrary::CountDown(const UObject* WorldContextObject, float TotalTime, float UpdateInterval, float& OutRemainingTime, EWarriorCountDownActionInput CountDownInput, UPARAM(DisplayName = "Output") EWarriorCountDownActionOutput& CountDownOutput, FLatentActionInfo LatentInfo)
 {
     UWorld* World = nullptr;
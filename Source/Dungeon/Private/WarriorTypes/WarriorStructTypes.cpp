@@ -8,3 +8,22 @@ bool FWarriorHeroAbilitySet::IsValid() const
 {
 	return InputTag.IsValid() && AbilityToGrant;
 }
+
+void FWarriorMeleeTraceSettings::GetBoxTraceSegment(const FVector& InBoxExtent, FVector& OutLocalStart, FVector& OutLocalEnd)
+{
+	const int32 LongestAxis = InBoxExtent.X >= InBoxExtent.Y ? (InBoxExtent.X >= InBoxExtent.Z ? 0 : 2) : (InBoxExtent.Y >= InBoxExtent.Z ? 1 : 2);
+
+	OutLocalEnd = FVector::ZeroVector;
+	OutLocalEnd[LongestAxis] = InBoxExtent[LongestAxis];
+	OutLocalStart = -OutLocalEnd;
+}
+
+FHitResult FWarriorSwingHitRecord::ToHitResult() const
+{
+	FHitResult HitResult(HitActor.Get(), nullptr, ImpactPoint, ImpactNormal);
+	HitResult.BoneName = BoneName;
+	HitResult.Location = ImpactPoint;
+	HitResult.bBlockingHit = true;
+
+	return HitResult;
+}
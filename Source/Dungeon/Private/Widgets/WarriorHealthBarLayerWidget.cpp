@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Widgets/WarriorHealthBarLayerWidget.h"
+#include "Subsystems/WarriorHealthBarSubsystem.h"
+#include "Rendering/DrawElements.h"
+
+void UWarriorHealthBarLayerWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+int32 UWarriorHealthBarLayerWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	const UWarriorHealthBarSubsystem* Source = HealthBarSource.Get();
+
+	if (!Source || Source->GetVisibleBars().IsEmpty())
+	{
+		return LayerId;
+	}
+
+	const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+	const FLinearColor TintedBackgroundColor = BackgroundColor * Tint;
+	const FLinearColor TintedFillColor = FillColor * Tint;
+	const FVector2D HalfBarSize = BarSize * 0.5f;
+
+	// Every background shares one layer and brush, and so does every fill, which lets Slate batch each into one draw
+	const int32 BackgroundLayerId = LayerId + 1;
+	const int32 FillLayerId = LayerId + 2;
+
+	for (const FWarriorHealthBarDrawData& Bar : Source->GetVisibleBars())
+	{
+		const FSlateLayoutTransform BarTransform(Bar.Position - HalfBarSize);
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			BackgroundLayerId,
+			AllottedGeometry.ToPaintGeometry(BarSize, BarTransform),
+			&BackgroundBrush,
+			ESlateDrawEffect::None,
+			TintedBackgroundColor
+		);
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			FillLayerId,
+			AllottedGeometry.ToPaintGeometry(FVector2D(BarSize.X * Bar.HealthFraction, BarSize.Y), BarTransform),
+			&FillBrush,
+			ESlateDrawEffect::None,
+			TintedFillColor
+		);
+	}
+
+	return FillLayerId;
+}
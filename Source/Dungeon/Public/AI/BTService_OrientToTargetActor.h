@@ -21,8 +21,16 @@ class DUNGEON_API UBTService_OrientToTargetActor : public UBTService
 	virtual FString GetStaticDescription() const override;
 	//~ End UBTNode Interface
 
+	//~ Begin UBTAuxiliaryNode Interface
+	virtual void OnCeaseRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	//~ End UBTAuxiliaryNode Interface
+
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 
+	//~ Begin UBTService Interface
+	virtual void ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	//~ End UBTService Interface
+
 	UPROPERTY(EditAnywhere, Category = "Target")
 	FBlackboardKeySelector InTargetActorKey;
 
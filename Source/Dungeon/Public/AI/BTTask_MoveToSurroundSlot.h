@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_MoveTo.h"
+#include "BTTask_MoveToSurroundSlot.generated.h"
+
+/**
+ * Moves the enemy to the melee ring slot UWarriorCrowdDensitySubsystem writes to the SurroundSlotLocation key.
+ * Fails straight away while the enemy has no slot, so a selector can fall back to chasing the target. The key is
+ * observed, so the move follows the slot as the ring is rebuilt around a moving target.
+ */
+UCLASS()
+class DUNGEON_API UBTTask_MoveToSurroundSlot : public UBTTask_MoveTo
+{
+	GENERATED_BODY()
+
+	UBTTask_MoveToSurroundSlot(const FObjectInitializer& ObjectInitializer);
+
+	//~ Begin UBTNode Interface
+	virtual FString GetStaticDescription() const override;
+	//~ End UBTNode Interface
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "WarriorBehaviorTreeComponent.generated.h"
+
+class UBTNode;
+
+/**
+ * Behaviour tree component created by AWarriorAIController, so RunBehaviorTree uses it instead of spawning the stock one.
+ * While UWarriorBTProfilerSubsystem is enabled it times every tree tick and attributes it to the task that was active,
+ * which gives a per branch cost for any node in the tree, Blueprint and engine nodes included.
+ */
+UCLASS()
+class DUNGEON_API UWarriorBehaviorTreeComponent : public UBehaviorTreeComponent
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+private:
+	// Task that was active on the last profiled tick, a change counts as an activation of the new one
+	TWeakObjectPtr<const UBTNode> LastProfiledNode;
+
+	// "<Tree> / <Task>" of LastProfiledNode, rebuilt only when the active task changes
+	FName LastProfiledBranchName;
+};
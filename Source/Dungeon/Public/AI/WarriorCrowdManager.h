@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Navigation/CrowdManager.h"
+#include "WarriorCrowdManager.generated.h"
+
+/**
+ * Detour crowd manager that times its own simulation step, so crowd cost can be budgeted and reported.
+ * Set as CrowdManagerClass of the navigation system in DefaultEngine.ini; every other setting is inherited from
+ * the [/Script/AIModule.CrowdManager] section.
+ */
+UCLASS()
+class DUNGEON_API UWarriorCrowdManager : public UCrowdManager
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCrowdManagerBase Interface
+	virtual void Tick(float DeltaTime) override;
+	//~ End UCrowdManagerBase Interface
+
+	// Smoothed simulation time of the crowd in InWorld, zero when the world does not use this manager
+	static float GetAverageSimulationMs(UWorld* InWorld);
+
+	float GetLastSimulationMs() const { return LastSimulationMs; }
+	float GetAverageSimulationMs() const { return AverageSimulationMs; }
+
+private:
+	float LastSimulationMs = 0.f;
+	float AverageSimulationMs = 0.f;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystem/Abilities/WarriorHeroGameplayAbility.h"
+#include "Subsystems/WarriorTargetingSubsystem.h"
 #include "HeroGameplayAbility_TargetLock.generated.h"
 
 class UWarriorWidgetBase;
@@ -31,10 +32,10 @@ protected:
 private:
 	void TryLockOnTarget();
 	void GetAvailableActorsToLock();
-	AActor* GetNearestTargetFromAvailableActors(const TArray<AActor*>& InAvailableActors);
-	void GetAvailableActorsAroundTarget(TArray<AActor*>& OutActorsOnLeft, TArray<AActor*>& OutActorsOnRight);
+	AActor* GetBestTargetFromAvailableActors() const;
+	AActor* GetNextTargetAroundCurrent(bool bSearchLeft) const;
 	void DrawTargetLockWidget();
-	void SetTargetLockWidgetPosition();
+	void SetTargetLockWidgetAnchor();
 	void InitTargetLockMovement();
 	void InitTargetLockMappingContext();
 
@@ -44,16 +45,11 @@ private:
 	void ResetTargetLockMappingContext();
 
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
-	float BoxTraceDistance = 5000.f;
+	float TargetLockDistance = 5000.f;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
-	FVector TraceBoxSize = FVector(5000.f, 5000.f, 300.f);
-
-	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
-	TArray< TEnumAsByte < EObjectTypeQuery > > BoxTraceChannel;
-
-	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
-	bool bShowPersistanceDebugShape = false;
+	// Degrees to either side of the camera direction in which enemies can be locked on to
+	UPROPERTY(EditDefaultsOnly, Category = "Target Lock", meta = (ClampMin = "1.0", ClampMax = "180.0"))
+	float TargetLockMaxViewAngle = 70.f;
 
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
 	TSubclassOf<UWarriorWidgetBase> TargetLockWidgetClass;
@@ -70,8 +66,8 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Target Lock")
 	float TargetLockCameraOffsetDistance = 20.f;
 
-	UPROPERTY()
-	TArray<AActor*> AvailableActorsToLock;
+	// Sorted by view yaw from left to right, filled by UWarriorTargetingSubsystem
+	TArray<FWarriorTargetCandidate> AvailableActorsToLock;
 
 	UPROPERTY()
 	AActor* CurrentLockedActor;
@@ -79,9 +75,6 @@ private:
 	UPROPERTY()
 	UWarriorWidgetBase* DrawnTargetLockWidget;
 
-	UPROPERTY()
-	FVector2D TargetLockWidgetSize = FVector2D::ZeroVector;
-
 	UPROPERTY()
 	float CachedDefaultMaxWalkSpeed = 0.f;
 };
@@ -8,6 +8,7 @@
 
 class AWarriorEnemyCharacter;
 class UEnemyCombatComponent;
+class UWarriorAttackTokenSubsystem;
 /**
  * 
  */
@@ -26,6 +27,32 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Warrior|Ability")
 	FGameplayEffectSpecHandle MakeEnemyDamageEffectSpecHandle(TSubclassOf<UGameplayEffect> EffectClass, const FScalableFloat& InDamageScalableFloat);
 
+protected:
+	//~ Begin UGameplayAbility Interface.
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, OUT FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
+	//~ End UGameplayAbility Interface
+
+	// Melee abilities only activate once the target hands this enemy an attack token, see UWarriorAttackTokenSubsystem
+	UPROPERTY(EditDefaultsOnly, Category = "WarriorAbility|Attack Token")
+	bool bRequiresAttackToken = true;
+
+	// Higher priorities win tokens over closer enemies, e.g. for finishers or elite attacks
+	UPROPERTY(EditDefaultsOnly, Category = "WarriorAbility|Attack Token", meta = (EditCondition = "bRequiresAttackToken"))
+	int32 AttackTokenPriority = 0;
+
 private:
+	bool NeedsAttackToken() const;
+
+	// Returns the token subsystem when the avatar has a target to contend for, null otherwise
+	static UWarriorAttackTokenSubsystem* GetAttackTokenContext(const FGameplayAbilityActorInfo* ActorInfo, APawn*& OutEnemyPawn, AActor*& OutTargetActor);
+
+	// Returns false when the target has no token for this enemy. Succeeds without a token when there is no target.
+	bool TryAcquireAttackToken(const FGameplayAbilityActorInfo* ActorInfo);
+
 	TWeakObjectPtr<AWarriorEnemyCharacter> CachedWarriorEnemyCharacter;
+
+	// Set only while this instance holds the attack token it took itself
+	bool bHoldsAttackToken = false;
 };
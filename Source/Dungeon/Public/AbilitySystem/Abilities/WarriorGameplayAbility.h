@@ -44,6 +44,24 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability", meta = (DisplayName = "Apply Gameplay Effect Spec Handle To Target Actor", ExpandEnumAsExecs = "OutSuccessType"))
 	FActiveGameplayEffectHandle BP_ApplyEffectSpecHandleToTarget(AActor* TargetActor, const FGameplayEffectSpecHandle& InSpecHandle, EWarriorSuccessType& OutSuccessType);
 
+	// Applies one spec to every target with a single source ASC lookup. Returns the number of successful applications.
+	int32 NativeApplyEffectSpecHandleToTargets(const TArray<AActor*>& TargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors);
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability", meta = (DisplayName = "Apply Gameplay Effect Spec Handle To Target Actors"))
+	int32 BP_ApplyEffectSpecHandleToTargets(const TArray<AActor*>& TargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors);
+
 	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability")
 	void ApplyGameplayEffectSpecHandleToHitResults(const FGameplayEffectSpecHandle& InSpecHandle, const TArray<FHitResult>& InHitResults);
+
+	// Returns the damage spec cached for InSpecKey during this activation, or an invalid handle
+	FGameplayEffectSpecHandle FindCachedDamageSpec(uint32 InSpecKey) const;
+
+	// Keeps InSpecHandle so later hits of the same swing reuse it instead of building a new spec per victim.
+	// The key covers what is fixed when the spec is made; callers set the SetByCaller magnitudes again on every reuse.
+	void CacheDamageSpec(uint32 InSpecKey, const FGameplayEffectSpecHandle& InSpecHandle);
+
+private:
+	// Damage spec built for the current swing. Cleared when the ability ends.
+	FGameplayEffectSpecHandle CachedDamageSpecHandle;
+	uint32 CachedDamageSpecKey = 0;
 };
@@ -19,14 +19,22 @@ class DUNGEON_API UAbilityTask_WaitSpawnEnemies : public UAbilityTask
 	GENERATED_BODY()
 	
 public:
-	UFUNCTION(BlueprintCallable, Category = "Warrior|AbilityTasks", meta = (DisplayName = "Wait Gameplay Event and Spawn Enemies", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true", NumToSpawn = "1", RandomSpawnRadius = "200"))
+	/**
+	 * Spawns are spread over frames. Each frame activates up to MaxSpawnsPerFrame enemies and stops early once
+	 * SpawnBudgetMs is used up, but always activates at least one. Zero disables a limit. OnSpawnFinished is
+	 * broadcast once every enemy is live. With bPrioritizeNearView the spawn points closest to the player's view go first.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Warrior|AbilityTasks", meta = (DisplayName = "Wait Gameplay Event and Spawn Enemies", HidePin = "OwningAbility", DefaultToSelf = "OwningAbility", BlueprintInternalUseOnly = "true", NumToSpawn = "1", RandomSpawnRadius = "200", MaxSpawnsPerFrame = "4", SpawnBudgetMs = "2"))
 	static UAbilityTask_WaitSpawnEnemies* WaitSpawnEnemies(
 		UGameplayAbility* OwningAbility,
 		FGameplayTag EventTag,
 		TSoftClassPtr<AWarriorEnemyCharacter> SoftEnemyClassToSpawn,
 		int32 NumToSpawn,
 		const FVector& SpawnOrigin,
-		float RandomSpawnRadius
+		float RandomSpawnRadius,
+		int32 MaxSpawnsPerFrame = 4,
+		float SpawnBudgetMs = 2.f,
+		bool bPrioritizeNearView = true
 		);
 
 	UPROPERTY(BlueprintAssignable)
@@ -46,8 +54,29 @@ private:
 	int32 CachedNumToSpawn;
 	FVector CachedSpawnOrigin;
 	float CachedRandomSpawnRadius;
+	int32 CachedMaxSpawnsPerFrame;
+	float CachedSpawnBudgetMs;
+	bool bCachedPrioritizeNearView;
 	FDelegateHandle DelegateHandle;
 
+	// Spawn transforms still waiting for a frame with budget, in spawn order
+	TArray<FTransform> PendingSpawnTransforms;
+	int32 NextPendingSpawnIndex = 0;
+
+	// Set by the first spawn event, from the class load until FinishSpawning ends the task
+	bool bIsSpawningWave = false;
+
+	UPROPERTY()
+	TArray<AWarriorEnemyCharacter*> SpawnedEnemies;
+
 	void OnGameplayEventReceived(const FGameplayEventData* InPayLoad);
 	void OnEnemyClassLoaded();
+
+	// Orders PendingSpawnTransforms so points nearest the local player's view, and in front of it, come first
+	void SortPendingSpawnsByViewDistance();
+
+	// Activates the next slice of pending spawns and queues itself for the next frame until none are left
+	void SpawnNextBatch();
+
+	void FinishSpawning();
 };
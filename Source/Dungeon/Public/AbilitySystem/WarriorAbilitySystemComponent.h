@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
 #include "WarriorTypes/WarriorStructTypes.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorAbilitySystemComponent.generated.h"
 
 /**
@@ -27,4 +28,21 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Warrior|Ability")
 	bool TryActivateAbilityByTag(FGameplayTag AbilityTagToActivate);
+
+	// Returns the status bit mirroring InTag, or None if the tag is not one of the tracked status tags
+	static EWarriorStatusFlags GetStatusFlagForTag(const FGameplayTag& InTag);
+
+	FORCEINLINE EWarriorStatusFlags GetStatusFlags() const { return StatusFlags; }
+
+	// True if any of InFlags is set
+	FORCEINLINE bool HasAnyStatus(EWarriorStatusFlags InFlags) const { return EnumHasAnyFlags(StatusFlags, InFlags); }
+
+protected:
+	//~ Begin UAbilitySystemComponent Interface
+	virtual void OnTagUpdated(const FGameplayTag& Tag, bool TagExists) override;
+	//~ End UAbilitySystemComponent Interface
+
+private:
+	// Tracked status tags currently on this component, kept in step with the tag count container
+	EWarriorStatusFlags StatusFlags = EWarriorStatusFlags::None;
 };
@@ -8,6 +8,7 @@
 #include "WarriorAttributeSet.generated.h"
 
 class IPawnUIInterface;
+class UPawnUIComponent;
 
 #define ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
 GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
@@ -28,6 +29,10 @@ public:
 
 	virtual void PostGameplayEffectExecute(const struct FGameplayEffectModCallbackData& Data) override;
 
+	// Runs the same clamping and UI updates PostGameplayEffectExecute would for InAttribute.
+	// Used after a base value is written directly instead of through a gameplay effect.
+	void HandleBaseValueWritten(AActor* InAvatarActor, const FGameplayAttribute& InAttribute);
+
 	UPROPERTY(BlueprintReadOnly, Category = "Health")
 	FGameplayAttributeData CurrentHealth;
 	ATTRIBUTE_ACCESSORS(UWarriorAttributeSet, CurrentHealth)
@@ -57,5 +62,10 @@ public:
 	ATTRIBUTE_ACCESSORS(UWarriorAttributeSet, DamageTaken)
 
 private:
+	UPawnUIComponent* GetPawnUIComponentFromAvatar(AActor* InAvatarActor);
+
+	void HandleCurrentHealthChanged(UPawnUIComponent* InPawnUIComponent);
+	void HandleCurrentRageChanged(AActor* InAvatarActor);
+
 	TWeakInterfacePtr<IPawnUIInterface> CachedPawnUIInterface;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Characters/WarriorBaseCharacter.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
 // #include "Inventory/InventoryItemActor.h" // Removed
 #include "WarriorEnemyCharacter.generated.h"
 
@@ -11,6 +12,7 @@ class UEnemyCombatComponent;
 class UEnemyUIComponent;
 class UWidgetComponent;
 class UBoxComponent;
+class UMaterialInterface;
 /**
  * 
  */
@@ -31,8 +33,32 @@ public:
 	virtual UEnemyUIComponent* GetEnemyUIComponent() const override;
 	//~ End IPawnUIInterface Interface
 
+	// Marks this enemy as owned by UWarriorEnemyPoolSubsystem, so death returns it to the pool
+	void SetPooled(bool bInPooled) { bIsPooled = bInPooled; }
+
+	// Hides the enemy and turns off collision, movement, ticking and AI logic while it waits in the pool
+	void DeactivateForPool();
+
+	// Places the enemy at InTransform with full health, no leftover status tags or target, and the mesh materials and
+	// collision it spawned with, then turns it back on
+	void ActivateFromPool(const FTransform& InTransform);
+
+	// Returns a pooled enemy to its pool, or destroys it if it was spawned outside the pool. Death abilities call
+	// this once their montage and dissolve are done.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|EnemyPool")
+	void ReleaseToPoolOrDestroy();
+
+	//~ Begin AActor Interface
+	// Death Blueprints that end with DestroyActor hand pooled enemies back to the pool instead
+	virtual void K2_DestroyActor() override;
+	//~ End AActor Interface
+
+	// Written by UWarriorAISignificanceSubsystem when it moves this enemy to another update rate bucket
+	void SetAISignificance(EWarriorAISignificance InSignificance) { AISignificance = InSignificance; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	//~ Begin APawn Interface
 	virtual void PossessedBy(AController* NewController) override;
@@ -65,14 +91,69 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
 	UWidgetComponent* EnemyHealthWidgetComponent;
 
+	// Draws the health bar through UWarriorHealthBarSubsystem's shared HUD layer. The widget component is then hidden at BeginPlay.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+	bool bUseHealthBarLayer = true;
+
+	// Spawn tasks take this enemy from UWarriorEnemyPoolSubsystem and death hands it back there. Only turn this on
+	// once ActivateFromPool and On Activated From Pool undo everything this class's death flow changes.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Warrior|EnemyPool")
+	bool bUseEnemyPool = false;
+
+	// Lets Blueprint reset anything the death flow changed that ActivateFromPool does not, such as attached weapons
+	UFUNCTION(BlueprintImplementableEvent, Category = "Warrior|EnemyPool", meta = (DisplayName = "On Activated From Pool"))
+	void BP_OnActivatedFromPool();
+
 	UFUNCTION()
 	virtual void OnBodyCollisioinBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
 private:
 	void InitEnemyStartUpData();
 
+	// Records the mesh materials and collision settings that ActivateFromPool restores
+	void CachePoolResetState();
+	void RestorePoolResetState();
+
+	UFUNCTION()
+	void OnHealthBarPercentChanged(float NewPercent);
+
+	// Hard reference that keeps the shared start up data, and its compiled grant template, loaded while enemies use it
+	UPROPERTY(Transient)
+	TObjectPtr<UDataAsset_StartUpDataBase> LoadedStartUpData;
+
+	bool bIsPooled = false;
+
+	// Set at BeginPlay when the health bar layer took over from EnemyHealthWidgetComponent
+	bool bHealthBarOnLayer = false;
+
+	struct FPoolCollisionState
+	{
+		FName ProfileName;
+		ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::NoCollision;
+		ECollisionChannel ObjectType = ECC_Pawn;
+		FCollisionResponseContainer Responses;
+
+		void Cache(const UPrimitiveComponent* InComponent);
+		void Restore(UPrimitiveComponent* InComponent) const;
+	};
+
+	// Captured before Blueprint BeginPlay, so dynamic material instances made by the death flow are dropped on reuse
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UMaterialInterface>> PoolInitialMeshMaterials;
+
+	FPoolCollisionState PoolInitialCapsuleCollision;
+	FPoolCollisionState PoolInitialMeshCollision;
+	FTransform PoolInitialMeshRelativeTransform;
+
+	EWarriorAISignificance AISignificance = EWarriorAISignificance::High;
+
 public:
 	FORCEINLINE UEnemyCombatComponent* GetEnemyCombatComponent() const { return EnemyCombatComponent; }
 	FORCEINLINE UBoxComponent* GetLeftHandCollisionBox() const { return LeftHandCollisionBox; }
 	FORCEINLINE UBoxComponent* GetRightHandCollisionBox() const { return RightHandCollisionBox; }
+	FORCEINLINE UWidgetComponent* GetEnemyHealthWidgetComponent() const { return EnemyHealthWidgetComponent; }
+	FORCEINLINE bool IsPooled() const { return bIsPooled; }
+	FORCEINLINE bool IsHealthBarOnLayer() const { return bHealthBarOnLayer; }
+	FORCEINLINE bool UsesEnemyPool() const { return bUseEnemyPool; }
+	FORCEINLINE EWarriorAISignificance GetAISignificance() const { return AISignificance; }
 };
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Characters/WarriorBaseCharacter.h"
 #include "GameplayTagContainer.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorHeroCharacter.generated.h"
 
 class USpringArmComponent;
@@ -15,9 +16,11 @@ class USceneCaptureComponent2D;
 class USphereComponent;
 class AInteractableTable;
 class UCookingWidget;
+class UUserWidget;
 struct FInputActionValue;
 class UHeroCombatComponent;
 class UHeroUIComponent;
+class UHeroPortraitCaptureComponent;
 class UInventoryComponent;
 class AMyPlayerState;
 class AInventoryItemActor;
@@ -53,6 +56,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory | Interaction")
 	void PlaceItemOnTable(int32 SlotIndex);
 
+	// Places Count items from one slot onto the current table in a single operation. The quantity is removed once,
+	// positions are laid out around the table's spawn point and the inventory UI is updated once. Returns the number placed.
+	UFUNCTION(BlueprintCallable, Category = "Inventory | Interaction")
+	int32 PlaceItemsOnTable(int32 SlotIndex, int32 Count, EWarriorItemPlacementLayout Layout = EWarriorItemPlacementLayout::Grid);
+
 protected:
 	//~ Begin APawn Interface.
 	virtual void PossessedBy(AController* NewController) override;
@@ -91,8 +99,16 @@ protected:
 
 	// Input handlers for slicing action
 	void Input_SliceStart();
+	void Input_SliceUpdate();
 	void Input_SliceEnd();
 
+	// Pushes a cursor position into the slice sample ring, skipping samples closer than SliceSampleMinSpacing
+	void RecordSliceSample(const FVector2D& ScreenPosition, bool bForce = false);
+
+	// Deprojects the buffered cursor samples in one pass and fits the cut plane to the swept ray fan.
+	// Returns false if the fan is degenerate or the plane misses the candidate's bounds.
+	bool FitSlicePlaneToSamples(const APlayerController* PlayerController, FVector& OutPlanePosition, FVector& OutPlaneNormal) const;
+
 	// Performs the actual slice on the item
 	void PerformSlice(AInventoryItemActor* ItemToSlice, const FVector& PlanePosition, const FVector& PlaneNormal);
 
@@ -104,6 +120,20 @@ protected:
 	UPROPERTY(Transient) // Use Transient as it's managed during gameplay
 	TWeakObjectPtr<UCookingWidget> CurrentCookingWidget;
 
+	// Prompt pinned over the interactable table in range through UWarriorWorldMarkerSubsystem. No prompt if unset.
+	UPROPERTY(EditDefaultsOnly, Category = "UI | Interaction")
+	TSubclassOf<UUserWidget> InteractPromptWidgetClass;
+
+	// Offset from the table's root at which the prompt is pinned
+	UPROPERTY(EditDefaultsOnly, Category = "UI | Interaction")
+	FVector InteractPromptWorldOffset = FVector(0.f, 0.f, 100.f);
+
+	UPROPERTY(Transient)
+	TObjectPtr<UUserWidget> InteractPromptWidget;
+
+	void ShowInteractPrompt(AActor* InInteractable);
+	void HideInteractPrompt();
+
 	// Particle effect to play when slicing
 	// Marked as deprecated, replace with Niagara. No longer exposed to editor/blueprints.
 	UPROPERTY()
@@ -134,6 +164,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = "true"))
 	USceneCaptureComponent2D* SceneCaptureComponent2D;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = "true"))
+	UHeroPortraitCaptureComponent* PortraitCaptureComponent;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat", meta = (AllowPrivateAccess = "true"))
 	UHeroCombatComponent* HeroCombatComponent;
 
@@ -172,18 +205,35 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Inventory | Interaction")
 	TSubclassOf<AInventoryItemActor> DefaultItemActorClass;
 
-	// Variables to store slice start/end points
+	// Minimum distance between items placed in one batch. Widened automatically for items with larger meshes.
+	UPROPERTY(EditDefaultsOnly, Category = "Inventory | Interaction", meta = (ClampMin = "0.0"))
+	float ItemPlacementSpacing = 20.f;
+
+	// Maximum number of cursor samples kept for a slice gesture. Oldest samples are overwritten on long drags.
+	UPROPERTY(EditDefaultsOnly, Category = "Input | Cooking", meta = (ClampMin = "2"))
+	int32 MaxSliceSamples = 32;
+
+	// Minimum cursor movement in pixels before another slice sample is recorded
+	UPROPERTY(EditDefaultsOnly, Category = "Input | Cooking", meta = (ClampMin = "0.0"))
+	float SliceSampleMinSpacing = 4.f;
+
+	// Variables to store slice start point and the sampled cursor path
 	FVector SliceStartWorldLocation = FVector::ZeroVector;
-	FVector SliceEndWorldLocation = FVector::ZeroVector;
 	FVector2D SliceStartScreenPosition = FVector2D::ZeroVector;
 	bool bIsDraggingSlice = false;
 
+	// Ring buffer of screen-space cursor samples taken while dragging
+	TArray<FVector2D> SliceScreenSamples;
+	int32 SliceSampleHead = 0;
+	int32 SliceSampleCount = 0;
+
     // Pointer to the item actor being dragged over at the start of a slice attempt
     UPROPERTY() // Keep track of the actor reference
     AInventoryItemActor* SlicedItemCandidate = nullptr;
 
 public:
 	FORCEINLINE UHeroCombatComponent* GetHeroCombatComponent() const { return HeroCombatComponent; }
+	FORCEINLINE UHeroPortraitCaptureComponent* GetPortraitCaptureComponent() const { return PortraitCaptureComponent; }
 
 	// Return Inventory Component
 	UInventoryComponent* GetInventoryComponent() const { return InventoryComponent; }
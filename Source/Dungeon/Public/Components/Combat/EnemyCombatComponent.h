@@ -19,4 +19,8 @@ public:
 
 protected:
 	virtual void ToggleBodyCollisionBoxCollision(bool bShouldEnable, EToggleDamageType ToggleDamageType) override;
+
+	// When enabled, the hand collision boxes are swept instead of relying on their overlap events
+	UPROPERTY(EditDefaultsOnly, Category = "Warrior Combat")
+	FWarriorMeleeTraceSettings BodyMeleeTraceSettings;
 };
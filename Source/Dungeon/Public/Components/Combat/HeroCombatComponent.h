@@ -27,4 +27,18 @@ public:
 
 	virtual void OnHitTargetActor(AActor* HitActor) override;
 	virtual void OnWeaponPulledFromTargetActor(AActor* InteractedActor) override;
+
+protected:
+	// Routes hit pauses through UWarriorHitPauseSubsystem. When off, Player.Event.HitPause is sent per hit as before.
+	UPROPERTY(EditDefaultsOnly, Category = "Warrior Combat|Hit Pause")
+	bool bUseHitPauseSubsystem = true;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Warrior Combat|Hit Pause", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseHitPauseSubsystem"))
+	float HitPauseIntensity = 1.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Warrior Combat|Hit Pause", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseHitPauseSubsystem"))
+	float PullOutHitPauseIntensity = 0.5f;
+
+private:
+	void RequestHitPause(AActor* InTargetActor, float InIntensity);
 };
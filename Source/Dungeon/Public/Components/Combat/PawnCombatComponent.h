@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Components/PawnExtensionComponentBase.h"
 #include "GameplayTagContainer.h"
+#include "WarriorTypes/WarriorStructTypes.h"
+#include "Components/Combat/WarriorSwingHitRegistry.h"
 #include "PawnCombatComponent.generated.h"
 
 class AWarriorWeaponBase;
@@ -25,6 +27,12 @@ class DUNGEON_API UPawnCombatComponent : public UPawnExtensionComponentBase
 	GENERATED_BODY()
 	
 public:
+	UPawnCombatComponent();
+
+	//~ Begin UActorComponent Interface
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
 	UFUNCTION(BlueprintCallable, Category = "Warrior Combat")
 	void RegisterSpawnedWeapon(FGameplayTag InWeaponTagToRegister, AWarriorWeaponBase* InWeaponToRegister, bool bRegisterAsEquippedWeapon = false);
 
@@ -42,13 +50,47 @@ public:
 
 	virtual void OnHitTargetActor(AActor* HitActor);
 	virtual void OnWeaponPulledFromTargetActor(AActor* InteractedActor);
+
+	// Returns the record of HitActor for the current swing, so hit pause, hit react and damage share one set of hit data
+	UFUNCTION(BlueprintCallable, Category = "Warrior Combat")
+	bool GetSwingHitRecord(AActor* InHitActor, FWarriorSwingHitRecord& OutHitRecord) const;
 	
 protected:
 	virtual void ToggleCurrentEquippedWeaponCollision(bool bShouldEnable);
 	virtual void ToggleBodyCollisionBoxCollision(bool bShouldEnable, EToggleDamageType ToggleDamageType);
 
-	TArray<AActor*> OverlappedActors;
+	// Starts sweeping InTraceComponent every frame until EndMeleeTrace. The segment is in the component's local space.
+	void BeginMeleeTrace(UPrimitiveComponent* InTraceComponent, const FWarriorMeleeTraceSettings& InSettings, const FVector& InLocalStart, const FVector& InLocalEnd);
+	void EndMeleeTrace(UPrimitiveComponent* InTraceComponent);
+
+	// Sends the pulled-from-target notification for everything hit this swing. Overlap mode gets this from end overlap events.
+	void NotifyMeleeTracePulledFromTargets();
+
+	// Registers HitActor for the current swing. Returns nullptr if it was already hit this swing.
+	const FWarriorSwingHitRecord* RegisterSwingHit(AActor* HitActor);
+
+	FWarriorSwingHitRegistry SwingHitRegistry;
 
 private:
+	struct FActiveMeleeTrace
+	{
+		TWeakObjectPtr<UPrimitiveComponent> TraceComponent;
+		FWarriorMeleeTraceSettings Settings;
+		FVector LocalStart = FVector::ZeroVector;
+		FVector LocalEnd = FVector::ZeroVector;
+		FTransform PreviousTransform;
+	};
+
+	using FMeleeTraceHitArray = TArray<FHitResult, TInlineAllocator<8>>;
+
+	// Sweeps one trace for this frame and adds the first hit on each new actor to InOutHits without handling it
+	void TickMeleeTrace(FActiveMeleeTrace& InOutTrace, float DeltaTime, FMeleeTraceHitArray& InOutHits);
+	void HandleMeleeTraceHit(const FHitResult& InHitResult);
+
+	TArray<FActiveMeleeTrace> ActiveMeleeTraces;
+
+	// Contact data of the sweep hit currently being reported through OnHitTargetActor
+	const FHitResult* PendingTraceHitResult = nullptr;
+
 	TMap<FGameplayTag, AWarriorWeaponBase*> CharacterCarriedWeaponMap;
 };
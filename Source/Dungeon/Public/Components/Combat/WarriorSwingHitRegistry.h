@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WarriorTypes/WarriorStructTypes.h"
+
+/**
+ * Swing-scoped set of actors hit by one attack, with the metadata of each hit.
+ * Lookups are hashed on the weak actor pointer, and BeginSwing is O(1): entries from older swings are left in the map
+ * and ignored by generation until the map is compacted.
+ */
+class DUNGEON_API FWarriorSwingHitRegistry
+{
+public:
+	// Starts a new swing. Everything registered before is forgotten.
+	void BeginSwing();
+
+	bool HasHit(const AActor* InActor) const { return FindHit(InActor) != nullptr; }
+
+	const FWarriorSwingHitRecord* FindHit(const AActor* InActor) const;
+
+	// Registers InActor for this swing. Returns nullptr if it was already hit this swing.
+	// The returned record is only valid until the next RegisterHit or BeginSwing.
+	const FWarriorSwingHitRecord* RegisterHit(AActor* InActor, const AActor* InInstigator, double InHitTime, const FHitResult* InHitResult = nullptr);
+
+	TConstArrayView<FWarriorSwingHitRecord> GetHits() const { return SwingHits; }
+
+	int32 Num() const { return SwingHits.Num(); }
+
+private:
+	struct FHitSlot
+	{
+		uint32 Generation = 0;
+		int32 HitIndex = INDEX_NONE;
+	};
+
+	// Stale entries are compacted away once the map grows past this
+	static constexpr int32 MaxStaleEntries = 128;
+
+	TMap<TWeakObjectPtr<const AActor>, FHitSlot, TInlineSetAllocator<32>> HitSlots;
+	TArray<FWarriorSwingHitRecord, TInlineAllocator<16>> SwingHits;
+	uint32 Generation = 1;
+};
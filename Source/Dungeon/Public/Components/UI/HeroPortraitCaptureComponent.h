@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HeroPortraitCaptureComponent.generated.h"
+
+class USceneCaptureComponent2D;
+class UUserWidget;
+class UTextureRenderTarget2D;
+
+/**
+ * Drives the hero portrait scene capture on demand instead of every frame.
+ * Captures only while at least one consuming widget is registered and visible, at CaptureRate,
+ * and skips the render entirely when the owner's pose and attached equipment have not changed.
+ */
+UCLASS(ClassGroup = (UI), meta = (BlueprintSpawnableComponent))
+class DUNGEON_API UHeroPortraitCaptureComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHeroPortraitCaptureComponent();
+
+	//~ Begin UActorComponent Interface
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	//~ End UActorComponent Interface
+
+	// Registers a widget that displays the capture. Capturing runs while any registered widget is visible.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Portrait")
+	void AddCaptureConsumer(UUserWidget* InConsumer);
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Portrait")
+	void RemoveCaptureConsumer(UUserWidget* InConsumer);
+
+	// Forces the next capture to render even if the pose has not changed
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Portrait")
+	void MarkCaptureDirty() { bForceNextCapture = true; }
+
+	void SetSceneCapture(USceneCaptureComponent2D* InSceneCapture);
+
+	// Render target the portrait is captured into, a transient copy when CaptureResolution differs from the asset
+	UFUNCTION(BlueprintPure, Category = "Warrior|Portrait")
+	UTextureRenderTarget2D* GetPortraitRenderTarget() const { return PortraitRenderTarget; }
+
+protected:
+	// Captures per second while a consumer is visible
+	UPROPERTY(EditDefaultsOnly, Category = "Portrait", meta = (ClampMin = "1.0"))
+	float CaptureRate = 15.f;
+
+	// Render target size used for the portrait. Zero keeps the size authored on the render target asset, any other
+	// size captures into a transient render target so the asset itself is never modified.
+	UPROPERTY(EditDefaultsOnly, Category = "Portrait")
+	FIntPoint CaptureResolution = FIntPoint(256, 256);
+
+	// When true, frames where the pose and equipment hash is unchanged are not rendered
+	UPROPERTY(EditDefaultsOnly, Category = "Portrait")
+	bool bSkipUnchangedPose = true;
+
+private:
+	bool HasVisibleConsumer();
+	uint32 ComputePoseHash() const;
+	void UpdateTickEnabled();
+	void RedirectConsumerImages(UUserWidget* InConsumer) const;
+
+	UPROPERTY()
+	TObjectPtr<USceneCaptureComponent2D> SceneCapture;
+
+	// Set only when the portrait is captured into a transient copy of this asset
+	UPROPERTY(Transient)
+	TObjectPtr<UTextureRenderTarget2D> AuthoredRenderTarget;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTextureRenderTarget2D> PortraitRenderTarget;
+
+	TArray<TWeakObjectPtr<UUserWidget>> CaptureConsumers;
+
+	uint32 LastCapturedPoseHash = 0;
+	bool bForceNextCapture = true;
+};
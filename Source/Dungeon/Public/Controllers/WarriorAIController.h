@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "Navigation/CrowdFollowingComponent.h"
 #include "WarriorAIController.generated.h"
 
 class UAIPerceptionComponent;
@@ -23,8 +24,34 @@ public:
 	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
 	//~ End IGenericTeamAgentInterface Interface
 
+	//~ Begin AAIController Interface
+	virtual void FindPathForMoveRequest(const FAIMoveRequest& MoveRequest, FPathFindingQuery& Query, FNavPathSharedPtr& OutPath) const override;
+	//~ End AAIController Interface
+
+	// Pauses or resumes the brain and perception while the possessed enemy sits in UWarriorEnemyPoolSubsystem
+	void SetPooledLogicPaused(bool bPaused);
+
+	// Caps crowd avoidance below DetourCrowdAvoidanceQuality, used by UWarriorAISignificanceSubsystem for distant enemies
+	void SetCrowdAvoidanceQualityLimit(ECrowdAvoidanceQuality::Type InMaxQuality);
+
+	// Called by UWarriorCrowdDensitySubsystem with the settings of this agent's density tier
+	void ApplyCrowdDensitySettings(ECrowdAvoidanceQuality::Type InMaxQuality, float InMaxQueryRange, bool bInMeleeRing);
+
+	// Writes the SurroundSlotLocation blackboard key that UBTTask_MoveToSurroundSlot moves to. The enemy's
+	// blackboard asset needs a Vector key with that name.
+	void SetSurroundSlotLocation(const FVector& InSlotLocation);
+	void ClearSurroundSlotLocation();
+
+	// Called by UWarriorPerceptionSubsystem when the cluster this enemy belongs to has a clear line to InActor
+	void HandleSharedPerceptionSighted(AActor* InActor);
+
+	bool HasTargetActor() const;
+
+	AActor* GetTargetActor() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UAIPerceptionComponent* EnemyPerceptionComponent;
@@ -36,6 +63,12 @@ protected:
 	virtual void OnEnemyPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
 
 private:
+	void SetTargetActorIfUnset(AActor* InActor);
+
+	// Sight comes from UWarriorPerceptionSubsystem instead of this controller's own sight sense
+	UPROPERTY(EditDefaultsOnly, Category = "Perception")
+	bool bUseSharedPerception = true;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Detour Crowd Avoidance Config")
 	bool bEnableDetourCrowdAvoidance = true;
 
@@ -44,4 +77,18 @@ private:
 
 	UPROPERTY(EditDefaultsOnly, Category = "Detour Crowd Avoidance Config", meta = (EditCondition = "bEnableDetourCrowdAvoidance"))
 	float CollisionQueryRange = 600.f;
+
+	ECrowdAvoidanceQuality::Type GetConfiguredCrowdAvoidanceQuality() const;
+
+	// Pushes the lowest of the configured quality and both limits to the crowd agent
+	void UpdateCrowdAvoidanceQuality();
+
+	ECrowdAvoidanceQuality::Type SignificanceQualityLimit = ECrowdAvoidanceQuality::High;
+	ECrowdAvoidanceQuality::Type DensityQualityLimit = ECrowdAvoidanceQuality::High;
+
+	// Settings last pushed to the crowd agent, so repeated limits with the same result skip the update
+	ECrowdAvoidanceQuality::Type AppliedCrowdAvoidanceQuality = ECrowdAvoidanceQuality::High;
+	float AppliedCollisionQueryRange = 0.f;
+	bool bAppliedMeleeRingGroups = false;
+	bool bHasSurroundSlot = false;
 };
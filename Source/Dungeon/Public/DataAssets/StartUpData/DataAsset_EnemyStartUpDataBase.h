@@ -16,8 +16,8 @@ class DUNGEON_API UDataAsset_EnemyStartUpDataBase : public UDataAsset_StartUpDat
 {
 	GENERATED_BODY()
 	
-public:
-	virtual void GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1) override;
+protected:
+	virtual void CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const override;
 
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "StartUpData")
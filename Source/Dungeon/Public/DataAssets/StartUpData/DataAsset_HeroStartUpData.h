@@ -15,8 +15,8 @@ class DUNGEON_API UDataAsset_HeroStartUpData : public UDataAsset_StartUpDataBase
 {
 	GENERATED_BODY()
 	
-public:
-	virtual void GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1) override;
+protected:
+	virtual void CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const override;
 
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "StartUpData", meta = (TitleProperty = "InputTag"))
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "GameplayAbilitySpec.h"
+#include "GameplayEffectTypes.h"
+#include "UObject/ObjectKey.h"
 #include "DataAsset_StartUpDataBase.generated.h"
 
 class UWarriorGameplayAbility;
@@ -18,7 +21,14 @@ class DUNGEON_API UDataAsset_StartUpDataBase : public UDataAsset
 	GENERATED_BODY()
 
 public:
-	virtual void GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+	// Grants the compiled template for ApplyLevel, compiling it on first use
+	void GiveToAbilitySystemComponent(UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+
+#if WITH_EDITOR
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+	//~ End UObject Interface
+#endif
 	
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "StartUpData")
@@ -30,5 +40,43 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "StartUpData")
 	TArray< TSubclassOf < UGameplayEffect > > StartUpGameplayEffects;
 
-	void GrantAbilities(const TArray< TSubclassOf < UWarriorGameplayAbility > >& InAbilitiesToGive, UWarriorAbilitySystemComponent* InASCToGive, int32 ApplyLevel = 1);
+	// Adds a spec for every ability this asset grants. Subclasses call Super and append their own.
+	virtual void CompileAbilitySpecs(int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs) const;
+
+	static void CompileAbilities(const TArray< TSubclassOf < UWarriorGameplayAbility > >& InAbilitiesToGive, int32 ApplyLevel, TArray<FGameplayAbilitySpec>& OutAbilitySpecs);
+
+private:
+	struct FStartUpAttributeMod
+	{
+		FGameplayAttribute Attribute;
+		TEnumAsByte<EGameplayModOp::Type> ModOp = EGameplayModOp::Additive;
+		float Magnitude = 0.f;
+	};
+
+	/**
+	 * Everything this asset gives at one level, resolved once and shared by every character using the asset.
+	 * Ability specs are copied per character with a fresh handle. Leading instant startup effects made only of
+	 * static modifiers are folded into AttributeBaseline and written straight to the attribute base values.
+	 */
+	struct FStartUpGrantTemplate
+	{
+		TArray<FGameplayAbilitySpec> AbilitySpecs;
+		TArray<FStartUpAttributeMod> AttributeBaseline;
+
+		// Startup effects that cannot be baked, applied through the ability system as before
+		TArray<TObjectPtr<const UGameplayEffect>> EffectsToApply;
+	};
+
+	const FStartUpGrantTemplate& GetOrCompileGrantTemplate(int32 ApplyLevel);
+
+	// Appends InEffect's modifiers to OutBaseline if applying it is the same as writing them to the base values
+	static bool TryBakeStartUpEffect(const UGameplayEffect* InEffect, int32 ApplyLevel, TArray<FStartUpAttributeMod>& OutBaseline);
+
+	// Compiled templates by apply level. Transient, rebuilt on first use after load or after an edit.
+	TMap<int32, FStartUpGrantTemplate> CompiledGrantTemplates;
+
+#if WITH_EDITOR
+	// World the templates were compiled in, so each play in editor session starts from fresh templates
+	FObjectKey CompiledForWorld;
+#endif
 };
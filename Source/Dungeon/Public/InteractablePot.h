@@ -93,6 +93,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Cooking|Data") // Blueprint에서도 필요하면 호출 가능하도록 설정
 	UDataTable* GetItemDataTable() const { return ItemDataTable.Get(); }
 
+	/** Returns the RecipeDataTable for read-only access. */
+	UFUNCTION(BlueprintPure, Category = "Cooking|Data")
+	UDataTable* GetRecipeDataTable() const { return RecipeDataTable.Get(); }
+
 	/** Returns the AudioManager for read-only access. */
 	UFUNCTION(BlueprintPure, Category = "Cooking|Audio")
 	UCookingAudioManager* GetAudioManager() const { return AudioManager.Get(); }
@@ -105,6 +109,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Cooking|Minigame")
 	void StartCookingMinigame();
 
+	// Switches between the minigame and the timing event system for the next StartCooking call
+	void SetUseMinigameSystem(bool bInUseMinigameSystem) { bUseMinigameSystem = bInUseMinigameSystem; }
+
 	// NEW: End the cooking minigame with result
 	UFUNCTION(BlueprintCallable, Category = "Cooking|Minigame")
 	void EndCookingMinigame(ECookingMinigameResult Result);
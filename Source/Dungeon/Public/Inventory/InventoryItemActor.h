@@ -84,13 +84,13 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory")
 	void OnItemDataUpdated(); // Restored event
 
-	// Flag to enable physics on the next tick after dropping
+	// Flag set while a physics enable is queued on the deferred action subsystem, so repeated requests collapse into one
 	bool bEnablePhysicsRequested = false;
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Consumes bEnablePhysicsRequested. Runs from the deferred action queue one frame after RequestEnablePhysics.
+	void ApplyRequestedPhysics();
 
+public:
 	// Returns the item data stored in this actor
 	UFUNCTION(BlueprintPure, Category = "Inventory")
 	FSlotStruct GetItemData() const { return Item; }
@@ -99,7 +99,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void SetItemData(const FSlotStruct& NewItem);
 
-	// Function to request physics enable on next tick
+	// Sets the item on an actor spawned with SpawnActorDeferred, before FinishSpawning.
+	// OnConstruction then does the only DataTable lookup and mesh build for the actor.
+	void SetItemDataForDeferredSpawn(const FSlotStruct& NewItem) { Item = NewItem; }
+
+	// Function to request physics enable on the next frame (queued on UWarriorDeferredActionSubsystem, no actor tick needed)
 	void RequestEnablePhysics();
 
 	// Function called to slice this item
@@ -9,6 +9,7 @@
 
 class UBoxComponent;
 class UNiagaraComponent;
+class UNiagaraSystem;
 class UProjectileMovementComponent;
 struct FGameplayEventData;
 
@@ -45,6 +46,20 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Projectile", meta = (ExposeOnSpawn = "true"))
 	FGameplayEffectSpecHandle ProjectileDamageEffectSpecHandle;
 
+	// UWarriorProjectileSubsystem::SpawnProjectileFromClass simulates this class as a struct unless this is set. Set
+	// it when the projectile needs its own components or Blueprint logic beyond On Spawn Projectile Hit FX.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile")
+	bool bSpawnAsActor = false;
+
+	// Draws the projectile when it is simulated, see FWarriorProjectileParams::VisualSystem for what it reads.
+	// ProjectileNiagaraComponent's system expects to sit on the actor and cannot be reused for this.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (EditCondition = "!bSpawnAsActor"))
+	TObjectPtr<UNiagaraSystem> SimulatedVisualSystem;
+
+	// Spawned at the impact point in place of On Spawn Projectile Hit FX when the projectile is simulated
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Projectile", meta = (EditCondition = "!bSpawnAsActor"))
+	TObjectPtr<UNiagaraSystem> SimulatedHitFxSystem;
+
 	UFUNCTION()
 	virtual void OnProjectileHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
@@ -58,4 +73,13 @@ private:
 	void HandleApplyProjectileDamage(APawn* InHitPawn, const FGameplayEventData& InPayload);
 
 	TArray<AActor*> OverlappedActors;
+
+public:
+	FORCEINLINE UBoxComponent* GetProjectileCollisionBox() const { return ProjectileCollisionBox; }
+	FORCEINLINE UProjectileMovementComponent* GetProjectileMovementComp() const { return ProjectileMovementComp; }
+	FORCEINLINE EProjectileDamagePolicy GetProjectileDamagePolicy() const { return ProjectileDamagePolicy; }
+	FORCEINLINE UNiagaraSystem* GetSimulatedVisualSystem() const { return SimulatedVisualSystem; }
+	FORCEINLINE UNiagaraSystem* GetSimulatedHitFxSystem() const { return SimulatedHitFxSystem; }
+	FORCEINLINE bool ShouldSpawnAsActor() const { return bSpawnAsActor; }
+	FORCEINLINE void SetProjectileDamageEffectSpecHandle(const FGameplayEffectSpecHandle& InSpecHandle) { ProjectileDamageEffectSpecHandle = InSpecHandle; }
 };
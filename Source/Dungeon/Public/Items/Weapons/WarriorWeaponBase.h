@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WarriorTypes/WarriorStructTypes.h"
 #include "WarriorWeaponBase.generated.h"
 
 class UBoxComponent;
@@ -29,6 +30,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weapons")
 	UBoxComponent* WeaponCollisionBox;
 
+	// When enabled, the owning combat component sweeps this weapon instead of using WeaponCollisionBox overlaps
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapons|Trace")
+	FWarriorMeleeTraceSettings MeleeTraceSettings;
+
 	UFUNCTION()
 	virtual void OnCollisionBoxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
@@ -37,4 +42,8 @@ protected:
 
 public:
 	FORCEINLINE UBoxComponent* GetWeaponCollisionBox() const { return WeaponCollisionBox; }
+	FORCEINLINE const FWarriorMeleeTraceSettings& GetMeleeTraceSettings() const { return MeleeTraceSettings; }
+
+	// Returns the component the melee trace follows, with the damaging edge in that component's local space
+	UPrimitiveComponent* GetMeleeTraceSegment(FVector& OutLocalStart, FVector& OutLocalEnd) const;
 };
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "WarriorTypes/WarriorEnumTypes.h"
+#include "WarriorAISignificanceSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+USTRUCT(BlueprintType)
+struct FWarriorAISignificanceLevelSettings
+{
+	GENERATED_BODY()
+
+	// Enemies closer to the viewer than this fall into this level or a better one
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float MaxDistance = 0.f;
+
+	// Lower bound on the interval of significance aware behaviour tree services. Zero keeps the service's own interval.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float BTServiceInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float MovementTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float AnimTickInterval = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance")
+	EVisibilityBasedAnimTickOption VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance")
+	bool bTickHealthWidget = true;
+
+	// Upper bound on the crowd avoidance quality, the controller's own setting is kept when it is lower
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI Significance")
+	TEnumAsByte<ECrowdAvoidanceQuality::Type> MaxCrowdAvoidanceQuality = ECrowdAvoidanceQuality::High;
+};
+
+/**
+ * Buckets live enemies by distance to the viewer and whether they were rendered recently, and scales their update
+ * cost down with the bucket: behaviour tree service intervals, movement and animation tick rates, health widget
+ * ticking and crowd avoidance quality. Off screen enemies drop one bucket.
+ *
+ * Enemies register themselves on BeginPlay. A fixed number of them is re-evaluated per frame, and a bucket change
+ * needs the distance to pass the threshold by HysteresisDistance and the enemy to have spent MinSecondsInLevel
+ * in its current bucket, so enemies standing on a boundary do not flip every frame.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorAISignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorAISignificanceSubsystem();
+
+	static UWarriorAISignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterEnemy(AWarriorEnemyCharacter* InEnemy);
+	void UnregisterEnemy(AWarriorEnemyCharacter* InEnemy);
+
+	const FWarriorAISignificanceLevelSettings& GetLevelSettings(EWarriorAISignificance InLevel) const;
+
+	// Interval a behaviour tree service on InPawn should use at least. Zero for pawns that are not tracked.
+	static float GetBTServiceIntervalForPawn(const APawn* InPawn);
+
+private:
+	struct FTrackedEnemy
+	{
+		TWeakObjectPtr<AWarriorEnemyCharacter> Enemy;
+		double LastLevelChangeTime = 0.0;
+	};
+
+	// Returns false when there is no viewer, e.g. before the player pawn exists
+	bool GatherViewLocations();
+
+	EWarriorAISignificance ClassifyDistance(float InDistance) const;
+
+	EWarriorAISignificance EvaluateLevel(const AWarriorEnemyCharacter* InEnemy, EWarriorAISignificance InCurrentLevel) const;
+
+	void ApplyLevel(AWarriorEnemyCharacter* InEnemy, EWarriorAISignificance InLevel) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance")
+	FWarriorAISignificanceLevelSettings HighSignificance;
+
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance")
+	FWarriorAISignificanceLevelSettings MediumSignificance;
+
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance")
+	FWarriorAISignificanceLevelSettings LowSignificance;
+
+	// Used past LowSignificance.MaxDistance, so its own MaxDistance is ignored
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance")
+	FWarriorAISignificanceLevelSettings DormantSignificance;
+
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float HysteresisDistance = 250.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float MinSecondsInLevel = 0.5f;
+
+	// How long after its last render an enemy still counts as on screen
+	UPROPERTY(Config, EditAnywhere, Category = "AI Significance", meta = (ClampMin = "0.0"))
+	float OnScreenTolerance = 0.25f;
+
+	TArray<FTrackedEnemy> TrackedEnemies;
+
+	// Round robin cursor into TrackedEnemies
+	int32 NextEnemyIndex = 0;
+
+	// Local camera locations, or player pawn locations on a dedicated server
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	// False on a dedicated server, where nothing is rendered and every enemy counts as on screen
+	bool bHasLocalViewers = false;
+};
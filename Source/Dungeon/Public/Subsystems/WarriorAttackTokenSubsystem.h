@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WarriorAttackTokenSubsystem.generated.h"
+
+/**
+ * Limits how many enemies may attack the same target at once. An attack ability has to take one of the target's
+ * MaxTokensPerTarget tokens when it activates, and gives it back when it ends. The ability fails CanActivateAbility
+ * when no token can be had, so the behaviour tree falls back to strafing or waiting.
+ *
+ * When more enemies ask than there are free tokens, the free tokens go to the highest scores. Priority counts the
+ * most, closer enemies and enemies that have waited longer rank higher, and an enemy that just attacked sits out
+ * AttackerCooldown. MinGrantInterval spaces successive attacks on the same target so hits do not land in one frame.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorAttackTokenSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorAttackTokenSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	// Returns true if InAttacker holds, or was just given, one of InTarget's tokens
+	UFUNCTION(BlueprintCallable, Category = "Warrior|AttackToken")
+	bool TryAcquireToken(AActor* InAttacker, AActor* InTarget, int32 InPriority = 0);
+
+	// Whether TryAcquireToken would hand InAttacker a token right now. Changes nothing, so it is safe to call from
+	// CanActivateAbility.
+	bool CanAcquireToken(const AActor* InAttacker, const AActor* InTarget, int32 InPriority = 0) const;
+
+	// Gives back the token InAttacker holds, if any, and starts its cooldown
+	UFUNCTION(BlueprintCallable, Category = "Warrior|AttackToken")
+	void ReleaseToken(AActor* InAttacker);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|AttackToken")
+	bool HasToken(const AActor* InAttacker) const;
+
+	bool HasTokenOn(const AActor* InAttacker, const AActor* InTarget) const;
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|AttackToken")
+	int32 GetNumFreeTokens(const AActor* InTarget) const;
+
+	static bool IsEnabled();
+
+private:
+	struct FTokenHolder
+	{
+		TWeakObjectPtr<AActor> Attacker;
+
+		// TargetByHolder is keyed by this, so a destroyed attacker's entry is still found when its holder is pruned
+		TObjectKey<AActor> AttackerKey;
+
+		double GrantTime = 0.0;
+	};
+
+	struct FTokenRequest
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		float Score = 0.f;
+		double FirstRequestTime = 0.0;
+		double LastRequestTime = 0.0;
+	};
+
+	struct FTargetTokens
+	{
+		TArray<FTokenHolder, TInlineAllocator<4>> Holders;
+		TArray<FTokenRequest, TInlineAllocator<8>> Requests;
+		double LastGrantTime = -UE_BIG_NUMBER;
+	};
+
+	// Drops holders that are gone or held too long, and requests nobody repeated recently
+	void PruneTargetTokens(FTargetTokens& InOutTokens, double InNow);
+
+	bool IsHolderExpired(const FTokenHolder& InHolder, double InNow) const;
+	bool IsRequestExpired(const FTokenRequest& InRequest, double InNow) const;
+
+	float ScoreRequest(const AActor* InAttacker, const AActor* InTarget, int32 InPriority, double InWaitTime) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token", meta = (ClampMin = "1"))
+	int32 MaxTokensPerTarget = 2;
+
+	// Seconds an attacker has to wait after giving a token back
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token", meta = (ClampMin = "0.0"))
+	float AttackerCooldown = 1.5f;
+
+	// Minimum seconds between two tokens granted on the same target
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token", meta = (ClampMin = "0.0"))
+	float MinGrantInterval = 0.2f;
+
+	// A token still held after this many seconds is taken back, in case its ability never ended
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token", meta = (ClampMin = "0.0"))
+	float MaxHoldTime = 6.f;
+
+	// A request not repeated for this long no longer blocks lower scores
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token", meta = (ClampMin = "0.0"))
+	float RequestMemoryTime = 0.5f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token")
+	float PriorityScore = 1000.f;
+
+	// Score lost per centimetre between attacker and target
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token")
+	float DistanceScorePerUnit = 0.1f;
+
+	// Score gained per second spent waiting, so far or low priority enemies still get a turn
+	UPROPERTY(Config, EditAnywhere, Category = "Attack Token")
+	float WaitScorePerSecond = 50.f;
+
+	TMap<TObjectKey<AActor>, FTargetTokens> TokensByTarget;
+
+	TMap<TObjectKey<AActor>, TObjectKey<AActor>> TargetByHolder;
+
+	TMap<TObjectKey<AActor>, double> CooldownEndByAttacker;
+};
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorBTProfilerSubsystem.generated.h"
+
+class UBTNode;
+class UBehaviorTreeComponent;
+
+enum class EWarriorBTProfileEntryType : uint8
+{
+	// Time spent inside one of our native nodes, measured by FWarriorBTProfileScope
+	Node,
+
+	// Whole tree ticks attributed to the task that was active, measured by UWarriorBehaviorTreeComponent.
+	// Covers every node in the tree, Blueprint and engine nodes included, along with the services above that task.
+	Branch
+};
+
+enum class EWarriorBTProfileEvent : uint8
+{
+	Activation,
+	Tick,
+	Other
+};
+
+struct FWarriorBTProfileKey
+{
+	FName NodeName;
+	FName PawnClassName;
+	EWarriorBTProfileEntryType Type = EWarriorBTProfileEntryType::Node;
+
+	bool operator==(const FWarriorBTProfileKey& Other) const
+	{
+		return NodeName == Other.NodeName && PawnClassName == Other.PawnClassName && Type == Other.Type;
+	}
+
+	friend uint32 GetTypeHash(const FWarriorBTProfileKey& InKey)
+	{
+		return HashCombine(HashCombine(GetTypeHash(InKey.NodeName), GetTypeHash(InKey.PawnClassName)), static_cast<uint32>(InKey.Type));
+	}
+};
+
+struct FWarriorBTProfileFrameSummary
+{
+	int32 Activations = 0;
+	int32 Ticks = 0;
+	float NodeMs = 0.f;
+	float TreeTickMs = 0.f;
+};
+
+/**
+ * Collects activation counts, tick counts and inclusive time of behaviour tree nodes per enemy class while
+ * Warrior.BTProfiler.Enabled is set. Each frame the samples are folded into a frame summary and, during a CSV profiler
+ * capture, written to the WarriorBT CSV category. When a capture ends the totals for its duration are saved next to
+ * the CSV file as <capture>_BTProfile.csv.
+ *
+ * "Warrior.BTProfiler.Dump 20" prints the most expensive entries, "Warrior.BTProfiler.Reset" clears the totals.
+ */
+UCLASS()
+class DUNGEON_API UWarriorBTProfilerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsEnabled();
+
+	//~ Begin USubsystem Interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	static FWarriorBTProfileKey MakeKey(const UBehaviorTreeComponent& InOwnerComp, const FName& InNodeName, EWarriorBTProfileEntryType InType);
+
+	void Record(const FWarriorBTProfileKey& InKey, EWarriorBTProfileEvent InEvent, uint64 InCycles);
+
+	// Prints up to InMaxEntries entries, most inclusive time first
+	void DumpTopEntries(int32 InMaxEntries, FOutputDevice& Ar) const;
+
+	void ResetProfile();
+
+	const FWarriorBTProfileFrameSummary& GetLastFrameSummary() const { return LastFrameSummary; }
+
+private:
+	struct FProfileEntry
+	{
+		int32 Activations = 0;
+		int32 Ticks = 0;
+		uint64 Cycles = 0;
+
+		// Time recorded since the last frame summary
+		uint64 FrameCycles = 0;
+
+		// Built once so the per frame CSV write does not format strings
+		FName CsvStatName;
+	};
+
+	void GetSortedEntries(TArray<TPair<FWarriorBTProfileKey, const FProfileEntry*>>& OutEntries) const;
+
+	bool WriteProfileFile(const FString& InFilePath) const;
+
+	void HandleCsvProfileStart();
+	void HandleCsvProfileFinished(const FString& InCsvFilePath);
+
+	TMap<FWarriorBTProfileKey, FProfileEntry> Entries;
+
+	FWarriorBTProfileFrameSummary FrameSummary;
+	FWarriorBTProfileFrameSummary LastFrameSummary;
+
+	// Frames summarised since the last reset, used for the per frame averages of the dump
+	int32 ProfiledFrames = 0;
+
+	bool bHasFrameSamples = false;
+
+	FDelegateHandle CsvProfileStartHandle;
+	FDelegateHandle CsvProfileFinishedHandle;
+};
+
+/**
+ * Times the enclosing block of a behaviour tree node and records it with the world's UWarriorBTProfilerSubsystem.
+ * Costs one console variable read when the profiler is disabled.
+ */
+class DUNGEON_API FWarriorBTProfileScope
+{
+public:
+	FWarriorBTProfileScope(const UBTNode* InNode, const UBehaviorTreeComponent& InOwnerComp, EWarriorBTProfileEvent InEvent);
+	~FWarriorBTProfileScope();
+
+private:
+	UWarriorBTProfilerSubsystem* Profiler = nullptr;
+	FWarriorBTProfileKey Key;
+	EWarriorBTProfileEvent Event;
+	uint64 StartCycles = 0;
+};
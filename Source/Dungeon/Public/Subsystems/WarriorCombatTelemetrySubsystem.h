@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorCombatTelemetrySubsystem.generated.h"
+
+class FRunnableThread;
+class IConsoleVariable;
+class FWarriorCombatTelemetryWriter;
+
+enum class EWarriorTelemetryBlockResult : uint8
+{
+	// The victim was not blocking
+	None,
+	// The hit was blocked and dealt no damage
+	Blocked,
+	// The victim was blocking but the hit landed anyway (bad angle or unblockable attack)
+	BlockBroken
+};
+
+enum class EWarriorTelemetryHitReactDirection : uint8
+{
+	Front,
+	Left,
+	Right,
+	Back
+};
+
+// One combat hit. Plain data only, so recording it never allocates.
+struct FWarriorCombatHitRecord
+{
+	uint64 FrameNumber = 0;
+	double WorldTimeSeconds = 0.0;
+	float FrameTimeMs = 0.f;
+
+	FName Attacker;
+	FName Victim;
+
+	float Damage = 0.f;
+	int32 LightComboCount = 0;
+	int32 HeavyComboCount = 0;
+
+	EWarriorTelemetryBlockResult BlockResult = EWarriorTelemetryBlockResult::None;
+	EWarriorTelemetryHitReactDirection HitReactDirection = EWarriorTelemetryHitReactDirection::Front;
+	float HitReactAngle = 0.f;
+};
+
+/**
+ * Records every combat hit into a fixed size ring buffer that a background thread drains to
+ * Saved/Profiling/CombatTelemetry as CSV or binary. Toggled with Warrior.Telemetry.Enabled; while it is off
+ * call sites only test IsEnabled() and build nothing.
+ *
+ * The buffer is single producer, single consumer: hits are recorded on the game thread and only the writer
+ * thread reads them. When the writer falls behind, new hits are dropped and counted rather than blocking.
+ */
+UCLASS()
+class DUNGEON_API UWarriorCombatTelemetrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorCombatTelemetrySubsystem* Get(const UObject* WorldContextObject);
+
+	// Cached from Warrior.Telemetry.Enabled. Test this before gathering anything for a record.
+	static FORCEINLINE bool IsEnabled() { return bTelemetryEnabled; }
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	// Records a hit that went through the damage calculation. Block result and hit react direction are derived here.
+	static void RecordDamageHit(AActor* InAttacker, AActor* InVictim, float InDamage, int32 InLightComboCount, int32 InHeavyComboCount);
+
+	// Records a hit that a successful block stopped before any damage was applied
+	static void RecordBlockedHit(AActor* InAttacker, AActor* InVictim);
+
+	void RecordHit(FWarriorCombatHitRecord& InOutRecord);
+
+	// Stops the writer thread after it has written everything recorded so far
+	void EndSession();
+
+	bool IsSessionActive() const { return WriterThread != nullptr; }
+
+	// Sink for Warrior.Telemetry.Enabled. Turning telemetry off ends the session of every world.
+	static void OnEnabledChanged(IConsoleVariable* InVariable);
+
+private:
+	bool BeginSession();
+
+	static bool bTelemetryEnabled;
+
+	// Owned here, created by BeginSession and deleted by EndSession once its thread has finished
+	FWarriorCombatTelemetryWriter* Writer = nullptr;
+	FRunnableThread* WriterThread = nullptr;
+
+	// Set after a session failed to start so a missing directory does not retry on every hit
+	bool bSessionFailed = false;
+};
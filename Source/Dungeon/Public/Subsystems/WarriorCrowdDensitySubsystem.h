@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Navigation/CrowdFollowingComponent.h"
+#include "WarriorCrowdDensitySubsystem.generated.h"
+
+class AWarriorAIController;
+
+USTRUCT(BlueprintType)
+struct FWarriorCrowdDensityTier
+{
+	GENERATED_BODY()
+
+	// Agents with at least this many neighbours inside NeighbourRadius use this tier
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crowd", meta = (ClampMin = "0"))
+	int32 MinNeighbours = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crowd")
+	TEnumAsByte<ECrowdAvoidanceQuality::Type> MaxAvoidanceQuality = ECrowdAvoidanceQuality::High;
+
+	// Upper bound on the crowd collision query range, the controller's own CollisionQueryRange is kept when lower
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crowd", meta = (ClampMin = "0.0"))
+	float MaxQueryRange = 600.f;
+};
+
+/**
+ * Measures each crowd agent's neighbour count once per DensityUpdateInterval and moves it between density tiers.
+ * Dense agents get cheaper avoidance and a shorter query range; sparse ones keep full quality. While the
+ * simulation time reported by UWarriorCrowdManager is over Warrior.Crowd.BudgetMs, every agent is pushed one
+ * tier denser.
+ *
+ * Dense agents close to their target form a melee ring. Ring members only avoid each other and are handed
+ * evenly spaced surround slots around the target, written to the SurroundSlotLocation blackboard key.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorCrowdDensitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UWarriorCrowdDensitySubsystem();
+
+	static UWarriorCrowdDensitySubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterAgent(AWarriorAIController* InController);
+	void UnregisterAgent(AWarriorAIController* InController);
+
+	// Crowd simulation time averaged by UWarriorCrowdManager, zero if the world uses the stock crowd manager
+	UFUNCTION(BlueprintPure, Category = "Warrior|Crowd")
+	float GetCrowdSimulationMs() const;
+
+private:
+	struct FAgentSample
+	{
+		AWarriorAIController* Controller = nullptr;
+		FVector Location = FVector::ZeroVector;
+		AActor* Target = nullptr;
+		int32 NumNeighbours = 0;
+	};
+
+	void UpdateDensity();
+
+	void GatherAgentSamples();
+
+	void CountNeighbours();
+
+	int32 GetTierIndex(int32 InNumNeighbours, bool bInOverBudget) const;
+
+	void AssignSurroundSlots(AActor* InTarget, TArray<int32>& InOutRingAgents);
+
+	// Sorted from sparse to dense
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+	TArray<FWarriorCrowdDensityTier> DensityTiers;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "1.0"))
+	float NeighbourRadius = 300.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0.0"))
+	float DensityUpdateInterval = 1.f;
+
+	// Dense agents within this distance of their target join the target's melee ring
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0.0"))
+	float MeleeRingRadius = 450.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0.0"))
+	float SurroundSlotRadius = 220.f;
+
+	TSet<TWeakObjectPtr<AWarriorAIController>> RegisteredAgents;
+
+	float TimeUntilNextUpdate = 0.f;
+
+	// Scratch containers reused between updates
+	TArray<FAgentSample> AgentSamples;
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> AgentsByCell;
+	TMap<AActor*, TArray<int32>> RingAgentsByTarget;
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorDeferredActionSubsystem.generated.h"
+
+UENUM()
+enum class EWarriorDeferredActionPhase : uint8
+{
+	// Runs once the next frame has finished its tick groups
+	NextFrame,
+	// Runs at the end of the current frame, after physics has been simulated
+	AfterPhysics
+};
+
+/**
+ * World-level queue for one-shot work that has to wait a frame (or for physics) before it can run.
+ * Actors enqueue here instead of keeping an actor tick alive just to consume a flag, and the whole
+ * queue is drained in one batched pass. The subsystem only ticks while something is queued.
+ */
+UCLASS()
+class DUNGEON_API UWarriorDeferredActionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorDeferredActionSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Queues an action. It is dropped silently if InOwner is destroyed before the action runs.
+	void EnqueueAction(const UObject* InOwner, EWarriorDeferredActionPhase InPhase, TFunction<void()>&& InAction);
+
+	int32 GetNumPendingActions() const { return NextFrameActions.Num() + AfterPhysicsActions.Num(); }
+
+private:
+	struct FWarriorDeferredAction
+	{
+		TWeakObjectPtr<const UObject> Owner;
+		TFunction<void()> Action;
+		uint64 EnqueuedFrame = 0;
+	};
+
+	void ProcessActions(TArray<FWarriorDeferredAction>& InOutQueue, bool bOnlyPreviousFrames);
+
+	TArray<FWarriorDeferredAction> NextFrameActions;
+	TArray<FWarriorDeferredAction> AfterPhysicsActions;
+
+	// Scratch array reused between passes so draining the queue does not allocate
+	TArray<FWarriorDeferredAction> ActionsToRun;
+};
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorEnemyPoolSubsystem.generated.h"
+
+class AWarriorEnemyCharacter;
+
+USTRUCT(BlueprintType)
+struct FWarriorEnemyPoolPrewarmEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Pool")
+	TSoftClassPtr<AWarriorEnemyCharacter> EnemyClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Enemy Pool", meta = (ClampMin = "0"))
+	int32 Count = 0;
+};
+
+USTRUCT()
+struct FWarriorEnemyPoolBucket
+{
+	GENERATED_BODY()
+
+	// Enemies ready to be handed out, hidden with collision, movement and AI logic off
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AWarriorEnemyCharacter>> FreeEnemies;
+
+	// Every enemy owned by this bucket, handed out or not
+	int32 NumOwned = 0;
+};
+
+/**
+ * Keeps pre-spawned AWarriorEnemyCharacter instances per class so summons do not pay for SpawnActor, controller
+ * possession and the start up data load at the moment they are needed. Pooled enemies keep their AI controller
+ * and granted abilities between uses. They go back to the pool on death instead of being destroyed.
+ *
+ * Only classes with bUseEnemyPool set are taken from the pool by spawn tasks or prewarmed.
+ *
+ * Classes listed in PrewarmEntries ([/Script/Dungeon.WarriorEnemyPoolSubsystem] in DefaultGame.ini) are prewarmed
+ * when a game world begins play. Levels can prewarm more through PrewarmEnemies.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorEnemyPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorEnemyPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	//~ End UWorldSubsystem Interface
+
+	// Loads InEnemyClass and adds enemies to its pool until it owns at least InCount of them
+	UFUNCTION(BlueprintCallable, Category = "Warrior|EnemyPool")
+	void PrewarmEnemies(TSoftClassPtr<AWarriorEnemyCharacter> InEnemyClass, int32 InCount);
+
+	// Hands out a pooled enemy of InEnemyClass placed at InTransform. Spawns a new pooled enemy when the pool is empty.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|EnemyPool")
+	AWarriorEnemyCharacter* AcquireEnemy(TSubclassOf<AWarriorEnemyCharacter> InEnemyClass, const FTransform& InTransform);
+
+	// Puts a pooled enemy back. Enemies that did not come from the pool are destroyed.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|EnemyPool")
+	void ReleaseEnemy(AWarriorEnemyCharacter* InEnemy);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|EnemyPool")
+	int32 GetNumFreeEnemies(TSubclassOf<AWarriorEnemyCharacter> InEnemyClass) const;
+
+	/**
+	 * Picks InCount random points within InRadius of InOrigin and projects all of them onto the navmesh in a single
+	 * batched query, then keeps them reachable from InOrigin with one batched navmesh raycast. Points that are not
+	 * reachable are pulled back along the ray. Without a navmesh the random points are returned as they are.
+	 * Returns the number of points that were reachable without being pulled back.
+	 */
+	static int32 QueryNavigableSpawnLocations(const UObject* WorldContextObject, const FVector& InOrigin, float InRadius, int32 InCount, TArray<FVector>& OutLocations);
+
+private:
+	// Parked enemies are spawned hidden and without collision, ready to be deactivated
+	AWarriorEnemyCharacter* SpawnPooledEnemy(UClass* InEnemyClass, const FTransform& InTransform, bool bInParked = false);
+
+	void OnPrewarmClassLoaded(TSoftClassPtr<AWarriorEnemyCharacter> InEnemyClass, int32 InCount);
+
+	UFUNCTION()
+	void OnPooledEnemyDestroyed(AActor* DestroyedActor);
+
+	UPROPERTY(Config)
+	TArray<FWarriorEnemyPoolPrewarmEntry> PrewarmEntries;
+
+	// Where prewarmed enemies are spawned and wait until they are first acquired, raised above the level's KillZ
+	UPROPERTY(Config)
+	FVector PrewarmParkingLocation = FVector(0.f, 0.f, -50000.f);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FWarriorEnemyPoolBucket> Buckets;
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Subsystems/WarriorPawnSlotArray.h"
+#include "WarriorFacingSubsystem.generated.h"
+
+/**
+ * Turns pawns toward their facing targets in one pass per frame. Behaviour tree nodes write a facing intent into
+ * the pawn's slot instead of calling SetActorRotation themselves; after every tick group has run, this subsystem
+ * interpolates all yaws in a tight loop and applies them through the movement component without sweeping.
+ * A yaw-only turn of a capsule leaves its overlaps unchanged, so none are gathered.
+ *
+ * The same pass records whether each pawn is within its angle precision, which UBTTask_RotateToFaceTarget reads
+ * instead of recomputing it.
+ */
+UCLASS()
+class DUNGEON_API UWarriorFacingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorFacingSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Writes InPawn's facing slot, unless another requester holds it with a higher InPriority. InAnglePrecision is in degrees.
+	void SetFacingTarget(APawn* InPawn, AActor* InTarget, float InInterpSpeed, float InAnglePrecision, const UObject* InRequester, int32 InPriority = 0);
+
+	// Empties InPawn's slot, but only if InRequester is the one that last wrote it
+	void ClearFacingTarget(APawn* InPawn, const UObject* InRequester);
+
+	// Returns false unless InRequester owns InPawn's facing intent. Otherwise OutHasReached holds the result of the last pass.
+	bool GetHasReachedAnglePrecision(const APawn* InPawn, const UObject* InRequester, bool& OutHasReached) const;
+
+	// Yaw-only angle in degrees between InPawn's facing and the direction to InTarget
+	static float GetYawDeltaToTarget(const APawn* InPawn, const AActor* InTarget);
+
+private:
+	struct FWarriorFacingIntent
+	{
+		TWeakObjectPtr<AActor> Target;
+		TWeakObjectPtr<const UObject> Requester;
+		float InterpSpeed = 0.f;
+		float AnglePrecision = 0.f;
+		int32 Priority = 0;
+		bool bHasReachedAnglePrecision = false;
+	};
+
+	TWarriorPawnSlotArray<FWarriorFacingIntent> Intents;
+};
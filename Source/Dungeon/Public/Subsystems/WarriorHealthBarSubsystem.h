@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Subsystems/WarriorPawnSlotArray.h"
+#include "WarriorHealthBarSubsystem.generated.h"
+
+class UWarriorHealthBarLayerWidget;
+
+struct FWarriorHealthBarDrawData
+{
+	// Bar centre in viewport widget units
+	FVector2D Position = FVector2D::ZeroVector;
+
+	float HealthFraction = 1.f;
+};
+
+/**
+ * Draws every enemy health bar through one HUD layer widget instead of a widget component per enemy. Enemies
+ * register with their current health fraction and push updates from UPawnUIComponent::OnCurrentHealthChanged.
+ * Once per frame the bars are culled by distance and by whether the renderer drew the enemy recently, which covers
+ * occlusion without a trace, then projected with the view UWarriorWorldMarkerSubsystem caches for the frame. The
+ * result is a compact array the layer paints from.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorHealthBarSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorHealthBarSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterHealthBar(APawn* InPawn, float InHealthFraction = 1.f);
+	void UnregisterHealthBar(APawn* InPawn);
+
+	void SetHealthFraction(APawn* InPawn, float InHealthFraction);
+
+	// Bars that passed culling this frame
+	const TArray<FWarriorHealthBarDrawData>& GetVisibleBars() const { return VisibleBars; }
+
+private:
+	struct FTrackedHealthBar
+	{
+		// Height of the bar above the pawn's origin
+		float HeightOffset = 0.f;
+
+		float HealthFraction = 1.f;
+	};
+
+	void EnsureLayerWidget();
+
+	// Leave unset to use UWarriorHealthBarLayerWidget with its default look
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar")
+	TSoftClassPtr<UWarriorHealthBarLayerWidget> LayerWidgetClass;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar", meta = (ClampMin = "0.0"))
+	float MaxDrawDistance = 3000.f;
+
+	// Added on top of the pawn's collision half height
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar")
+	float HeightAboveCollision = 30.f;
+
+	// An enemy the renderer has not drawn for this many seconds is treated as occluded
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar", meta = (ClampMin = "0.0"))
+	float RecentlyRenderedTolerance = 0.2f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar")
+	bool bHideAtFullHealth = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Health Bar")
+	int32 LayerZOrder = -10;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UWarriorHealthBarLayerWidget> LayerWidget;
+
+	TWarriorPawnSlotArray<FTrackedHealthBar> TrackedBars;
+
+	TArray<FWarriorHealthBarDrawData> VisibleBars;
+};
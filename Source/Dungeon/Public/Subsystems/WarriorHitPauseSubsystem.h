@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorHitPauseSubsystem.generated.h"
+
+/**
+ * Owns hit-stop for the world. Combat code requests pauses here instead of sending Player.Event.HitPause per hit.
+ * Requests made during a frame are merged: the strongest intensity wins and every involved actor is collected.
+ * One CustomTimeDilation is then applied to those actors only, so the rest of the world keeps running.
+ * A rolling budget caps how much pause time a chain of hits can add, so multi-hit swings cannot stall gameplay.
+ */
+UCLASS()
+class DUNGEON_API UWarriorHitPauseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorHitPauseSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Queues a pause for InInstigator and InTarget. InIntensity is 0..1 and scales both the slowdown and the duration.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|HitPause")
+	void RequestHitPause(AActor* InInstigator, AActor* InTarget, float InIntensity = 1.f);
+
+	// Ends any active pause and restores every affected actor
+	UFUNCTION(BlueprintCallable, Category = "Warrior|HitPause")
+	void CancelHitPause();
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|HitPause")
+	bool IsHitPauseActive() const { return !PausedActors.IsEmpty(); }
+
+	// Real seconds of hit pause applied over the last minute
+	UFUNCTION(BlueprintPure, Category = "Warrior|HitPause")
+	float GetPauseSecondsLastMinute() const;
+
+private:
+	struct FGrantedPause
+	{
+		double StartRealTime = 0.0;
+		float Duration = 0.f;
+	};
+
+	// Merges the requests made this frame into the active pause
+	void FlushPendingRequests(double InRealTime);
+
+	// Restores CustomTimeDilation on every paused actor
+	void RestorePausedActors();
+
+	// Real seconds of pause granted since InWindowStart, clipped to the window
+	float GetGrantedPauseSince(double InWindowStart) const;
+
+	void TrimPauseHistory(double InRealTime);
+
+	double GetRealTime() const;
+
+	// Strongest intensity requested this frame, or a negative value when nothing is pending
+	float PendingIntensity = -1.f;
+
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> PendingActors;
+
+	// Actors slowed by the active pause, with the CustomTimeDilation they had before it started
+	TMap<TWeakObjectPtr<AActor>, float> PausedActors;
+
+	float ActiveTimeDilation = 1.f;
+	double ActivePauseEndRealTime = 0.0;
+
+	// Pauses granted in the last minute, oldest first. Feeds both the budget and the per-minute stat.
+	TArray<FGrantedPause> PauseHistory;
+};
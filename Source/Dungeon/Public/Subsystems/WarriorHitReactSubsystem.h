@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "WarriorHitReactSubsystem.generated.h"
+
+/**
+ * Collects hit react events raised during a frame and sends at most one Shared.Event.HitReact per victim
+ * once the frame's tick groups have run. A cleave or a projectile volley that lands on the same pawn several
+ * times then triggers its hit react ability once instead of once per damage application.
+ */
+UCLASS()
+class DUNGEON_API UWarriorHitReactSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorHitReactSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Queues a hit react for InVictim. A later call for the same victim in the same frame replaces the payload.
+	void QueueHitReact(AActor* InVictim, const FGameplayEventData& InPayload);
+
+	// Queues a hit react, or sends it straight away when there is no world to queue it on
+	static void QueueOrSendHitReact(AActor* InVictim, const FGameplayEventData& InPayload);
+
+	int32 GetNumPendingHitReacts() const { return PendingHitReacts.Num(); }
+
+private:
+	TMap<TWeakObjectPtr<AActor>, FGameplayEventData> PendingHitReacts;
+
+	// Scratch map swapped with PendingHitReacts while flushing, so reacts queued by the events themselves wait a frame
+	TMap<TWeakObjectPtr<AActor>, FGameplayEventData> HitReactsToSend;
+};
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WarriorKitchenStressTestSubsystem.generated.h"
+
+class AInteractablePot;
+class AInventoryItemActor;
+
+struct FWarriorKitchenStressTestSettings
+{
+	int32 NumPots = 16;
+	int32 NumMinigames = 8;
+	int32 NumItems = 32;
+	int32 WarmupFrames = 60;
+	int32 NumFrames = 600;
+	int32 Seed = 1337;
+
+	// Optional Blueprint classes. The native classes are used when these are null.
+	TSubclassOf<AInteractablePot> PotClass;
+	TSubclassOf<AInventoryItemActor> ItemClass;
+};
+
+/**
+ * Repeatable load scenario for the cooking loop. Spawns pots filled with the ingredients of random recipes and starts cooking on all of them
+ * (NumMinigames of them through the minigame system), spawns item actors and slices one per frame, and forces an
+ * inventory UI refresh every frame. Frame, game thread, slice and inventory UI times are compared against budgets and
+ * written as a JSON report next to a CSV profiler capture.
+ *
+ * Run with "Warrior.KitchenStressTest Pots=16 Minigames=8 Items=32 Frames=600". Launch with -KitchenStressTestExit
+ * to quit with a non-zero exit code when a budget is exceeded, e.g. in a headless -nullrhi run.
+ */
+UCLASS()
+class DUNGEON_API UWarriorKitchenStressTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override { return bIsRunning; }
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	bool StartStressTest(const FWarriorKitchenStressTestSettings& InSettings);
+
+	bool IsRunning() const { return bIsRunning; }
+
+private:
+	struct FMetricSummary
+	{
+		float Average = 0.f;
+		float P95 = 0.f;
+		float Max = 0.f;
+	};
+
+	void SpawnScenario();
+	void SliceNextItem();
+	void MeasureInventoryUI();
+	void FinishStressTest();
+	void CleanupScenario();
+	bool WriteReport(const FString& ReportPath, bool& bOutPassed) const;
+
+	static FMetricSummary Summarize(TArray<float> Samples);
+
+	FWarriorKitchenStressTestSettings Settings;
+	FRandomStream RandomStream;
+
+	bool bIsRunning = false;
+	int32 FrameIndex = 0;
+	int32 NextItemToSlice = 0;
+	int32 NumMinigamesStarted = 0;
+
+	// Pots that entered the cooking state, lower than NumPots when StartCooking found no recipe or the player lacks it
+	int32 NumPotsCooking = 0;
+
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+	TArray<TWeakObjectPtr<AInventoryItemActor>> ItemsToSlice;
+
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+	TArray<float> SliceTimesMs;
+	TArray<float> InventoryUITimesMs;
+};
@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "UObject/ObjectKey.h"
+#include "WarriorPathSharingSubsystem.generated.h"
+
+struct FNavMeshPath;
+
+/**
+ * Lets agents chasing the same goal share navmesh corridors instead of each running a full path search.
+ *
+ * Goals are bucketed into cells of GoalCellSize. Once MinAgentsToShare different agents have asked for the same cell
+ * within RequestWindow, every path found toward it is kept as a corridor for CorridorLifetime. A later request that
+ * starts within JoinRadius of a kept corridor point, with a clear navmesh raycast to it, gets the raycast plus the
+ * rest of that corridor. A second raycast carries the path from the corridor's end to the request's own goal, so a
+ * join costs two raycasts instead of an A* search. Joined paths are kept as corridors as well, so the set grows into
+ * a tree of corridors converging on the goal. Agents still follow their path through the crowd manager, so local
+ * avoidance is unchanged.
+ *
+ * Requests are not batched: the first MinAgentsToShare agents of a window, and every agent that starts farther than
+ * JoinRadius from all kept corridors, still run a full search. The saving is for agents that start near each other
+ * or near an earlier agent's path, such as a pack chasing the player, not for agents spread across the level.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorPathSharingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorPathSharingSubsystem* Get(const UObject* WorldContextObject);
+
+	static bool IsEnabled();
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Fills OutPath from a kept corridor toward the query's goal cell, returns false when the caller has to search
+	bool FindSharedPath(const FPathFindingQuery& InQuery, FNavPathSharedPtr& OutPath);
+
+	// Offers a path found by a full search, it is kept when enough agents are heading for its goal cell
+	void AddSearchedPath(const FPathFindingQuery& InQuery, const FNavPathSharedPtr& InPath);
+
+	// How far the goal actor may move before InPath is recalculated. Grows with path length, so distant
+	// agents in a swarm repath less often than the ones about to reach the goal.
+	float GetGoalRepathTolerance(const FNavigationPath& InPath) const;
+
+private:
+	struct FGoalCellKey
+	{
+		FIntVector Cell = FIntVector::ZeroValue;
+		FObjectKey NavData;
+		const FNavigationQueryFilter* QueryFilter = nullptr;
+
+		bool operator==(const FGoalCellKey& Other) const
+		{
+			return Cell == Other.Cell && NavData == Other.NavData && QueryFilter == Other.QueryFilter;
+		}
+
+		friend uint32 GetTypeHash(const FGoalCellKey& InKey)
+		{
+			return HashCombine(HashCombine(GetTypeHash(InKey.Cell), GetTypeHash(InKey.NavData)), GetTypeHash(InKey.QueryFilter));
+		}
+	};
+
+	struct FSharedCorridor
+	{
+		TArray<FNavPathPoint> PathPoints;
+
+		// Path length left from each path point to the goal
+		TArray<float> DistanceToGoal;
+
+		TArray<NavNodeRef> PathCorridor;
+		TArray<FVector::FReal> PathCorridorCost;
+
+		float CreationTime = 0.f;
+	};
+
+	struct FGoalCell
+	{
+		TArray<FSharedCorridor> Corridors;
+
+		// Agents that asked for this cell since WindowStartTime
+		TArray<FObjectKey, TInlineAllocator<8>> RecentQueriers;
+
+		int32 PreviousWindowQueriers = 0;
+
+		float WindowStartTime = 0.f;
+	};
+
+	FGoalCellKey MakeGoalCellKey(const FPathFindingQuery& InQuery) const;
+
+	// Counts the querier toward the cell's request window, returns whether the cell has enough agents to share
+	bool NoteRequest(FGoalCell& InOutGoalCell, const FPathFindingQuery& InQuery, float InTime) const;
+
+	void AddCorridor(FGoalCell& InOutGoalCell, const FNavMeshPath& InPath, float InTime);
+
+	bool TryJoinCorridor(const FPathFindingQuery& InQuery, const FSharedCorridor& InCorridor, int32 InJoinIndex, FNavPathSharedPtr& OutPath) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "1.0"))
+	float GoalCellSize = 200.f;
+
+	// Number of different agents that must head for the same goal cell before their paths are shared
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "1"))
+	int32 MinAgentsToShare = 3;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "0.0"))
+	float RequestWindow = 1.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "0.0"))
+	float CorridorLifetime = 1.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "1"))
+	int32 MaxCorridorsPerGoal = 8;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "0.0"))
+	float JoinRadius = 300.f;
+
+	// Raycasts tried per request, cheapest join first
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "1"))
+	int32 MaxJoinRaycasts = 2;
+
+	// Requests closer to their goal than this always search, short searches are cheap and need to be exact
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing", meta = (ClampMin = "0.0"))
+	float MinShareDistance = 500.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing|Repath", meta = (ClampMin = "0.0"))
+	float GoalRepathToleranceFraction = 0.1f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing|Repath", meta = (ClampMin = "0.0"))
+	float MinGoalRepathTolerance = 100.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Path Sharing|Repath", meta = (ClampMin = "0.0"))
+	float MaxGoalRepathTolerance = 300.f;
+
+	TMap<FGoalCellKey, FGoalCell> GoalCells;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class APawn;
+
+/**
+ * One EntryType per pawn, stored densely for per frame passes over every pawn and indexed by pawn for lookups.
+ * Removing swaps the last slot into the hole, so passes that remove entries walk the array backwards.
+ *
+ * The index map is keyed by TObjectKey rather than the weak pointer, so the slot of a pawn that has been destroyed
+ * can still be found and removed.
+ */
+template<typename EntryType>
+class TWarriorPawnSlotArray
+{
+public:
+	int32 Num() const { return Slots.Num(); }
+	bool IsEmpty() const { return Slots.IsEmpty(); }
+
+	// Null once the pawn in the slot has been destroyed
+	APawn* GetPawn(int32 InIndex) const { return Slots[InIndex].Pawn.Get(); }
+
+	EntryType& operator[](int32 InIndex) { return Slots[InIndex].Entry; }
+	const EntryType& operator[](int32 InIndex) const { return Slots[InIndex].Entry; }
+
+	EntryType* Find(const APawn* InPawn)
+	{
+		const int32* ExistingIndex = IndexByPawn.Find(InPawn);
+		return ExistingIndex ? &Slots[*ExistingIndex].Entry : nullptr;
+	}
+
+	const EntryType* Find(const APawn* InPawn) const
+	{
+		const int32* ExistingIndex = IndexByPawn.Find(InPawn);
+		return ExistingIndex ? &Slots[*ExistingIndex].Entry : nullptr;
+	}
+
+	// Adds a default constructed entry for InPawn, which must not have one yet
+	EntryType& Add(APawn* InPawn)
+	{
+		check(InPawn && !IndexByPawn.Contains(InPawn));
+
+		IndexByPawn.Add(InPawn, Slots.Num());
+
+		FSlot& Slot = Slots.AddDefaulted_GetRef();
+		Slot.Pawn = InPawn;
+		Slot.PawnKey = InPawn;
+
+		return Slot.Entry;
+	}
+
+	void Remove(const APawn* InPawn)
+	{
+		if (const int32* ExistingIndex = IndexByPawn.Find(InPawn))
+		{
+			RemoveAt(*ExistingIndex);
+		}
+	}
+
+	void RemoveAt(int32 InIndex)
+	{
+		IndexByPawn.Remove(Slots[InIndex].PawnKey);
+
+		Slots.RemoveAtSwap(InIndex, 1, EAllowShrinking::No);
+
+		if (Slots.IsValidIndex(InIndex))
+		{
+			IndexByPawn.Add(Slots[InIndex].PawnKey, InIndex);
+		}
+	}
+
+	void Empty()
+	{
+		Slots.Empty();
+		IndexByPawn.Empty();
+	}
+
+private:
+	struct FSlot
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		TObjectKey<APawn> PawnKey;
+		EntryType Entry;
+	};
+
+	TArray<FSlot> Slots;
+
+	TMap<TObjectKey<APawn>, int32> IndexByPawn;
+};
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WarriorPerceptionSubsystem.generated.h"
+
+class AWarriorAIController;
+
+/**
+ * Team level replacement for the per controller sight sense. Every UpdateInterval it runs one pawn overlap per
+ * player, groups the hostile enemies it finds into grid clusters, and queues one async line trace per
+ * (player, cluster) against static geometry. When a trace comes back clear, every enemy in that cluster is told
+ * it sees the player, the same way a successful sight stimulus would. Cost follows players x clusters instead of
+ * enemies x stimuli.
+ *
+ * Controllers opt in with bUseSharedPerception, which also turns their own sight sense off.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorPerceptionSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	void RegisterController(AWarriorAIController* InController);
+	void UnregisterController(AWarriorAIController* InController);
+
+	int32 GetNumRegisteredControllers() const { return RegisteredControllers.Num(); }
+
+private:
+	struct FPendingClusterTrace
+	{
+		FTraceHandle TraceHandle;
+		TWeakObjectPtr<APawn> Player;
+		TArray<TWeakObjectPtr<AWarriorAIController>, TInlineAllocator<8>> Controllers;
+	};
+
+	// Hands the results of last frame's traces to the controllers of each clear cluster
+	void ResolvePendingTraces();
+
+	void QueueClusterTraces(APawn* InPlayer);
+
+	// Same range as the old sight config, SightRadius 5000 with 360 degree peripheral vision
+	UPROPERTY(Config, EditAnywhere, Category = "Perception", meta = (ClampMin = "0.0"))
+	float SightRadius = 5000.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Perception", meta = (ClampMin = "0.0"))
+	float UpdateInterval = 0.25f;
+
+	// Enemies in the same cell of this size share one visibility trace per player
+	UPROPERTY(Config, EditAnywhere, Category = "Perception", meta = (ClampMin = "1.0"))
+	float ClusterCellSize = 600.f;
+
+	TSet<TWeakObjectPtr<AWarriorAIController>> RegisteredControllers;
+
+	TArray<FPendingClusterTrace> PendingTraces;
+
+	float TimeUntilNextUpdate = 0.f;
+
+	// Scratch containers reused between updates
+	TArray<FOverlapResult> OverlapScratch;
+	TMap<FIntVector, int32> ClusterIndexScratch;
+};
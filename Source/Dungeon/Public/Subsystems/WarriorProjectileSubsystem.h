@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectTypes.h"
+#include "WorldCollision.h"
+#include "Items/WarriorProjectileBase.h"
+#include "WarriorProjectileSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+
+USTRUCT(BlueprintType)
+struct FWarriorProjectileParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float Speed = 700.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float GravityScale = 0.f;
+
+	// Radius of the sphere swept along the projectile path every tick
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1.0"))
+	float CollisionRadius = 16.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.0"))
+	float LifeSpan = 4.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EProjectileDamagePolicy DamagePolicy = EProjectileDamagePolicy::OnHit;
+
+	// Shared system that draws every live projectile using it. Reads User.ProjectilePositions and
+	// User.ProjectileVelocities (Vector arrays) and should keep one particle per array element.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<UNiagaraSystem> VisualSystem;
+
+	// Spawned from the Niagara component pool at the impact point, replacing BP_OnSpawnProjectileHitFx
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TObjectPtr<UNiagaraSystem> HitFxSystem;
+};
+
+USTRUCT()
+struct FWarriorProjectileVisualGroup
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UNiagaraSystem> System;
+
+	UPROPERTY()
+	TObjectPtr<UNiagaraComponent> Component;
+
+	// Rebuilt every tick and pushed to the component in one call per array
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+};
+
+/**
+ * Simulates projectiles as plain structs instead of actors. Each tick every live projectile is moved and its
+ * sphere sweep is queued on the async trace buffer; the results are read back the next tick, so the whole
+ * volley is traced in one batch instead of one movement component sweep per actor. Visuals go through one
+ * persistent Niagara component per visual system, fed with per-particle arrays.
+ *
+ * Hits follow AWarriorProjectileBase: OnHit stops on the first thing it touches and resolves block, damage and
+ * hit react against hostile pawns, OnBeginOverlap damages each hostile pawn once and only stops on world
+ * geometry. SpawnProjectileFromClass takes the existing AWarriorProjectileBase classes and simulates them here,
+ * unless the class sets bSpawnAsActor.
+ */
+UCLASS()
+class DUNGEON_API UWarriorProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorProjectileSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	// Fires a projectile owned by InInstigator. The spec handle is applied to whatever hostile pawn it hits.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Projectile", meta = (DefaultToSelf = "InInstigator"))
+	bool FireProjectile(APawn* InInstigator, const FVector& InLocation, const FVector& InDirection, const FWarriorProjectileParams& InParams, const FGameplayEffectSpecHandle& InDamageSpecHandle);
+
+	/**
+	 * Drop in replacement for spawning InProjectileClass with Spawn Actor. Speed, gravity, life span, collision size,
+	 * damage policy and visuals are read from the class defaults and the projectile is fired through FireProjectile.
+	 * Classes with bSpawnAsActor are spawned as actors instead, which is the only case that returns an actor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Warrior|Projectile", meta = (DefaultToSelf = "InInstigator"))
+	AWarriorProjectileBase* SpawnProjectileFromClass(APawn* InInstigator, TSubclassOf<AWarriorProjectileBase> InProjectileClass, const FTransform& InSpawnTransform, const FGameplayEffectSpecHandle& InDamageSpecHandle);
+
+	UFUNCTION(BlueprintPure, Category = "Warrior|Projectile")
+	int32 GetNumLiveProjectiles() const { return Projectiles.Num(); }
+
+private:
+	struct FWarriorSimProjectile
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+
+		// Segment swept by PendingTrace, kept so a lost async result can be traced again synchronously
+		FVector TraceStart = FVector::ZeroVector;
+		FVector TraceEnd = FVector::ZeroVector;
+		FTraceHandle PendingTrace;
+
+		// False until the first tick after firing, which queues the first sweep
+		bool bHasMoved = false;
+
+		float RemainingLifeSpan = 0.f;
+		float GravityScale = 0.f;
+		float CollisionRadius = 0.f;
+		EProjectileDamagePolicy DamagePolicy = EProjectileDamagePolicy::OnHit;
+
+		FGameplayEffectSpecHandle DamageSpecHandle;
+		TWeakObjectPtr<APawn> Instigator;
+		TWeakObjectPtr<UNiagaraSystem> HitFxSystem;
+		int32 VisualGroupIndex = INDEX_NONE;
+
+		// Pawns already damaged by an OnBeginOverlap projectile
+		TArray<TWeakObjectPtr<AActor>, TInlineAllocator<4>> OverlappedActors;
+	};
+
+	// Resolves the hits of the last swept segment in time order. Returns false once the projectile is spent.
+	bool ResolveHits(FWarriorSimProjectile& InOutProjectile, const TArray<FHitResult>& InHits);
+
+	// Same block, damage and hit react handling as AWarriorProjectileBase::OnProjectileHit
+	void HandleProjectilePawnHit(const FWarriorSimProjectile& InProjectile, APawn* InHitPawn);
+
+	void HandleApplyProjectileDamage(const FWarriorSimProjectile& InProjectile, APawn* InHitPawn, const FGameplayEventData& InPayload);
+
+	void SpawnHitFx(const FWarriorSimProjectile& InProjectile, const FVector& InLocation);
+
+	void QueueSweep(FWarriorSimProjectile& InOutProjectile, const FVector& InEnd);
+
+	int32 FindOrAddVisualGroup(UNiagaraSystem* InSystem);
+
+	void UpdateVisuals();
+
+	TArray<FWarriorSimProjectile> Projectiles;
+
+	UPROPERTY()
+	TArray<FWarriorProjectileVisualGroup> VisualGroups;
+
+	// Set when the last projectile of a group dies, so the empty arrays reach Niagara before ticking stops
+	bool bVisualsDirty = false;
+
+	// Scratch buffer reused for async results and synchronous fallback traces
+	TArray<FHitResult> HitScratch;
+};
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GenericTeamAgentInterface.h"
+#include "WarriorTargetingSubsystem.generated.h"
+
+struct FWarriorTargetCandidate
+{
+	AActor* Actor = nullptr;
+
+	float Distance = 0.f;
+
+	// Signed yaw from the view direction in degrees, negative on the left of the screen
+	float ViewYaw = 0.f;
+
+	float Score = 0.f;
+};
+
+/**
+ * Grid index of the pawns that can be targeted, so target lock does not have to trace for them. Pawns register
+ * themselves; the grid is rebuilt from them at most once per IndexMaxAge, on the first query that finds it stale.
+ * Pooled and dead pawns are left out while building, and each entry keeps its team so the query can skip friends
+ * without a controller cast.
+ */
+UCLASS(Config = Game)
+class DUNGEON_API UWarriorTargetingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorTargetingSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	void RegisterTarget(APawn* InPawn);
+	void UnregisterTarget(APawn* InPawn);
+
+	/**
+	 * Fills OutCandidates with the hostile pawns within InMaxDistance of InQuerier and InMaxViewAngle degrees of the
+	 * view direction, sorted by ViewYaw from left to right. Score rises with the angle off the view direction and with
+	 * distance, so the lowest score is the best first target.
+	 */
+	void FindTargetCandidates(
+		const APawn* InQuerier,
+		const FVector& InViewLocation,
+		const FRotator& InViewRotation,
+		float InMaxDistance,
+		float InMaxViewAngle,
+		TArray<FWarriorTargetCandidate>& OutCandidates
+	);
+
+private:
+	struct FIndexedTarget
+	{
+		TWeakObjectPtr<APawn> Pawn;
+		FGenericTeamId TeamId;
+	};
+
+	void RebuildIndexIfStale();
+
+	FIntPoint GetCell(const FVector& InLocation) const;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Targeting", meta = (ClampMin = "100.0"))
+	float CellSize = 1000.f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Targeting", meta = (ClampMin = "0.0"))
+	float IndexMaxAge = 0.1f;
+
+	// Weight of the angle off the view direction against distance when picking the first target
+	UPROPERTY(Config, EditAnywhere, Category = "Targeting", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float AngleScoreWeight = 0.6f;
+
+	TSet<TWeakObjectPtr<APawn>> RegisteredTargets;
+
+	TArray<FIndexedTarget> IndexedTargets;
+
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<8>>> TargetsByCell;
+
+	double LastRebuildTime = -UE_BIG_NUMBER;
+
+	bool bIndexDirty = true;
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SlateWrapperTypes.h"
+#include "WarriorWorldMarkerSubsystem.generated.h"
+
+class UUserWidget;
+class USceneComponent;
+
+/**
+ * Keeps screen widgets pinned over world locations, such as the target lock reticle or interaction prompts.
+ * Once per frame it takes the first local player's view projection matrix and projects every marker with it,
+ * instead of each widget running its own ProjectWorldLocationToWidgetPosition.
+ *
+ * A marker widget is parked in the top left corner of the viewport, centred on its pivot, and from then on only its
+ * render translation moves. Render transforms skip layout, so the per frame cost stays flat with many markers.
+ */
+UCLASS()
+class DUNGEON_API UWarriorWorldMarkerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWarriorWorldMarkerSubsystem* Get(const UObject* WorldContextObject);
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override;
+	//~ End USubsystem Interface
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject Interface
+
+	/**
+	 * Pins InWidget, which must already be in the viewport, over InAnchor plus InWorldOffset. InPivot is the point of
+	 * the widget, in 0-1 units of its size, that lands on the projected location. Adding a widget twice updates it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Warrior|WorldMarker")
+	void AddMarker(UUserWidget* InWidget, USceneComponent* InAnchor, FVector InWorldOffset, FVector2D InPivot = FVector2D(0.5f, 0.5f));
+
+	// Moves an existing marker to a new anchor without touching its widget slot
+	UFUNCTION(BlueprintCallable, Category = "Warrior|WorldMarker")
+	void SetMarkerAnchor(UUserWidget* InWidget, USceneComponent* InAnchor);
+
+	UFUNCTION(BlueprintCallable, Category = "Warrior|WorldMarker")
+	void RemoveMarker(UUserWidget* InWidget);
+
+	/**
+	 * Projects InWorldLocation with the matrix cached for this frame. OutWidgetPosition is in viewport widget units.
+	 * Returns false when the location is behind the camera or no view has been cached yet.
+	 */
+	bool ProjectToWidget(const FVector& InWorldLocation, FVector2D& OutWidgetPosition) const;
+
+	// Viewport size in widget units for the cached view
+	FVector2D GetViewportWidgetSize() const { return ViewportWidgetSize; }
+
+	FVector GetCachedViewOrigin() const { return CachedViewOrigin; }
+
+	// Refreshes the cached view unless it was already refreshed this frame, so other batched UI can share it
+	void UpdateCachedView();
+
+private:
+	struct FWorldMarker
+	{
+		TWeakObjectPtr<UUserWidget> Widget;
+		TWeakObjectPtr<USceneComponent> Anchor;
+		FVector WorldOffset = FVector::ZeroVector;
+		FVector2D LastTranslation = FVector2D(-1.f, -1.f);
+
+		// Visibility the widget had when it was added, restored whenever the marker comes back on screen
+		ESlateVisibility ShownVisibility = ESlateVisibility::HitTestInvisible;
+		bool bIsShown = true;
+	};
+
+	void SetMarkerShown(FWorldMarker& InOutMarker, bool bInShown);
+
+	TArray<FWorldMarker> Markers;
+
+	FMatrix CachedViewProjectionMatrix = FMatrix::Identity;
+	FIntRect CachedViewRect;
+	FVector CachedViewOrigin = FVector::ZeroVector;
+	uint64 CachedViewFrame = 0;
+	float CachedViewportScale = 1.f;
+	FVector2D ViewportWidgetSize = FVector2D::ZeroVector;
+	bool bHasCachedView = false;
+};
@@ -7,6 +7,7 @@
 #include "WarriorTypes/WarriorEnumTypes.h"
 #include "WarriorFunctionLibrary.generated.h"
 
+class UAbilitySystemComponent;
 class UWarriorAbilitySystemComponent;
 class UPawnCombatComponent;
 struct FScalableFloat;
@@ -30,6 +31,9 @@ public:
 
 	static bool NativeDoesActorHaveTag(AActor* InActor, FGameplayTag TagToCheck);
 
+	// Bit test against the status flags mirrored on the actor's ASC. Use for hot per-frame checks.
+	static bool NativeDoesActorHaveStatus(AActor* InActor, EWarriorStatusFlags InStatusFlags);
+
 	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary", meta = (DisplayName = "Does Actor Has Tag", ExpandEnumAsExecs = "OutConfirmType"))
 	static void BP_DoesActorHaveTag(AActor* InActor, FGameplayTag TagToCheck, EWarriorConfirmType& OutConfirmType);
 
@@ -50,9 +54,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Warrior|FunctionLibrary")
 	static bool IsValidBlock(AActor* InAttacker, AActor* InDefender);
 
+	// Same test as IsValidBlock for attacks that have a travel direction but no actor, such as pooled projectiles
+	static bool NativeIsValidBlockFromDirection(const FVector& InAttackDirection, AActor* InDefender);
+
 	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary")
 	static bool ApplyGameplayEffectSpecHandleToTargetActor(AActor* InInstigator, AActor* InTargetActor, const FGameplayEffectSpecHandle& InSpecHandle);
 
+	// Applies one spec to every target, resolving the instigator's ASC once. Returns the number of targets it was applied to.
+	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary")
+	static int32 ApplyGameplayEffectSpecHandleToTargetActors(AActor* InInstigator, const TArray<AActor*>& InTargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors);
+
+	// Same as ApplyGameplayEffectSpecHandleToTargetActors for callers that already have the source ASC
+	static int32 NativeApplyGameplayEffectSpecHandleToTargetActors(UAbilitySystemComponent* InSourceASC, const TArray<AActor*>& InTargetActors, const FGameplayEffectSpecHandle& InSpecHandle, TArray<AActor*>& OutAffectedActors);
+
 	UFUNCTION(BlueprintCallable, Category = "Warrior|FunctionLibrary", meta = (Latent, WorldContext = "WorldContextObject", LatentInfo = "LatentInfo", ExpandEnumAsExecs = "CountDownInput|CountDownOutput", TotalTime = "1.0", UpdateInterval = "0.1"))
 	static void CountDown(const UObject* WorldContextObject, float TotalTime, float UpdateInterval, 
 		float& OutRemainingTime, EWarriorCountDownActionInput CountDownInput, 
@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/** Stat group for all game-side systems. Use "stat Warrior" in the console to view. */
+DECLARE_STATS_GROUP(TEXT("Warrior"), STATGROUP_Warrior, STATCAT_Advanced);
@@ -41,4 +41,41 @@ enum class EWarriorInputMode : uint8
 {
 	GameOnly,
 	UIOnly
-};
\ No newline at end of file
+};
+
+UENUM(BlueprintType)
+enum class EWarriorItemPlacementLayout : uint8
+{
+	Row,
+	Grid,
+	Circle
+};
+
+// Status tags mirrored as bits on UWarriorAbilitySystemComponent so hot combat checks are a bit test instead of a tag lookup
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EWarriorStatusFlags : uint16
+{
+	None		= 0,
+	Dead		= 1 << 0,
+	Blocking	= 1 << 1,
+	Rolling		= 1 << 2,
+	Unblockable	= 1 << 3,
+	RageFull	= 1 << 4,
+	RageNone	= 1 << 5,
+	RageActive	= 1 << 6,
+	Invincible	= 1 << 7,
+	TargetLock	= 1 << 8,
+	UnderAttack	= 1 << 9,
+	Strafing	= 1 << 10
+};
+ENUM_CLASS_FLAGS(EWarriorStatusFlags);
+
+// Update rate bucket UWarriorAISignificanceSubsystem assigns to each enemy, from full rate to barely updated
+UENUM(BlueprintType)
+enum class EWarriorAISignificance : uint8
+{
+	High,
+	Medium,
+	Low,
+	Dormant
+};
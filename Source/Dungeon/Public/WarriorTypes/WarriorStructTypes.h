@@ -4,6 +4,7 @@
 
 #include "GameplayTagContainer.h"
 #include "ScalableFloat.h"
+#include "Engine/EngineTypes.h"
 #include "WarriorStructTypes.generated.h"
 
 class UWarriorHeroLinkedAnimLayer;
@@ -59,4 +60,70 @@ struct FWarriorHeroWeaponData
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TSoftObjectPtr<UTexture2D> SoftWeaponIconTexture;
-};
\ No newline at end of file
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorMeleeTraceSettings
+{
+	GENERATED_BODY()
+
+	// Register hits with swept sphere traces while the damage window is open instead of collision box overlaps
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bUseSweptTrace = false;
+
+	// Sockets on the weapon mesh marking the ends of the damaging edge. Falls back to the collision box when missing.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace"))
+	FName TraceStartSocket = TEXT("TraceStart");
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace"))
+	FName TraceEndSocket = TEXT("TraceEnd");
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace", ClampMin = "0.0"))
+	float TraceRadius = 8.f;
+
+	// Points swept along the damaging edge
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace", ClampMin = "2"))
+	int32 NumSamplePoints = 3;
+
+	// Time between interpolated poses. Frames longer than this are split into substeps.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace", ClampMin = "0.001", Units = "s"))
+	float SubstepInterval = 1.f / 120.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace", ClampMin = "1"))
+	int32 MaxSubsteps = 8;
+
+	// Object type the sweeps look for
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (EditCondition = "bUseSweptTrace"))
+	TEnumAsByte<ECollisionChannel> TraceObjectType = ECC_Pawn;
+
+	// Segment along the longest axis of a box, in the box's local space
+	static void GetBoxTraceSegment(const FVector& InBoxExtent, FVector& OutLocalStart, FVector& OutLocalEnd);
+};
+
+USTRUCT(BlueprintType)
+struct FWarriorSwingHitRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	TWeakObjectPtr<AActor> HitActor;
+
+	// World time in seconds when the hit was registered
+	UPROPERTY(BlueprintReadOnly)
+	double HitTime = 0.0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FName BoneName;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector ImpactNormal = FVector::ZeroVector;
+
+	// Horizontal direction from the attacker to the target, for hit react direction
+	UPROPERTY(BlueprintReadOnly)
+	FVector HitDirection = FVector::ZeroVector;
+
+	FHitResult ToHitResult() const;
+};
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Styling/SlateBrush.h"
+#include "WarriorHealthBarLayerWidget.generated.h"
+
+class UWarriorHealthBarSubsystem;
+
+/**
+ * Full screen layer that paints the bars collected by UWarriorHealthBarSubsystem, two boxes per bar.
+ * It has no child widgets, so there is no layout or per bar widget to tick.
+ */
+UCLASS()
+class DUNGEON_API UWarriorHealthBarLayerWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	void SetHealthBarSource(UWarriorHealthBarSubsystem* InSource) { HealthBarSource = InSource; }
+
+protected:
+	//~ Begin UUserWidget Interface
+	virtual void NativeOnInitialized() override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	//~ End UUserWidget Interface
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FVector2D BarSize = FVector2D(80.f, 8.f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FSlateBrush BackgroundBrush;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FSlateBrush FillBrush;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FLinearColor BackgroundColor = FLinearColor(0.f, 0.f, 0.f, 0.6f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Health Bar")
+	FLinearColor FillColor = FLinearColor(0.8f, 0.05f, 0.05f, 1.f);
+
+private:
+	TWeakObjectPtr<UWarriorHealthBarSubsystem> HealthBarSource;
+};